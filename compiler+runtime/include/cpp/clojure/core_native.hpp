@@ -33,6 +33,7 @@ namespace clojure::core_native
   object_ref alias(object_ref current_ns, object_ref remote_ns, object_ref alias);
   object_ref refer(object_ref current_ns, object_ref sym, object_ref var);
   object_ref load_module(object_ref path);
+  object_ref record_module_dependency(object_ref path);
   object_ref compile(object_ref path);
 
   object_ref not_(object_ref o);
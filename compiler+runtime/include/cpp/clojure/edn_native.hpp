@@ -0,0 +1,12 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+
+namespace clojure::edn_native
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  object_ref read_string(object_ref opts, object_ref s);
+  object_ref read_file(object_ref opts, object_ref path);
+}
@@ -134,6 +134,24 @@ extern "C"
                               jank_object_ref a10,
                               jank_object_ref rest);
 
+  /* Calls through an inline cache, which generated code only uses on a cache miss. */
+  void *jank_call_site_create();
+  jank_object_ref jank_call0_cached(void *site, jank_object_ref f);
+  jank_object_ref jank_call1_cached(void *site, jank_object_ref f, jank_object_ref a1);
+  jank_object_ref
+  jank_call2_cached(void *site, jank_object_ref f, jank_object_ref a1, jank_object_ref a2);
+  jank_object_ref jank_call3_cached(void *site,
+                                    jank_object_ref f,
+                                    jank_object_ref a1,
+                                    jank_object_ref a2,
+                                    jank_object_ref a3);
+  jank_object_ref jank_call4_cached(void *site,
+                                    jank_object_ref f,
+                                    jank_object_ref a1,
+                                    jank_object_ref a2,
+                                    jank_object_ref a3,
+                                    jank_object_ref a4);
+
   jank_object_ref jank_const_nil();
   jank_object_ref jank_const_true();
   jank_object_ref jank_const_false();
@@ -154,6 +172,14 @@ extern "C"
   jank_object_ref jank_map_create(jank_u64 pairs, ...);
   jank_object_ref jank_set_create(jank_u64 size, ...);
 
+  /* Constant collections, built from an array of already created items. Unlike the variadic
+   * fns above, these keep the exact collection type the compiler saw. */
+  jank_object_ref jank_const_list_create(jank_u64 size, jank_object_ref const *items);
+  jank_object_ref jank_const_vector_create(jank_u64 size, jank_object_ref const *items);
+  jank_object_ref jank_const_array_map_create(jank_u64 pairs, jank_object_ref const *items);
+  jank_object_ref jank_const_hash_map_create(jank_u64 pairs, jank_object_ref const *items);
+  jank_object_ref jank_const_set_create(jank_u64 size, jank_object_ref const *items);
+
   jank_object_ref jank_box(void const *o);
   void *jank_unbox(jank_object_ref o);
 
@@ -314,6 +340,32 @@ extern "C"
   jank_i64 jank_to_integer(jank_object_ref o);
   jank_i64 jank_shift_mask_case_integer(jank_object_ref o, jank_i64 shift, jank_i64 mask);
 
+  /* Intrinsics, which codegen calls in place of the equivalent clojure.core fns. */
+  jank_object_ref jank_add(jank_object_ref l, jank_object_ref r);
+  jank_object_ref jank_sub(jank_object_ref l, jank_object_ref r);
+  jank_object_ref jank_mul(jank_object_ref l, jank_object_ref r);
+  jank_object_ref jank_div(jank_object_ref l, jank_object_ref r);
+  jank_object_ref jank_inc(jank_object_ref o);
+  jank_object_ref jank_dec(jank_object_ref o);
+  jank_bool jank_lt(jank_object_ref l, jank_object_ref r);
+  jank_bool jank_lte(jank_object_ref l, jank_object_ref r);
+  jank_bool jank_is_equiv(jank_object_ref l, jank_object_ref r);
+  jank_bool jank_is_zero(jank_object_ref o);
+  jank_bool jank_is_pos(jank_object_ref o);
+  jank_bool jank_is_neg(jank_object_ref o);
+  jank_object_ref jank_get(jank_object_ref m, jank_object_ref key);
+  jank_object_ref jank_get_or(jank_object_ref m, jank_object_ref key, jank_object_ref fallback);
+  jank_object_ref jank_nth(jank_object_ref o, jank_object_ref index);
+  jank_object_ref jank_nth_or(jank_object_ref o, jank_object_ref index, jank_object_ref fallback);
+  jank_i64 jank_count(jank_object_ref o);
+  jank_object_ref jank_first(jank_object_ref o);
+  jank_object_ref jank_next(jank_object_ref o);
+  jank_object_ref jank_rest(jank_object_ref o);
+  jank_object_ref jank_conj(jank_object_ref coll, jank_object_ref o);
+  jank_object_ref jank_assoc(jank_object_ref m, jank_object_ref key, jank_object_ref val);
+  jank_i64 jank_long_cast(jank_object_ref o);
+  jank_f64 jank_double_cast(jank_object_ref o);
+
   void jank_set_meta(jank_object_ref o, jank_object_ref meta);
 
   void jank_throw(jank_object_ref o);
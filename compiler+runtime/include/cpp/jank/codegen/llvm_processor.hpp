@@ -9,6 +9,11 @@ namespace Cpp
   class AotCall;
 }
 
+namespace llvm
+{
+  class Module;
+}
+
 namespace llvm::orc
 {
   class ThreadSafeModule;
@@ -84,6 +89,20 @@ namespace jank::codegen
 
   struct reusable_context;
 
+  /* While one of these is alive, every llvm_processor created on this thread shares a
+   * single LLVM context and optimization pipeline, rather than building new ones for each
+   * top-level form. This is meant for loading whole modules, where those fixed costs
+   * would otherwise be paid for every form in the file. */
+  struct module_batch_scope
+  {
+    module_batch_scope();
+    module_batch_scope(module_batch_scope const &) = delete;
+    module_batch_scope(module_batch_scope &&) noexcept = delete;
+    ~module_batch_scope();
+
+    bool owner{};
+  };
+
   struct llvm_processor
   {
     struct impl;
@@ -108,4 +127,8 @@ namespace jank::codegen
 
     jtl::ptr<impl> _impl{};
   };
+
+  /* Runs the optimization pipeline for the given level (0 through 3) over a module
+   * which isn't owned by an llvm_processor, such as when recompiling hot code. */
+  void optimize_module(llvm::Module &module, u8 level);
 }
@@ -62,6 +62,7 @@ namespace jank::error
     parse_invalid_reader_deref,
     parse_invalid_ratio,
     parse_invalid_keyword,
+    parse_unsupported_edn_form,
     internal_parse_failure,
 
     analyze_invalid_case,
@@ -212,6 +213,8 @@ namespace jank::error
         return "parse/invalid-ratio";
       case kind::parse_invalid_keyword:
         return "parse/invalid-keyword";
+      case kind::parse_unsupported_edn_form:
+        return "parse/unsupported-edn-form";
       case kind::internal_parse_failure:
         return "internal/parse-failure";
 
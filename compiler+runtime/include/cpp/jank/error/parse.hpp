@@ -51,6 +51,8 @@ namespace jank::error
   error_ref parse_invalid_ratio(read::source const &source, jtl::immutable_string const &note);
   error_ref parse_invalid_keyword(jtl::immutable_string const &message, read::source const &source);
   error_ref
+  parse_unsupported_edn_form(read::source const &source, jtl::immutable_string const &note);
+  error_ref
   internal_parse_failure(jtl::immutable_string const &message, read::source const &source);
   error_ref internal_parse_failure(jtl::immutable_string const &message);
 }
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
 #include <memory>
 
+#include <jtl/primitive.hpp>
 #include <jtl/result.hpp>
 #include <jtl/string_builder.hpp>
 
@@ -24,6 +26,12 @@ namespace Cpp
 
 namespace jank::jit
 {
+  /* How many calls a function gets before it's recompiled at the full optimization level,
+   * when tiered compilation is enabled. */
+  constexpr u32 tier_up_threshold{ 1000 };
+
+  struct tiered_compiler;
+
   struct processor
   {
     processor(jtl::immutable_string const &binary_version);
@@ -43,6 +51,15 @@ namespace jank::jit
     load_dynamic_libs(native_vector<jtl::immutable_string> const &libs) const;
     jtl::option<jtl::immutable_string> find_dynamic_lib(jtl::immutable_string const &lib) const;
 
+    /* Tiered compilation. This loads a module compiled at -O0, but keeps a copy of it so
+     * that, once any of its functions is hot, that function alone can be optimized and
+     * loaded again on a background thread. */
+    void load_tiered_ir_module(llvm::orc::ThreadSafeModule &&m) const;
+    /* Returns the optimized replacement for the given function, if it's ready. If it's not
+     * ready yet, its recompilation is queued up. Functions which were never registered
+     * are returned as is. */
+    jtl::option<void *> tier_up(void *fn) const;
+
     std::unique_ptr<Cpp::Interpreter> interpreter;
     native_vector<std::filesystem::path> library_dirs;
 
@@ -50,5 +67,52 @@ namespace jank::jit
      * the `clang::Interpreter`. This allows us to embed the PCH into AOT compiled programs
      * while still being able to include it. */
     std::map<char const *, std::string_view> vfs;
+
+    /* This goes last so its background thread is stopped before anything else is torn down. */
+    std::unique_ptr<tiered_compiler> tiering;
   };
+
+  /* Called on every call of a JIT compiled function. The countdown starts at
+   * tier_up_threshold when tiered compilation is enabled and at 0 otherwise, so the
+   * common case is a single branch. Lost updates between threads are fine, since this
+   * is only a heuristic. Returns true when the caller should try to tier up. */
+  inline bool count_call(u32 &countdown)
+  {
+    std::atomic_ref<u32> const ref{ countdown };
+    auto const remaining{ ref.load(std::memory_order_relaxed) };
+    if(remaining == 0) [[likely]]
+    {
+      return false;
+    }
+    ref.store(remaining - 1, std::memory_order_relaxed);
+    return remaining == 1;
+  }
+
+  /* Arity pointers may be swapped out by another thread, once tiered up. */
+  template <typename F>
+  F load_arity(F &arity)
+  {
+    return std::atomic_ref<F>{ arity }.load(std::memory_order_acquire);
+  }
+
+  /* Swaps the given arity to its optimized replacement, if there is one. Returns false
+   * if the replacement isn't ready yet. */
+  template <typename F>
+  bool tier_up_arity(processor const &prc, F &arity)
+  {
+    auto const current{ load_arity(arity) };
+    if(!current)
+    {
+      return true;
+    }
+
+    auto const optimized{ prc.tier_up(reinterpret_cast<void *>(current)) };
+    if(optimized.is_none())
+    {
+      return false;
+    }
+    std::atomic_ref<F>{ arity }.store(reinterpret_cast<F>(optimized.unwrap()),
+                                      std::memory_order_release);
+    return true;
+  }
 }
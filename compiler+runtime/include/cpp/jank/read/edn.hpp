@@ -0,0 +1,61 @@
+#pragma once
+
+#include <jtl/option.hpp>
+#include <jtl/result.hpp>
+
+#include <jank/read/lex.hpp>
+#include <jank/runtime/object.hpp>
+
+/* The EDN reader only reads data. Unlike the code reader in parse.hpp, it doesn't attach
+ * source meta, resolve symbols against the current ns, or support syntax quoting, reader
+ * conditionals, anonymous fns, etc. Forms are pulled from the lexer one at a time and
+ * collections are built directly into transients, so it can stream through large inputs
+ * without holding onto anything more than the forms it has returned. */
+namespace jank::read::edn
+{
+  struct options
+  {
+    /* A map of tag symbols to reader fns, consulted before the built-in #inst and #uuid. */
+    runtime::object_ref readers{};
+    /* Called with the tag and value when no reader is found for a tag. */
+    runtime::object_ref default_reader{};
+    /* Keywords are always interned. When this is set, equal strings will also share the
+     * same box, which can save a lot of memory for inputs with repetitive values. */
+    bool dedupe_strings{};
+  };
+
+  struct processor
+  {
+    using object_result = jtl::result<jtl::option<runtime::object_ref>, error_ref>;
+
+    processor(jtl::immutable_string_view const &data);
+    processor(jtl::immutable_string_view const &data, options const &opts);
+
+    /* Reads the next top-level form. None is returned at the end of the input. */
+    object_result next();
+
+  private:
+    object_result next(jtl::option<lex::token_kind> const closer);
+    object_result read_form();
+    object_result read_list();
+    object_result read_vector();
+    /* When ns is set, this is the body of a #:ns{} map, so unqualified keys are put into ns. */
+    object_result read_map(jtl::option<jtl::immutable_string> const &ns);
+    object_result read_set();
+    object_result read_dispatch();
+    object_result read_namespaced_map(lex::token const &start_token);
+    object_result read_tagged(lex::token const &start_token);
+    object_result read_symbolic_value(lex::token const &start_token);
+    object_result read_character();
+    object_result read_symbol();
+    object_result read_keyword();
+    object_result read_ratio();
+    runtime::object_ref make_string(jtl::immutable_string &&s);
+
+    lex::processor lexer;
+    options opts;
+    /* The most recently lexed token, which the read_* fns start from. */
+    lex::token latest_token;
+    native_unordered_map<jtl::immutable_string, runtime::object_ref> strings;
+  };
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace jank::runtime::behavior
+{
+  /* For values which may be produced later, such as delays, futures, promises, and lazy
+   * sequences. This is what `realized?` uses. */
+  template <typename T>
+  concept pending = requires(T * const t) {
+    { t->is_realized() } -> std::convertible_to<bool>;
+  };
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace jank::runtime::behavior
+{
+  /* Reducible collections reduce directly over their own storage, rather than going
+   * through a seq. This is expected to stop as soon as f returns a reduced value, which
+   * is unwrapped before being returned. */
+  template <typename T>
+  concept reducible = requires(T const * const t) {
+    { t->reduce(object_ref{}, object_ref{}) } -> std::convertible_to<object_ref>;
+  };
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime
+{
+  /* A monomorphic inline cache for a single call site within generated code. When a call
+   * misses, we record the callee along with the raw arity fn which dynamic_call would
+   * end up in. While the callee stays the same, the generated code can then jump straight
+   * into that arity.
+   *
+   * Generated code reads the cache without any locking, so entries are never modified.
+   * A new entry is swapped in instead. */
+  struct call_site
+  {
+    /* Generated code relies on the layout of this. */
+    struct entry : gc
+    {
+      object *callee{};
+      void *fn{};
+    };
+
+    /* Only calls with up to this many args are cached. */
+    static constexpr usize max_arity{ 4 };
+    /* Once a site has missed this many times, it's megamorphic and we stop caching. */
+    static constexpr u32 max_misses{ 16 };
+
+    call_site();
+
+    /* Call sites are referenced only from generated code, which the GC doesn't scan, so
+     * they're never collected. They are scanned, though, so a cached callee can't be
+     * collected and then have its address reused by something else. */
+    static call_site *create();
+
+    /* Called on a miss, before the call goes through dynamic_call. Only JIT compiled fns
+     * are cached, once they're done tiering up, and only for arities which don't need
+     * any variadic packing. */
+    void update(object_ref callee, u8 arity);
+
+    std::atomic<entry const *> cached;
+    std::atomic<u32> misses{};
+  };
+}
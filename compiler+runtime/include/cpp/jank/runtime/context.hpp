@@ -1,6 +1,6 @@
 #pragma once
 
-#include <list>
+#include <atomic>
 
 #include <folly/Synchronized.h>
 
@@ -9,6 +9,7 @@
 #include <jank/runtime/module/loader.hpp>
 #include <jank/runtime/ns.hpp>
 #include <jank/runtime/var.hpp>
+#include <jank/runtime/detail/intern_table.hpp>
 #include <jank/jit/processor.hpp>
 #include <jank/util/cli.hpp>
 
@@ -22,6 +23,7 @@ namespace jank
   namespace codegen
   {
     struct reusable_context;
+    struct llvm_processor;
   }
 }
 
@@ -96,6 +98,10 @@ namespace jank::runtime
      */
     jtl::result<void, jtl::immutable_string>
     load_module(jtl::immutable_string_view const &module, module::origin ori);
+    /* Records that the module currently being loaded depends on the given module, which is
+     * named the same way as for load_module. This is also done for modules which were
+     * already loaded, so each module's cache manifest covers everything it requires. */
+    void record_module_dependency(jtl::immutable_string_view const &module);
 
     /* Does all the same work as load_module, but also writes compiled files to the file system. */
     jtl::result<void, jtl::immutable_string>
@@ -105,6 +111,19 @@ namespace jank::runtime
 
     jtl::string_result<void> write_module(jtl::immutable_string const &module_name,
                                           jtl::ref<llvm::Module> const &module) const;
+    /* Takes a manifest which has already been rendered, since rendering it needs the
+     * module dependencies, which may only be read on the compiling thread. */
+    jtl::string_result<void> write_module(jtl::immutable_string const &module_name,
+                                          jtl::immutable_string const &manifest,
+                                          jtl::ref<llvm::Module> const &module) const;
+    /* Optimizing a module and emitting its object file don't touch the runtime, so, while
+     * compiling, they're done on the shared thread pool. That way, they overlap with
+     * analyzing and evaluating the modules which come next. The processor must have
+     * generated its module already. */
+    void write_module_async(codegen::llvm_processor &&cg_prc);
+    /* Blocks until every module passed to write_module_async has been written. Returns
+     * the first failure, if there were any. */
+    jtl::string_result<void> wait_for_module_writes();
 
     /* Generates a unique name for use with anything from codgen structs,
      * lifted vars, to shadowed locals. Prefixes with current namespace. */
@@ -115,8 +134,10 @@ namespace jank::runtime
     obj::symbol unique_symbol() const;
     obj::symbol unique_symbol(jtl::immutable_string_view const &prefix) const;
 
-    folly::Synchronized<native_unordered_map<obj::symbol_ref, ns_ref>> namespaces;
-    folly::Synchronized<native_unordered_map<jtl::immutable_string, obj::keyword_ref>> keywords;
+    /* These are looked up from every thread at runtime, but rarely change, so lookups don't
+     * take any locks. */
+    detail::intern_table<obj::symbol_ref, ns_ref> namespaces;
+    detail::intern_table<jtl::immutable_string, obj::keyword_ref> keywords;
 
     struct binding_scope
     {
@@ -130,7 +151,6 @@ namespace jank::runtime
     jtl::string_result<void> push_thread_bindings(obj::persistent_hash_map_ref const bindings);
     jtl::string_result<void> pop_thread_bindings();
     obj::persistent_hash_map_ref get_thread_bindings() const;
-    jtl::option<thread_binding_frame> current_thread_binding_frame();
 
     /* The analyze processor is reused across evaluations so we can keep the semantic information
      * of previous code. This is essential for REPL use.
@@ -145,6 +165,8 @@ namespace jank::runtime
     folly::Synchronized<native_deque<jtl::immutable_string>> loaded_modules_in_order;
     jtl::immutable_string binary_cache_dir;
     module::loader module_loader;
+    std::atomic<usize> pending_module_writes;
+    folly::Synchronized<native_vector<jtl::immutable_string>> module_write_errors;
 
     var_ref current_file_var;
     var_ref current_ns_var;
@@ -159,9 +181,7 @@ namespace jank::runtime
     /* Hold onto the CLI Options for use at runtime */
     util::cli::options opts;
 
-    /* TODO: Remove this map. Just use the list. */
-    static thread_local native_unordered_map<context const *, std::list<thread_binding_frame>>
-      thread_binding_frames;
+    static thread_local thread_binding_stack thread_bindings;
 
     /* This must go last, since it'll try to access other bits in the runtime context during
      * its initialization and we need them to be ready. */
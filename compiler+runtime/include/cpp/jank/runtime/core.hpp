@@ -1,6 +1,6 @@
 #pragma once
 
-#include <regex>
+#include <jank/util/regex.hpp>
 
 /* TODO: Remove these so that people include only what they need. */
 #include <jank/runtime/core/make_box.hpp>
@@ -57,6 +57,8 @@ namespace jank::runtime
 
   object_ref atom(object_ref o);
   object_ref deref(object_ref o);
+  object_ref blocking_deref(object_ref o, object_ref timeout_ms, object_ref timeout_val);
+  bool is_realized(object_ref o);
   object_ref swap_atom(object_ref atom, object_ref fn);
   object_ref swap_atom(object_ref atom, object_ref fn, object_ref a1);
   object_ref swap_atom(object_ref atom, object_ref fn, object_ref a1, object_ref a2);
@@ -83,6 +85,35 @@ namespace jank::runtime
 
   object_ref force(object_ref o);
 
+  object_ref future_call(object_ref fn);
+  bool is_future(object_ref o);
+  bool is_future_done(object_ref o);
+  bool future_cancel(object_ref o);
+  bool is_future_cancelled(object_ref o);
+  object_ref promise();
+  object_ref deliver(object_ref promise, object_ref val);
+  i64 available_processors();
+
+  object_ref agent(object_ref state);
+  object_ref agent_send(object_ref agent, object_ref fn, object_ref args);
+  object_ref agent_send_off(object_ref agent, object_ref fn, object_ref args);
+  object_ref agent_send_via(object_ref executor,
+                            object_ref agent,
+                            object_ref fn,
+                            object_ref args,
+                            object_ref thunk);
+  object_ref agent_run_next(object_ref agent);
+  object_ref agent_error(object_ref agent);
+  object_ref restart_agent(object_ref agent, object_ref new_state, object_ref clear_actions);
+  object_ref set_agent_error_handler(object_ref agent, object_ref fn);
+  object_ref agent_error_handler(object_ref agent);
+  object_ref set_agent_error_mode(object_ref agent, object_ref mode);
+  object_ref agent_error_mode(object_ref agent);
+  object_ref set_agent_validator(object_ref agent, object_ref fn);
+  i64 agent_queue_count(object_ref agent);
+  i64 release_pending_sends();
+  object_ref shutdown_agents();
+
   object_ref tagged_literal(object_ref tag, object_ref form);
   bool is_tagged_literal(object_ref o);
 
@@ -98,7 +129,7 @@ namespace jank::runtime
   object_ref re_find(object_ref m);
   object_ref re_groups(object_ref m);
   object_ref re_matches(object_ref re, object_ref s);
-  object_ref smatch_to_vector(std::smatch const &match_results);
+  object_ref match_groups(jtl::immutable_string const &s, util::regex::match const &m);
 
   object_ref add_watch(object_ref reference, object_ref key, object_ref fn);
   object_ref remove_watch(object_ref reference, object_ref key);
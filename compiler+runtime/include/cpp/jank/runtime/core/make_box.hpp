@@ -26,15 +26,19 @@ namespace jank::runtime
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
-  inline auto make_box(int const i)
+  inline obj::integer_ref make_box(i64 const i)
   {
-    return make_box<obj::integer>(static_cast<i64>(i));
+    if(detail::integer_cache_min <= i && i <= detail::integer_cache_max)
+    {
+      return &detail::integer_cache[static_cast<usize>(i - detail::integer_cache_min)];
+    }
+    return make_box<obj::integer>(i);
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
-  inline auto make_box(i64 const i)
+  inline obj::integer_ref make_box(int const i)
   {
-    return make_box<obj::integer>(i);
+    return make_box(static_cast<i64>(i));
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
@@ -50,20 +54,39 @@ namespace jank::runtime
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
-  inline auto make_box(char const i)
+  inline obj::character_ref make_box(char const i)
   {
+    if(static_cast<unsigned char>(i) < detail::character_cache_size)
+    {
+      return detail::cached_character(i);
+    }
     return make_box<obj::character>(i);
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
-  inline auto make_box(usize const i)
+  inline obj::integer_ref make_box(usize const i)
   {
+    if(i <= static_cast<usize>(detail::integer_cache_max))
+    {
+      return &detail::integer_cache[static_cast<usize>(static_cast<i64>(i)
+                                                       - detail::integer_cache_min)];
+    }
     return make_box<obj::integer>(static_cast<i64>(i));
   }
 
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
   inline obj::real_ref make_box(f64 const r)
   {
+    /* We compare bits, rather than values, so that -0.0 doesn't end up as 0.0. */
+    auto const bits(std::bit_cast<u64>(r));
+    if(bits == std::bit_cast<u64>(0.0))
+    {
+      return &detail::real_zero;
+    }
+    else if(bits == std::bit_cast<u64>(1.0))
+    {
+      return &detail::real_one;
+    }
     return make_box<obj::real>(r);
   }
 
@@ -97,7 +120,7 @@ namespace jank::runtime
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
   inline auto make_box(T const d)
   {
-    return make_box<obj::real>(d);
+    return make_box(static_cast<f64>(d));
   }
 
   template <typename T>
@@ -105,7 +128,7 @@ namespace jank::runtime
   [[gnu::flatten, gnu::hot, gnu::visibility("default")]]
   inline auto make_box(T const d)
   {
-    return make_box<obj::integer>(d);
+    return make_box(static_cast<i64>(d));
   }
 
   template <typename T>
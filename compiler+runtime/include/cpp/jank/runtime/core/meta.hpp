@@ -13,6 +13,7 @@ namespace jank::runtime
   }
 
   object_ref meta(object_ref m);
+  object_ref materialized_meta(object_ref o);
   object_ref with_meta(object_ref o, object_ref m);
   object_ref with_meta_graceful(object_ref o, object_ref m);
   object_ref reset_meta(object_ref o, object_ref m);
@@ -147,6 +147,14 @@ namespace jank::runtime
   usize sequence_length(object_ref const s, usize const max);
 
   object_ref reduce(object_ref f, object_ref init, object_ref s);
+  /* Applies f to the accumulator and the element. Returns false once f returns a reduced
+   * value, which is unwrapped into the accumulator. */
+  bool reduce_step(object_ref &acc, object_ref f, object_ref e);
+  /* Reduces pieces of no more than n elements in parallel, on the shared thread pool, then
+   * combines the results. Each piece starts with (combinef). Vectors, integer ranges and
+   * maps can be split, while anything else is reduced serially. For maps, reducef is
+   * called with the key and value as separate args. */
+  object_ref fold(object_ref n, object_ref combinef, object_ref reducef, object_ref coll);
   object_ref reduced(object_ref o);
   bool is_reduced(object_ref o);
 
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include <jank/type.hpp>
+
+namespace jank::runtime::detail
+{
+  /* A hash table for read-mostly data, such as interned keywords and namespaces, which is
+   * looked up from many threads at runtime but rarely changes. Lookups are lock-free, while
+   * inserts and removals are serialized by a mutex.
+   *
+   * The table is open addressed, with linear probing. Each slot points to a node which is
+   * never changed once it's published, aside from its value. Removing a key clears the
+   * node's value, rather than the slot, so probe chains are never broken. When the table
+   * grows, a new slot array is built and swapped in, leaving readers of the old one with a
+   * consistent, but slightly stale, view. A stale miss is fine, since inserting goes back
+   * through the lock.
+   *
+   * Everything is GC allocated, so old slot arrays are collected once no readers can see
+   * them. Values are orefs and are nil when they're not found. */
+  template <typename K, typename V, typename Hash = std::hash<K>, typename Pred = std::equal_to<K>>
+  struct intern_table
+  {
+    using value_pointer = typename V::value_type *;
+
+    static constexpr usize initial_capacity{ 64 };
+
+    struct node : gc
+    {
+      node(K const &key, usize const hash, value_pointer const value)
+        : key{ key }
+        , hash{ hash }
+        , value{ value }
+      {
+      }
+
+      K const key;
+      usize const hash;
+      std::atomic<value_pointer> value;
+    };
+
+    struct table : gc
+    {
+      table(usize const capacity)
+        : mask{ capacity - 1 }
+        , slots{ new(GC) std::atomic<node *>[capacity]{} }
+      {
+      }
+
+      usize const mask;
+      std::atomic<node *> * const slots;
+    };
+
+    intern_table()
+      : current{ new table{ initial_capacity } }
+    {
+    }
+
+    V find(K const &key) const
+    {
+      auto const found{ find_node(*current.load(std::memory_order_acquire), key, Hash{}(key)) };
+      return found ? load_value(*found) : V{};
+    }
+
+    /* If the key isn't in the table, we call the make fn to create its value. That's done
+     * while holding the lock, so exactly one value is ever created for each key. */
+    template <typename F>
+    V find_or_insert(K const &key, F const &make)
+    {
+      auto const hash{ Hash{}(key) };
+      if(auto const found{ find_node(*current.load(std::memory_order_acquire), key, hash) })
+      {
+        if(auto const value{ load_value(*found) }; value.is_some())
+        {
+          return value;
+        }
+      }
+
+      std::lock_guard<std::mutex> const lock{ mutex };
+      auto const found{ find_node(*current.load(std::memory_order_relaxed), key, hash) };
+      if(found)
+      {
+        if(auto const value{ load_value(*found) }; value.is_some())
+        {
+          return value;
+        }
+      }
+
+      V const value{ make() };
+      auto const value_ptr{ static_cast<value_pointer>(value.data) };
+      if(found)
+      {
+        found->value.store(value_ptr, std::memory_order_release);
+      }
+      else
+      {
+        insert_node(new node{ key, hash, value_ptr });
+      }
+      return value;
+    }
+
+    /* Returns the removed value, or nil if the key wasn't in the table. */
+    V erase(K const &key)
+    {
+      std::lock_guard<std::mutex> const lock{ mutex };
+      auto const found{ find_node(*current.load(std::memory_order_relaxed), key, Hash{}(key)) };
+      if(!found)
+      {
+        return {};
+      }
+
+      auto const value{ found->value.exchange(nullptr, std::memory_order_acq_rel) };
+      return value ? V{ value } : V{};
+    }
+
+  private:
+    static V load_value(node const &n)
+    {
+      auto const value{ n.value.load(std::memory_order_acquire) };
+      return value ? V{ value } : V{};
+    }
+
+    static node *find_node(table const &t, K const &key, usize const hash)
+    {
+      /* The table is never more than half full, so we'll always hit an empty slot. */
+      for(auto i{ hash & t.mask };; i = (i + 1) & t.mask)
+      {
+        auto const n{ t.slots[i].load(std::memory_order_acquire) };
+        if(!n)
+        {
+          return nullptr;
+        }
+        if(n->hash == hash && Pred{}(n->key, key))
+        {
+          return n;
+        }
+      }
+    }
+
+    static void place(table const &t, node * const n)
+    {
+      for(auto i{ n->hash & t.mask };; i = (i + 1) & t.mask)
+      {
+        if(!t.slots[i].load(std::memory_order_relaxed))
+        {
+          t.slots[i].store(n, std::memory_order_release);
+          return;
+        }
+      }
+    }
+
+    /* Must be called while holding the lock. */
+    void insert_node(node * const n)
+    {
+      auto t{ current.load(std::memory_order_relaxed) };
+      if((used + 1) * 2 > t->mask + 1)
+      {
+        /* Removed nodes are dropped along the way, so we may not actually need to grow. */
+        usize live{};
+        for(usize i{}; i <= t->mask; ++i)
+        {
+          auto const existing{ t->slots[i].load(std::memory_order_relaxed) };
+          if(existing && existing->value.load(std::memory_order_relaxed))
+          {
+            ++live;
+          }
+        }
+
+        auto const capacity{ (live + 1) * 4 > t->mask + 1 ? (t->mask + 1) * 2 : t->mask + 1 };
+        auto const grown{ new table{ capacity } };
+        for(usize i{}; i <= t->mask; ++i)
+        {
+          auto const existing{ t->slots[i].load(std::memory_order_relaxed) };
+          if(existing && existing->value.load(std::memory_order_relaxed))
+          {
+            place(*grown, existing);
+          }
+        }
+
+        current.store(grown, std::memory_order_release);
+        t = grown;
+        used = live;
+      }
+
+      place(*t, n);
+      ++used;
+    }
+
+    std::atomic<table *> current;
+    /* The number of occupied slots in the current table, including removed nodes. */
+    usize used{};
+    std::mutex mutex;
+  };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::gc
+{
+  /* Enables the GC and starts tracking collection pauses. This needs to happen before the
+   * first GC allocation, which is before we parse the CLI, so the few settings which the GC
+   * only reads at start-up are picked out of the args directly. */
+  void init(int const argc, char const * const *argv);
+  /* Applies the remaining GC options from the CLI. */
+  void configure();
+
+  /* A map of heap and collection statistics. Pause times are in nanoseconds. */
+  object_ref stats();
+  object_ref collect();
+  /* Zero means no limit. */
+  object_ref set_heap_limit(object_ref bytes);
+}
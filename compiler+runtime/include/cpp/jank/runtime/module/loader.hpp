@@ -2,6 +2,8 @@
 
 #include <filesystem>
 
+#include <folly/Synchronized.h>
+
 #include <jank/runtime/object.hpp>
 #include <jtl/result.hpp>
 
@@ -17,8 +19,8 @@ namespace jank::runtime::module
     /* Regardless of which binaries are present, and how new they are,
      * this will always select the source. */
     source,
-    /* Will choose a binary or the source, depending on which is newer.
-     * If both exist and are equally new, the binary is preferred. */
+    /* Will choose a binary if its cache manifest shows it was built from the same
+     * source, dependencies, and compiler options we have now. Otherwise, the source. */
     latest,
   };
 
@@ -93,6 +95,7 @@ namespace jank::runtime::module
   jtl::immutable_string path_to_module(std::filesystem::path const &path);
   jtl::immutable_string module_to_path(jtl::immutable_string const &module);
   jtl::immutable_string module_to_load_function(jtl::immutable_string const &module);
+  jtl::immutable_string object_to_manifest_path(jtl::immutable_string const &o_path);
   jtl::immutable_string
   nest_module(jtl::immutable_string const &module, jtl::immutable_string const &sub);
   jtl::immutable_string
@@ -143,7 +146,16 @@ namespace jank::runtime::module
 
     static jtl::string_result<file_view> read_file(jtl::immutable_string const &path);
 
-    jtl::string_result<find_result> find(jtl::immutable_string const &module, origin const ori);
+    jtl::string_result<find_result>
+    find(jtl::immutable_string const &module, origin const ori) const;
+
+    /* Each cached object file has a manifest next to it, which holds a hash of the compiler
+     * options and then a hash of the source for the module and every module it transitively
+     * depends on. The object file is only reused if all of these still match. */
+    jtl::immutable_string cache_manifest(jtl::immutable_string const &module) const;
+    bool is_cache_valid(jtl::immutable_string const &module, file_entry const &o) const;
+    /* Hashes the source which we'd compile the module from, if there is one. */
+    jtl::option<jtl::immutable_string> source_hash(jtl::immutable_string const &module) const;
 
     bool is_loaded(jtl::immutable_string const &module);
     void set_is_loaded(jtl::immutable_string const &module);
@@ -166,5 +178,17 @@ namespace jank::runtime::module
     /* This maps module strings to entries. Module strings are like fully qualified Java
      * class names. For example, `clojure.core`, `jank.compiler`, etc. */
     native_unordered_map<jtl::immutable_string, entry> entries;
+
+    struct hashed_source
+    {
+      std::time_t modified_at{};
+      jtl::immutable_string hash;
+    };
+
+    /* Validating a module hashes all of its dependencies, so shared dependencies would
+     * otherwise be read and hashed over and over. The modification time is only used
+     * to know when to hash a file again, never to decide whether a binary is valid. */
+    mutable folly::Synchronized<native_unordered_map<jtl::immutable_string, hashed_source>>
+      source_hashes;
   };
 }
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+#include <folly/Synchronized.h>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::obj
+{
+  using agent_ref = oref<struct agent>;
+  using keyword_ref = oref<struct keyword>;
+  using persistent_hash_map_ref = oref<struct persistent_hash_map>;
+
+  /* Agents apply their actions one at a time, in the order they were sent, on a thread
+   * supplied by the action's executor. Sending never blocks, since actions are pushed onto
+   * a lock-free stack. Whoever takes the agent's single scheduling token moves the stack
+   * over into the ready queue, in send order, and hands the next action to its executor. */
+  struct agent : gc
+  {
+    static constexpr object_type obj_type{ object_type::agent };
+    static constexpr bool pointer_free{ false };
+
+    enum class executor_kind : u8
+    {
+      /* A bounded pool, sized to the hardware, for actions sent with `send`. */
+      pooled,
+      /* A pool which grows as needed, for actions sent with `send-off`. */
+      solo,
+      /* A jank fn which takes a thunk and runs it, for actions sent with `send-via`. */
+      custom
+    };
+
+    struct action : gc
+    {
+      object_ref fn;
+      object_ref args;
+      /* The thread bindings in place when the action was sent. */
+      persistent_hash_map_ref bindings;
+      executor_kind kind{};
+      object_ref executor;
+      /* For custom executors, the thunk which runs this agent's next action. */
+      object_ref thunk;
+      action *next{};
+    };
+
+    agent() = default;
+    agent(object_ref state);
+
+    /* behavior::object_like */
+    bool equal(object const &) const;
+    jtl::immutable_string to_string() const;
+    void to_string(jtl::string_builder &buff) const;
+    jtl::immutable_string to_code_string() const;
+    uhash to_hash() const;
+
+    /* behavior::metadatable */
+    /* Like vars, agents are references, so their meta is changed in place. */
+    agent_ref with_meta(object_ref m);
+
+    /* behavior::derefable */
+    object_ref deref() const;
+
+    /* behavior::ref_like */
+    void add_watch(object_ref key, object_ref fn);
+    void remove_watch(object_ref key);
+
+    /* Queues up the action. If we're within another agent's action, the send is held
+     * until that action completes. Throws if the agent is failed. */
+    void dispatch(action *a);
+    /* Runs the next ready action. This is what the executors call. */
+    void run_next();
+
+    object_ref get_error() const;
+    object_ref restart(object_ref new_state, bool clear_actions);
+    void set_error_handler(object_ref fn);
+    object_ref get_error_handler() const;
+    void set_error_mode(object_ref mode);
+    object_ref get_error_mode() const;
+    void set_validator(object_ref fn);
+    /* The number of actions which have been sent, but not yet completed. */
+    usize queue_count() const;
+
+    /* Sends which were held during the current action are dispatched right away. Returns
+     * how many there were. */
+    static usize release_pending_sends();
+    static void shutdown();
+    static bool is_in_action();
+
+    object base{ obj_type };
+    std::atomic<object *> state{};
+    std::atomic<action *> pending{};
+    /* Only ever touched by whoever holds the scheduling token. */
+    action *ready{};
+    std::atomic_bool scheduled{};
+    std::atomic<usize> queued{};
+
+    mutable std::mutex error_mutex;
+    object_ref error{};
+    object_ref error_handler{};
+    keyword_ref error_mode;
+    object_ref validator{};
+    folly::Synchronized<persistent_hash_map_ref> watches{};
+    jtl::option<object_ref> meta;
+
+  private:
+    void enqueue(action *a);
+    void schedule_next();
+    void notify_watches(object_ref old_state, object_ref new_state);
+  };
+}
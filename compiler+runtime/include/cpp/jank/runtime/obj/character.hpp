@@ -29,3 +29,11 @@ namespace jank::runtime::obj
     jtl::immutable_string data;
   };
 }
+
+namespace jank::runtime::detail
+{
+  /* Every ASCII character has a preallocated box, since they're immutable. */
+  static constexpr usize character_cache_size{ 128 };
+
+  obj::character_ref cached_character(char c);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include <jank/runtime/object.hpp>
 
 namespace jank::runtime::obj
@@ -24,8 +27,13 @@ namespace jank::runtime::obj
     /* behavior::derefable */
     object_ref deref();
 
+    /* behavior::pending */
+    bool is_realized();
+
     object base{ obj_type };
-    object_ref val{};
+    /* Null until the delay is realized, after which it never changes. Derefs only need
+     * the mutex until then. */
+    std::atomic<object *> val{};
     object_ref fn{};
     object_ref error{};
     std::mutex mutex;
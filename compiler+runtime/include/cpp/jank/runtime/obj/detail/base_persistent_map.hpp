@@ -48,6 +48,9 @@ namespace jank::runtime::obj::detail
     oref<ST> seq() const;
     oref<ST> fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref const f, object_ref const init) const;
+
     /* behavior::countable */
     usize count() const;
 
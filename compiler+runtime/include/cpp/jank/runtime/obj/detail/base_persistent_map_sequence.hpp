@@ -11,6 +11,7 @@ namespace jank::runtime
   namespace obj
   {
     using cons_ref = oref<struct cons>;
+    using array_chunk_ref = oref<struct array_chunk>;
   }
 }
 
@@ -21,6 +22,7 @@ namespace jank::runtime::obj::detail
   {
     static constexpr bool pointer_free{ false };
     static constexpr bool is_sequential{ true };
+    static constexpr usize chunk_size{ 32 };
 
     base_persistent_map_sequence() = default;
     base_persistent_map_sequence(base_persistent_map_sequence &&) = default;
@@ -49,6 +51,10 @@ namespace jank::runtime::obj::detail
     /* behavior::sequenceable_in_place */
     oref<PT> next_in_place();
 
+    /* behavior::chunkable */
+    obj::array_chunk_ref chunked_first() const;
+    oref<PT> chunked_next() const;
+
     /* behavior::conjable */
     obj::cons_ref conj(object_ref const head);
 
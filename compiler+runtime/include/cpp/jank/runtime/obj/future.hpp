@@ -0,0 +1,77 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::obj
+{
+  using future_ref = oref<struct future>;
+  using persistent_hash_map_ref = oref<struct persistent_hash_map>;
+
+  /* The result of running a fn on the shared thread pool. The thread bindings in place
+   * when the future is created are conveyed to the thread which runs it. */
+  struct future : gc
+  {
+    static constexpr object_type obj_type{ object_type::future };
+    static constexpr bool pointer_free{ false };
+
+    enum class state : u8
+    {
+      pending,
+      running,
+      done,
+      failed,
+      cancelled
+    };
+
+    future() = default;
+    future(object_ref fn);
+
+    /* Queues up the fn on the shared thread pool. */
+    static future_ref submit(object_ref fn);
+
+    /* behavior::object_like */
+    bool equal(object const &) const;
+    jtl::immutable_string to_string() const;
+    void to_string(jtl::string_builder &buff) const;
+    jtl::immutable_string to_code_string() const;
+    uhash to_hash() const;
+
+    /* behavior::derefable */
+    object_ref deref();
+    object_ref deref(object_ref timeout_ms, object_ref timeout_val);
+
+    /* behavior::pending */
+    bool is_realized() const;
+
+    bool is_done() const;
+    bool is_cancelled() const;
+    /* Running futures can't be interrupted, so this only works if the future hasn't
+     * started yet. Returns whether it was cancelled. */
+    bool cancel();
+
+    /* Called on the pool's thread. */
+    void run();
+
+    object base{ obj_type };
+    object_ref fn{};
+    persistent_hash_map_ref bindings;
+    object_ref val{};
+    /* jank exceptions are GC allocated objects, so they're kept here, where the GC can see
+     * them. Anything else is kept as an exception_ptr. */
+    object_ref error{};
+    std::exception_ptr native_error;
+    state current_state{ state::pending };
+    mutable std::mutex mutex;
+    std::condition_variable completed;
+
+  private:
+    object_ref result() const;
+    /* Waits for completion, with a timeout in milliseconds if one is given. Returns
+     * whether we completed. */
+    bool wait(jtl::option<i64> const &timeout_ms);
+  };
+}
@@ -53,6 +53,9 @@ namespace jank::runtime::obj
     integer_range_ref seq() const;
     integer_range_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::sequenceable */
     integer_ref first() const;
     integer_range_ref next() const;
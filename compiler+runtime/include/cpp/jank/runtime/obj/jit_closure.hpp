@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/behavior/callable.hpp>
 
@@ -73,6 +75,10 @@ namespace jank::runtime::obj
 
     object_ref this_object_ref() final;
 
+    /* Swaps the given arity over to its optimized code, once it's hot. */
+    template <typename F>
+    void tier_up(F &arity, u32 &countdown);
+
     object base{ obj_type };
     void *context{};
     object *(*arity_0)(object *){};
@@ -126,5 +132,8 @@ namespace jank::runtime::obj
                         object *){};
     jtl::option<object_ref> meta;
     arity_flag_t arity_flags{};
+    /* One per arity. Each counts down to zero, at which point we try to tier that arity
+     * up, so that arities which never get hot are left alone. */
+    std::array<u32, 11> calls_until_tier_up{};
   };
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 #include <jtl/option.hpp>
 
 #include <jank/runtime/object.hpp>
@@ -10,7 +13,6 @@ namespace jank::runtime::obj
   using cons_ref = oref<struct cons>;
   using lazy_sequence_ref = oref<struct lazy_sequence>;
 
-  /* TODO: IPending analog, to implement `realized?`. */
   struct lazy_sequence : gc
   {
     static constexpr object_type obj_type{ object_type::lazy_sequence };
@@ -18,8 +20,8 @@ namespace jank::runtime::obj
     static constexpr bool is_sequential{ true };
 
     lazy_sequence() = default;
-    lazy_sequence(lazy_sequence &&) noexcept = default;
-    lazy_sequence(lazy_sequence const &) = default;
+    lazy_sequence(lazy_sequence &&) noexcept = delete;
+    lazy_sequence(lazy_sequence const &) = delete;
     lazy_sequence(object_ref fn);
     lazy_sequence(object_ref fn, object_ref sequence);
 
@@ -45,22 +47,32 @@ namespace jank::runtime::obj
     /* behavior::metadatable */
     lazy_sequence_ref with_meta(object_ref m) const;
 
-  private:
-    object_ref resolve_fn() const;
-    object_ref resolve_seq() const;
+    /* behavior::pending */
+    bool is_realized() const;
 
-    void realize() const;
+  private:
+    object_ref realize() const;
     void force() const;
-    void lock_and_force() const;
     object_ref sval() const;
-    object_ref unwrap(object_ref ls) const;
+
+    /* Claims this lazy seq for the calling thread, sleeping while another thread has it.
+     * Throws if the calling thread already has it, since that means the seq is being
+     * realized from within its own body. */
+    void lock() const;
+    void unlock() const;
 
   public:
-    /* TODO: Synchronize. */
     object base{ obj_type };
-    mutable object_ref fn{};
+    /* Once realized, the seq is published here and never changes again, so reading a
+     * realized lazy seq is just an acquire load. Until then, it's null and the fields
+     * below may only be written by the thread which holds the lock. Contention only
+     * costs anything while a seq is being realized. */
+    mutable std::atomic<object *> realized{};
+    mutable std::atomic<std::thread::id> owner{};
+    /* This is null once it's been called. It's atomic so that is_realized can check that
+     * without taking the lock. */
+    mutable std::atomic<object *> fn{};
     mutable object_ref sv{};
-    mutable object_ref s{};
     jtl::option<object_ref> meta;
   };
 }
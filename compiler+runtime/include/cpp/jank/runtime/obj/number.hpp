@@ -1,7 +1,17 @@
 #pragma once
 
+#include <array>
+
 #include <jank/runtime/object.hpp>
 
+/* These are normally provided by CMake, so the JIT sees the same bounds as the runtime. */
+#ifndef JANK_INTEGER_CACHE_MIN
+  #define JANK_INTEGER_CACHE_MIN -1024
+#endif
+#ifndef JANK_INTEGER_CACHE_MAX
+  #define JANK_INTEGER_CACHE_MAX 1024
+#endif
+
 namespace jank::runtime::obj
 {
   using boolean_ref = oref<struct boolean>;
@@ -111,4 +121,19 @@ namespace jank::runtime
   extern obj::boolean_ref jank_true;
   /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
   extern obj::boolean_ref jank_false;
+
+  namespace detail
+  {
+    /* Boxes for common numbers are preallocated, since they're immutable and can be
+     * shared. This saves an allocation for the most common results of arithmetic. The
+     * boxes live in read-only memory, so nobody can change what 1 means. */
+    static constexpr i64 integer_cache_min{ JANK_INTEGER_CACHE_MIN };
+    static constexpr i64 integer_cache_max{ JANK_INTEGER_CACHE_MAX };
+    static_assert(integer_cache_min <= 0 && 0 <= integer_cache_max);
+
+    extern std::array<obj::integer, integer_cache_max - integer_cache_min + 1> const
+      integer_cache;
+    extern obj::real const real_zero;
+    extern obj::real const real_one;
+  }
 }
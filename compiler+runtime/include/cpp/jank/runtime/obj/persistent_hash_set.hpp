@@ -55,6 +55,9 @@ namespace jank::runtime::obj
     obj::persistent_hash_set_sequence_ref seq() const;
     obj::persistent_hash_set_sequence_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::countable */
     usize count() const;
 
@@ -55,6 +55,9 @@ namespace jank::runtime::obj
     persistent_sorted_set_sequence_ref seq() const;
     persistent_sorted_set_sequence_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::countable */
     usize count() const;
 
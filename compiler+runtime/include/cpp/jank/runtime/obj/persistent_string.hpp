@@ -64,6 +64,9 @@ namespace jank::runtime::obj
     obj::persistent_string_sequence_ref seq() const;
     obj::persistent_string_sequence_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     object base{ obj_type };
     jtl::immutable_string data;
   };
@@ -62,6 +62,9 @@ namespace jank::runtime::obj
     persistent_vector_sequence_ref seq() const;
     persistent_vector_sequence_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::countable */
     usize count() const;
 
@@ -5,6 +5,7 @@
 namespace jank::runtime::obj
 {
   using cons_ref = oref<struct cons>;
+  using array_chunk_ref = oref<struct array_chunk>;
   using persistent_vector_ref = oref<struct persistent_vector>;
   using persistent_vector_sequence_ref = oref<struct persistent_vector_sequence>;
 
@@ -34,6 +35,9 @@ namespace jank::runtime::obj
     persistent_vector_sequence_ref seq();
     persistent_vector_sequence_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::sequenceable */
     object_ref first() const;
     persistent_vector_sequence_ref next() const;
@@ -42,6 +46,10 @@ namespace jank::runtime::obj
     /* behavior::sequenceable_in_place */
     persistent_vector_sequence_ref next_in_place();
 
+    /* behavior::chunkable */
+    obj::array_chunk_ref chunked_first() const;
+    persistent_vector_sequence_ref chunked_next() const;
+
     object base{ obj_type };
     obj::persistent_vector_ref vec{};
     usize index{};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime::obj
+{
+  using promise_ref = oref<struct promise>;
+
+  /* A value which can be delivered once, from any thread. Derefs block until then. */
+  struct promise : gc
+  {
+    static constexpr object_type obj_type{ object_type::promise };
+    static constexpr bool pointer_free{ false };
+
+    promise() = default;
+
+    /* behavior::object_like */
+    bool equal(object const &) const;
+    jtl::immutable_string to_string() const;
+    void to_string(jtl::string_builder &buff) const;
+    jtl::immutable_string to_code_string() const;
+    uhash to_hash() const;
+
+    /* behavior::derefable */
+    object_ref deref();
+    object_ref deref(object_ref timeout_ms, object_ref timeout_val);
+
+    /* behavior::pending */
+    bool is_realized() const;
+
+    /* Only the first delivery has any effect. Returns whether this one did. */
+    bool deliver(object_ref o);
+
+    object base{ obj_type };
+    object_ref val{};
+    bool delivered{};
+    mutable std::mutex mutex;
+    std::condition_variable delivery;
+  };
+}
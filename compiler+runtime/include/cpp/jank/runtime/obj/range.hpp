@@ -52,6 +52,9 @@ namespace jank::runtime::obj
     range_ptr seq();
     range_ptr fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::sequenceable */
     object_ref first() const;
     range_ptr next() const;
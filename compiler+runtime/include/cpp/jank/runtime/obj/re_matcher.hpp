@@ -1,8 +1,5 @@
 #pragma once
 
-#include <regex>
-#include <string>
-
 #include <jank/runtime/obj/re_pattern.hpp>
 #include <jank/runtime/object.hpp>
 
@@ -27,7 +24,10 @@ namespace jank::runtime::obj
     object base{ obj_type };
 
     re_pattern_ref re;
-    std::string match_input{};
+    jtl::immutable_string match_input;
+    /* Where the next find starts, which moves past the end of the input once there are no
+     * more matches. */
+    usize position{};
     object_ref groups{};
   };
 }
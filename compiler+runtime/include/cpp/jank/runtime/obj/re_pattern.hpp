@@ -1,9 +1,7 @@
 #pragma once
 
-#include <regex>
-#include <string>
-
 #include <jank/runtime/object.hpp>
+#include <jank/util/regex.hpp>
 
 namespace jank::runtime::obj
 {
@@ -26,6 +24,6 @@ namespace jank::runtime::obj
     object base{ obj_type };
 
     jtl::immutable_string pattern{};
-    std::regex regex{};
+    util::regex regex;
   };
 }
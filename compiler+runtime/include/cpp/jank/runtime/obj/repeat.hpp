@@ -34,6 +34,9 @@ namespace jank::runtime::obj
     repeat_ref seq();
     repeat_ref fresh_seq() const;
 
+    /* behavior::reducible */
+    object_ref reduce(object_ref f, object_ref init) const;
+
     /* behavior::sequenceable */
     object_ref first() const;
     repeat_ref next() const;
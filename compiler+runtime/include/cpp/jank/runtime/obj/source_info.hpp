@@ -0,0 +1,44 @@
+#pragma once
+
+#include <jank/runtime/object.hpp>
+#include <jank/read/source.hpp>
+
+namespace jank::runtime::obj
+{
+  using source_info_ref = oref<struct source_info>;
+  using persistent_array_map_ref = oref<struct persistent_array_map>;
+
+  /* The reader attaches source info to nearly every form it reads, but it's rarely looked at.
+   * Rather than building nested maps for each form, we keep the positions packed in here
+   * and only build the {:file :start :end} map when someone actually asks for it. Lookups
+   * through `get` work the same as they would on the map. */
+  struct source_info : gc
+  {
+    static constexpr object_type obj_type{ object_type::source_info };
+    static constexpr bool pointer_free{ false };
+
+    source_info(object_ref file,
+                read::source_position const &start,
+                read::source_position const &end);
+
+    /* behavior::object_like */
+    bool equal(object const &) const;
+    jtl::immutable_string to_string() const;
+    void to_string(jtl::string_builder &buff) const;
+    jtl::immutable_string to_code_string() const;
+    uhash to_hash() const;
+
+    /* behavior::associatively_readable */
+    object_ref get(object_ref const key) const;
+    object_ref get(object_ref const key, object_ref const fallback) const;
+    object_ref get_entry(object_ref key) const;
+    bool contains(object_ref key) const;
+
+    persistent_array_map_ref to_map() const;
+
+    object base{ obj_type };
+
+    object_ref file{};
+    read::source_position start, end;
+  };
+}
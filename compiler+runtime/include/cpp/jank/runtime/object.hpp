@@ -75,6 +75,9 @@ namespace jank::runtime
     volatile_,
     reduced,
     delay,
+    future,
+    promise,
+    agent,
     ns,
 
     var,
@@ -88,6 +91,8 @@ namespace jank::runtime
     uuid,
     inst,
 
+    source_info,
+
     opaque_box,
   };
 
@@ -213,6 +218,12 @@ namespace jank::runtime
         return "reduced";
       case object_type::delay:
         return "delay";
+      case object_type::future:
+        return "future";
+      case object_type::promise:
+        return "promise";
+      case object_type::agent:
+        return "agent";
       case object_type::ns:
         return "ns";
 
@@ -235,6 +246,9 @@ namespace jank::runtime
       case object_type::inst:
         return "inst";
 
+      case object_type::source_info:
+        return "source_info";
+
       case object_type::opaque_box:
         return "opaque_box";
     }
@@ -298,7 +312,8 @@ namespace jank::runtime
 
   /* This isn't a great name, but it represents more than just value equality, since it
    * also includes type equality. Otherwise, [] equals '(). This is important when deduping
-   * constants during codegen, since we don't want to be lossy in how we generate values. */
+   * constants during codegen, since we don't want to be lossy in how we generate values.
+   * Meta is compared too and both apply to everything within a collection, all the way down. */
   struct very_equal_to
   {
     bool operator()(object_ref const lhs, object_ref const rhs) const noexcept;
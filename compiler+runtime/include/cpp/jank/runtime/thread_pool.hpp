@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <jank/runtime/object.hpp>
+
+namespace jank::runtime
+{
+  /* A unit of work for a thread pool. Tasks are GC allocated and only ever referenced from
+   * GC allocated queues, so anything they hold onto stays alive while they wait. */
+  struct task : gc
+  {
+    virtual ~task() = default;
+    virtual void run() = 0;
+  };
+
+  /* A work stealing thread pool. Each worker has its own deque of tasks. Workers push and
+   * pop at the back of their own deque and, once it's empty, steal from the front of
+   * the others. Tasks submitted from outside of the pool are spread across the workers.
+   *
+   * Every worker is registered with the GC, so tasks may freely allocate. */
+  struct thread_pool
+  {
+    thread_pool(usize thread_count);
+    thread_pool(thread_pool const &) = delete;
+    thread_pool(thread_pool &&) noexcept = delete;
+    ~thread_pool();
+
+    void submit(task *t);
+
+    /* Blocks until `done` returns true. When called from one of this pool's workers, the
+     * worker keeps running other tasks while it waits, so that a task waiting on another
+     * task can't starve the pool. `done` must be safe to call without any locks held. */
+    void help_until(std::function<bool()> const &done);
+
+    /* Stops accepting work. Anything already queued still runs, after which the workers
+     * exit. This doesn't wait for them; destroying the pool does. */
+    void shutdown();
+
+    usize size() const;
+    /* Whether the calling thread is one of this pool's workers. */
+    bool is_worker() const;
+
+    /* The shared pool, sized to the hardware concurrency, which is used for futures. */
+    static thread_pool &shared();
+
+    struct worker : gc
+    {
+      std::mutex mutex;
+      native_deque<task *> tasks;
+    };
+
+  private:
+    void run_worker(usize index);
+    task *take_task(usize index);
+    void notify_task_done();
+
+    native_vector<worker *> workers;
+    std::vector<std::thread> threads;
+
+    /* Guards sleeping and waking. The number of queued tasks is kept here so a worker
+     * never goes to sleep while there's work it could steal. */
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable task_done;
+    usize queued{};
+    usize next_worker{};
+    bool stopping{};
+  };
+
+  /* A pool for work which may block, such as agent actions sent with `send-off`. Rather
+   * than having a fixed size, a new thread is started whenever work is submitted and no
+   * thread is free to take it. Threads which sit idle for too long exit.
+   *
+   * Since its threads are detached, the pool must outlive them. It's GC allocated and is
+   * meant to be kept alive for the rest of the process. */
+  struct elastic_thread_pool : gc
+  {
+    elastic_thread_pool(std::chrono::milliseconds idle_timeout);
+    elastic_thread_pool(elastic_thread_pool const &) = delete;
+    elastic_thread_pool(elastic_thread_pool &&) noexcept = delete;
+
+    void submit(task *t);
+
+    /* Stops accepting work. Anything already queued still runs, after which the threads
+     * exit. */
+    void shutdown();
+
+  private:
+    void run_thread();
+
+    std::chrono::milliseconds idle_timeout;
+    std::mutex mutex;
+    std::condition_variable work_available;
+    native_deque<task *> tasks;
+    usize idle{};
+    bool stopping{};
+  };
+}
@@ -1,8 +1,7 @@
 #pragma once
 
 #include <functional>
-
-#include <folly/Synchronized.h>
+#include <mutex>
 
 #include <jtl/result.hpp>
 #include <jank/runtime/object.hpp>
@@ -59,6 +58,9 @@ namespace jank::runtime
     var_ref set_dynamic(bool dyn);
 
     var_thread_binding_ref get_thread_binding() const;
+    /* Each var which is ever dynamically bound gets a unique slot, which indexes into
+     * every thread's binding stack. Slots are assigned lazily, on first binding. */
+    usize get_binding_slot();
 
     /* behavior::derefable */
     object_ref deref() const;
@@ -75,11 +77,19 @@ namespace jank::runtime
     mutable uhash hash{};
 
   private:
-    folly::Synchronized<object_ref> root;
+    /* Roots are read far more often than they're written, since every deref of a
+     * non-dynamic var goes through here. We keep them in a single atomic so that
+     * reads are just an acquire load. Writers are serialized by the mutex, so that
+     * alter_root calls its fn exactly once. It's recursive since that fn may itself
+     * write the root. */
+    std::atomic<object *> root{};
+    std::recursive_mutex root_write_mutex;
 
   public:
     std::atomic_bool dynamic{ false };
     std::atomic_bool thread_bound{ false };
+    /* Zero means no slot has been assigned yet. */
+    std::atomic<usize> binding_slot{};
   };
 
   struct var_thread_binding : gc
@@ -101,9 +111,32 @@ namespace jank::runtime
     std::thread::id thread_id;
   };
 
+  /* A frame only knows about the vars it bound. Each entry holds the binding which was
+   * shadowed, so popping the frame can put it back. */
   struct thread_binding_frame
   {
-    obj::persistent_hash_map_ref bindings{};
+    struct entry
+    {
+      usize slot{};
+      var_thread_binding_ref binding;
+    };
+
+    native_vector<entry> entries;
+  };
+
+  /* Every thread has one of these. The slots always hold the current binding for each
+   * var, indexed by `var::binding_slot`, so looking up a binding is just an index. The
+   * frames are only needed to undo bindings when they're popped. */
+  struct thread_binding_stack
+  {
+    struct slot
+    {
+      var_ref var;
+      var_thread_binding_ref binding;
+    };
+
+    native_vector<slot> slots;
+    native_vector<thread_binding_frame> frames;
   };
 
   struct var_unbound_root : gc
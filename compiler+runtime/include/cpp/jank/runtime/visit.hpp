@@ -51,12 +51,16 @@
 #include <jank/runtime/obj/atom.hpp>
 #include <jank/runtime/obj/volatile.hpp>
 #include <jank/runtime/obj/delay.hpp>
+#include <jank/runtime/obj/future.hpp>
+#include <jank/runtime/obj/promise.hpp>
+#include <jank/runtime/obj/agent.hpp>
 #include <jank/runtime/obj/reduced.hpp>
 #include <jank/runtime/obj/tagged_literal.hpp>
 #include <jank/runtime/obj/re_pattern.hpp>
 #include <jank/runtime/obj/re_matcher.hpp>
 #include <jank/runtime/obj/uuid.hpp>
 #include <jank/runtime/obj/inst.hpp>
+#include <jank/runtime/obj/source_info.hpp>
 #include <jank/runtime/obj/opaque_box.hpp>
 #include <jank/runtime/ns.hpp>
 #include <jank/runtime/var.hpp>
@@ -192,6 +196,12 @@ namespace jank::runtime
         return fn(expect_object<obj::reduced>(erased), std::forward<Args>(args)...);
       case object_type::delay:
         return fn(expect_object<obj::delay>(erased), std::forward<Args>(args)...);
+      case object_type::future:
+        return fn(expect_object<obj::future>(erased), std::forward<Args>(args)...);
+      case object_type::promise:
+        return fn(expect_object<obj::promise>(erased), std::forward<Args>(args)...);
+      case object_type::agent:
+        return fn(expect_object<obj::agent>(erased), std::forward<Args>(args)...);
       case object_type::ns:
         return fn(expect_object<ns>(erased), std::forward<Args>(args)...);
       case object_type::var:
@@ -210,6 +220,8 @@ namespace jank::runtime
         return fn(expect_object<obj::uuid>(erased), std::forward<Args>(args)...);
       case object_type::inst:
         return fn(expect_object<obj::inst>(erased), std::forward<Args>(args)...);
+      case object_type::source_info:
+        return fn(expect_object<obj::source_info>(erased), std::forward<Args>(args)...);
       case object_type::opaque_box:
         return fn(expect_object<obj::opaque_box>(erased), std::forward<Args>(args)...);
       default:
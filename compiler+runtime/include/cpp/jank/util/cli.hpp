@@ -29,6 +29,11 @@ namespace jank::util::cli
     bool profiler_enabled{};
     bool perf_profiling_enabled{};
     bool gc_incremental{};
+    /* Zero leaves the GC's own default in place. */
+    usize gc_initial_heap{};
+    usize gc_max_heap{};
+    usize gc_free_space_divisor{};
+    u32 gc_markers{};
     codegen_type codegen{ codegen_type::llvm_ir };
 
     /* Native dependencies. */
@@ -39,7 +44,8 @@ namespace jank::util::cli
 
     /* Compilation. */
     bool debug{};
-    u8 optimization_level{};
+    u8 optimization_level{ 2 };
+    bool tiered_compilation{};
     bool direct_call{};
 
     /* Run command. */
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+
+#include <jtl/immutable_string_view.hpp>
+#include <jtl/option.hpp>
+
+#include <jank/type.hpp>
+
+namespace jank::util
+{
+  /* Our own regex engine, which follows Java's syntax and leftmost-first semantics, since
+   * that's what Clojure code expects. Input is matched as UTF-8, by code point.
+   *
+   * Patterns are compiled to a small NFA program. Searches first run a lazily built DFA
+   * forward, to find where the match ends, and then backward from there, to find where
+   * it starts. Only if groups are needed do we run a Pike VM over the match itself. All
+   * of these are linear in the size of the input and use no recursion. Patterns with
+   * backreferences, lookaround, or atomic groups can't be matched that way, so they
+   * fall back to a backtracker, which uses an explicit stack.
+   *
+   * A regex may be used from many threads at once. */
+  struct regex
+  {
+    static constexpr usize npos{ static_cast<usize>(-1) };
+
+    /* Byte offsets into the input for each group, with group 0 being the whole match. A
+     * group which didn't take part in the match has npos offsets. */
+    struct match
+    {
+      usize start(usize const group = 0) const
+      {
+        return offsets[group * 2];
+      }
+
+      usize end(usize const group = 0) const
+      {
+        return offsets[group * 2 + 1];
+      }
+
+      bool matched(usize const group) const
+      {
+        return offsets[group * 2] != npos;
+      }
+
+      native_vector<usize> offsets;
+    };
+
+    struct impl;
+
+    /* Throws a std::runtime_error if the pattern is invalid. */
+    regex(jtl::immutable_string_view const &pattern);
+    regex(regex const &) = delete;
+    regex(regex &&) noexcept = delete;
+    ~regex();
+
+    /* Finds the leftmost match starting at or after `from`. Assertions like `^` and `\b`
+     * still see the whole input, rather than treating `from` as its start. When groups
+     * aren't wanted, only group 0 is filled in, which saves running the Pike VM. */
+    jtl::option<match>
+    search(jtl::immutable_string_view const &input, usize from, bool want_groups = true) const;
+    /* Only matches if the whole input matches. */
+    jtl::option<match> full_match(jtl::immutable_string_view const &input) const;
+
+    /* The number of capturing groups, not counting group 0. */
+    usize group_count() const;
+    /* Returns npos if there's no group by that name. */
+    usize group_index(jtl::immutable_string_view const &name) const;
+
+    /* Where to search for the next match after m. An empty match has to move along by a
+     * char, so we don't find it again. Past the end of the input, this is larger than its
+     * size. */
+    static usize resume_from(jtl::immutable_string_view const &input, match const &m);
+
+    std::unique_ptr<impl> pimpl;
+  };
+}
@@ -270,6 +270,12 @@ namespace clojure::core_native
     return jank_nil;
   }
 
+  object_ref record_module_dependency(object_ref const path)
+  {
+    __rt_ctx->record_module_dependency(runtime::to_string(path));
+    return jank_nil;
+  }
+
   object_ref compile(object_ref const path)
   {
     __rt_ctx->compile_module(runtime::to_string(path)).expect_ok();
@@ -362,7 +368,7 @@ extern "C" jank_object_ref jank_load_clojure_core_native()
   intern_fn("false?", &is_false);
   intern_fn("not", &core_native::not_);
   intern_fn("some?", &is_some);
-  intern_fn("meta", &meta);
+  intern_fn("meta", &materialized_meta);
   intern_fn("with-meta", &with_meta);
   intern_fn("reset-meta!", &reset_meta);
   intern_fn("macroexpand-1", &macroexpand1);
@@ -506,6 +512,7 @@ extern "C" jank_object_ref jank_load_clojure_core_native()
   intern_fn("ns-unmap", &core_native::ns_unmap);
   intern_fn("refer", &core_native::refer);
   intern_fn("load-module", &core_native::load_module);
+  intern_fn("record-module-dependency", &core_native::record_module_dependency);
   intern_fn("compile", &core_native::compile);
   intern_fn("eval", &core_native::eval);
   intern_fn("hash-unordered-coll", &core_native::hash_unordered);
@@ -0,0 +1,60 @@
+#include <clojure/edn_native.hpp>
+#include <jank/read/edn.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/module/loader.hpp>
+#include <jank/util/fmt.hpp>
+
+namespace clojure::edn_native
+{
+  using namespace jank;
+  using namespace jank::runtime;
+
+  static read::edn::options to_options(object_ref const opts)
+  {
+    read::edn::options ret;
+    ret.readers = get(opts, __rt_ctx->intern_keyword("readers").expect_ok());
+    ret.default_reader = get(opts, __rt_ctx->intern_keyword("default").expect_ok());
+    ret.dedupe_strings = truthy(get(opts, __rt_ctx->intern_keyword("dedupe-strings").expect_ok()));
+    return ret;
+  }
+
+  /* Reads only the first form. If there isn't one, we follow clojure.edn and return the
+   * :eof value, if present. Otherwise, reaching the end is an error. */
+  static object_ref read_first(object_ref const opts, jtl::immutable_string_view const &data)
+  {
+    read::edn::processor p_prc{ data, to_options(opts) };
+    auto const form(p_prc.next().expect_ok());
+    if(form.is_some())
+    {
+      return form.unwrap();
+    }
+
+    auto const eof(__rt_ctx->intern_keyword("eof").expect_ok());
+    if(contains(opts, eof))
+    {
+      return get(opts, eof);
+    }
+    throw std::runtime_error{ "EOF while reading" };
+  }
+
+  object_ref read_string(object_ref const opts, object_ref const s)
+  {
+    auto const str(runtime::to_string(s));
+    return read_first(opts, str);
+  }
+
+  /* Files are mapped, rather than read into memory, and the reader pulls tokens straight
+   * from the mapping. Everything we keep from it is copied into the forms we build, so the
+   * mapping can go away once we're done. */
+  object_ref read_file(object_ref const opts, object_ref const path)
+  {
+    auto const file(module::loader::read_file(runtime::to_string(path)));
+    if(file.is_err())
+    {
+      throw std::runtime_error{ util::format("Unable to read EDN file: {}",
+                                             file.expect_err()) };
+    }
+    return read_first(opts, file.expect_ok().view());
+  }
+}
@@ -1,3 +1,5 @@
+#include <cctype>
+
 #include <clojure/string_native.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/obj/jit_function.hpp>
@@ -91,50 +93,157 @@ namespace clojure::string_native
     return buff.release();
   }
 
-  static jtl::immutable_string replace_first(jtl::immutable_string const &s,
-                                             std::regex const &match,
-                                             jtl::immutable_string const &replacement)
+  /* Follows java.util.regex.Matcher.appendReplacement, where $1 or ${name} stand for a group
+   * and a backslash escapes the next char. */
+  static void append_replacement(jtl::string_builder &buff,
+                                 jtl::immutable_string const &s,
+                                 util::regex const &re,
+                                 util::regex::match const &m,
+                                 jtl::immutable_string const &replacement)
   {
-    auto const out_str(std::regex_replace(s.c_str(),
-                                          match,
-                                          replacement.c_str(),
-                                          std::regex_constants::format_first_only));
+    auto const size(replacement.size());
+    for(usize i{}; i < size; ++i)
+    {
+      auto const c(replacement[i]);
+      if(c == '\\')
+      {
+        if(++i == size)
+        {
+          throw std::runtime_error{ "Character to be escaped is missing" };
+        }
+        buff(replacement[i]);
+        continue;
+      }
+      if(c != '$')
+      {
+        buff(c);
+        continue;
+      }
+
+      if(++i == size)
+      {
+        throw std::runtime_error{ "Illegal group reference: group index is missing" };
+      }
+
+      usize group{};
+      if(replacement[i] == '{')
+      {
+        auto const close(replacement.find('}', i));
+        if(close == jtl::immutable_string::npos)
+        {
+          throw std::runtime_error{ "Named capturing group is missing trailing '}'" };
+        }
+        auto const name(replacement.substr(i + 1, close - i - 1));
+        group = re.group_index(name);
+        if(group == util::regex::npos)
+        {
+          throw std::runtime_error{ util::format("No group with name '{}'", name) };
+        }
+        i = close;
+      }
+      else
+      {
+        if(!std::isdigit(static_cast<unsigned char>(replacement[i])))
+        {
+          throw std::runtime_error{ "Illegal group reference" };
+        }
+        group = static_cast<usize>(replacement[i] - '0');
+        if(group > re.group_count())
+        {
+          throw std::runtime_error{ util::format("No group {}", group) };
+        }
+
+        /* Like Java, we take as many digits as still make a valid group. */
+        while(i + 1 < size && std::isdigit(static_cast<unsigned char>(replacement[i + 1])))
+        {
+          auto const next(group * 10 + static_cast<usize>(replacement[i + 1] - '0'));
+          if(next > re.group_count())
+          {
+            break;
+          }
+          group = next;
+          ++i;
+        }
+      }
 
-    return jtl::immutable_string{ out_str.c_str() };
+      if(m.matched(group))
+      {
+        buff(s.substr(m.start(group), m.end(group) - m.start(group)));
+      }
+    }
   }
 
-  static jtl::immutable_string replace_first(jtl::immutable_string const &s,
-                                             std::regex const &match,
-                                             object_ref const replacement)
+  /* Replaces the first match, or every match, with whatever the append fn adds for it. */
+  template <typename F>
+  static jtl::immutable_string replace_matches(jtl::immutable_string const &s,
+                                               util::regex const &re,
+                                               bool const all,
+                                               bool const want_groups,
+                                               F const &append)
   {
-    std::smatch match_results{};
-    std::string const search_str{ s.c_str() };
-    std::regex_search(search_str, match_results, match);
-
-    if(match_results.empty())
+    auto found(re.search(s, 0, want_groups));
+    if(found.is_none())
     {
       return s;
     }
 
-    auto const i(match_results.position(0));
-
-    jtl::string_builder buff;
-    buff(s.substr(0, i));
-
-    auto const group(smatch_to_vector(match_results));
-    auto const replacement_value(dynamic_call(replacement, group));
-    buff(try_object<obj::persistent_string>(replacement_value)->data);
+    jtl::string_builder buff{ s.size() };
+    usize last{};
+    while(found.is_some())
+    {
+      auto const &m(found.unwrap());
+      buff(s.substr(last, m.start() - last));
+      append(buff, m);
+      last = m.end();
+      if(!all)
+      {
+        break;
+      }
 
-    auto const rest_i(i + match_results[0].str().size());
+      auto const next(util::regex::resume_from(s, m));
+      found = re.search(s, next, want_groups);
+    }
 
-    if(rest_i < s.size())
+    if(last < s.size())
     {
-      buff(s.substr(rest_i));
+      buff(s.substr(last));
     }
 
     return buff.release();
   }
 
+  static jtl::immutable_string replace_matches(jtl::immutable_string const &s,
+                                               util::regex const &re,
+                                               bool const all,
+                                               jtl::immutable_string const &replacement)
+  {
+    /* Groups are only needed if the replacement refers to them. */
+    auto const want_groups(replacement.find('$') != jtl::immutable_string::npos);
+    return replace_matches(s,
+                           re,
+                           all,
+                           want_groups,
+                           [&](jtl::string_builder &buff, util::regex::match const &m) {
+                             append_replacement(buff, s, re, m, replacement);
+                           });
+  }
+
+  static jtl::immutable_string replace_matches(jtl::immutable_string const &s,
+                                               util::regex const &re,
+                                               bool const all,
+                                               object_ref const replacement)
+  {
+    return replace_matches(s,
+                           re,
+                           all,
+                           true,
+                           [&](jtl::string_builder &buff, util::regex::match const &m) {
+                             auto const replacement_value(
+                               dynamic_call(replacement, match_groups(s, m)));
+                             buff(try_object<obj::persistent_string>(replacement_value)->data);
+                           });
+  }
+
   static jtl::immutable_string replace_first(jtl::immutable_string const &s,
                                              object_ref const match,
                                              object_ref const replacement)
@@ -154,12 +263,13 @@ namespace clojure::string_native
       case object_type::re_pattern:
         if(replacement->type == object_type::persistent_string)
         {
-          return replace_first(s,
-                               try_object<obj::re_pattern>(match)->regex,
-                               try_object<obj::persistent_string>(replacement)->data);
+          return replace_matches(s,
+                                 try_object<obj::re_pattern>(match)->regex,
+                                 false,
+                                 try_object<obj::persistent_string>(replacement)->data);
         }
 
-        return replace_first(s, try_object<obj::re_pattern>(match)->regex, replacement);
+        return replace_matches(s, try_object<obj::re_pattern>(match)->regex, false, replacement);
       default:
         throw std::runtime_error{ util::format("Invalid match arg: {}",
                                                runtime::to_code_string(match)) };
@@ -178,6 +288,115 @@ namespace clojure::string_native
     return is_string && output_str == s_str ? s : make_box(output_str);
   }
 
+  static jtl::immutable_string replace(jtl::immutable_string const &s,
+                                       jtl::immutable_string const &match,
+                                       jtl::immutable_string const &replacement)
+  {
+    jtl::string_builder buff{ s.size() };
+
+    /* Like Java, an empty match goes before every char and at the end. */
+    if(match.empty())
+    {
+      for(usize i{}; i < s.size(); ++i)
+      {
+        if((static_cast<unsigned char>(s[i]) & 0xc0) != 0x80)
+        {
+          buff(replacement);
+        }
+        buff(s[i]);
+      }
+      buff(replacement);
+      return buff.release();
+    }
+
+    auto i(s.find(match));
+    if(i == jtl::immutable_string::npos)
+    {
+      return s;
+    }
+
+    usize last{};
+    while(i != jtl::immutable_string::npos)
+    {
+      buff(s.substr(last, i - last));
+      buff(replacement);
+      last = i + match.size();
+      i = s.find(match, last);
+    }
+
+    if(last < s.size())
+    {
+      buff(s.substr(last));
+    }
+
+    return buff.release();
+  }
+
+  static jtl::immutable_string replace(jtl::immutable_string const &s,
+                                       object_ref const match,
+                                       object_ref const replacement)
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(match->type)
+    {
+      case object_type::character:
+        return replace(s,
+                       try_object<obj::character>(match)->data,
+                       try_object<obj::character>(replacement)->data);
+      case object_type::persistent_string:
+        return replace(s,
+                       try_object<obj::persistent_string>(match)->data,
+                       try_object<obj::persistent_string>(replacement)->data);
+      case object_type::re_pattern:
+        if(replacement->type == object_type::persistent_string)
+        {
+          return replace_matches(s,
+                                 try_object<obj::re_pattern>(match)->regex,
+                                 true,
+                                 try_object<obj::persistent_string>(replacement)->data);
+        }
+
+        return replace_matches(s, try_object<obj::re_pattern>(match)->regex, true, replacement);
+      default:
+        throw std::runtime_error{ util::format("Invalid match arg: {}",
+                                               runtime::to_code_string(match)) };
+    }
+#pragma clang diagnostic pop
+  }
+
+  object_ref replace(object_ref const s, object_ref const match, object_ref const replacement)
+  {
+    auto const is_string(s->type == object_type::persistent_string);
+    auto const &s_str(is_string ? try_object<obj::persistent_string>(s)->data
+                                : runtime::to_string(s));
+
+    auto const output_str(replace(s_str, match, replacement));
+
+    return is_string && output_str == s_str ? s : make_box(output_str);
+  }
+
+  object_ref re_quote_replacement(object_ref const replacement)
+  {
+    auto const r_str(runtime::to_string(replacement));
+    if(r_str.find('\\') == jtl::immutable_string::npos
+       && r_str.find('$') == jtl::immutable_string::npos)
+    {
+      return make_box(r_str);
+    }
+
+    jtl::string_builder buff{ r_str.size() * 2 };
+    for(auto const c : r_str)
+    {
+      if(c == '\\' || c == '$')
+      {
+        buff('\\');
+      }
+      buff(c);
+    }
+    return make_box(buff.release());
+  }
+
   i64 index_of(object_ref const s, object_ref const value, object_ref const from_index)
   {
     auto const s_str(runtime::to_string(s));
@@ -318,68 +537,65 @@ namespace clojure::string_native
     return make_box(s_str.substr(0, r));
   }
 
-  object_ref split(object_ref const s, object_ref const re)
+  /* Follows java.util.regex.Pattern.split. A positive limit caps the number of results,
+   * with the last one holding the rest of the input. A limit of zero drops trailing empty
+   * strings, while a negative limit keeps them. */
+  static object_ref split(jtl::immutable_string const &s, util::regex const &re, i64 const limit)
   {
-    auto const s_str(try_object<obj::persistent_string>(s)->data);
-    auto const regex(try_object<obj::re_pattern>(re)->regex);
-
-    std::string const search_str{ s_str.c_str() };
-
     native_vector<object_ref> vec;
-    std::sregex_token_iterator iter(search_str.begin(), search_str.end(), regex, -1);
-    std::sregex_token_iterator const end;
-
-    if(iter != end && iter->str().empty())
-    {
-      ++iter;
-    }
-
-    for(; iter != end; ++iter)
+    usize last{};
+    usize pos{};
+    while(limit <= 0 || static_cast<i64>(vec.size()) + 1 < limit)
     {
-      vec.emplace_back(make_box<obj::persistent_string>(iter->str().c_str()));
-    }
+      auto const found(re.search(s, pos, false));
+      if(found.is_none())
+      {
+        break;
+      }
 
-    return make_box<obj::persistent_vector>(
-      runtime::detail::native_persistent_vector{ vec.begin(), vec.end() });
-  }
+      auto const &m(found.unwrap());
+      pos = util::regex::resume_from(s, m);
 
-  object_ref split(object_ref const s, object_ref const re, object_ref const limit)
-  {
-    auto const limit_int(try_object<obj::integer>(limit)->data);
+      /* An empty match at the very start doesn't give us a leading empty string. */
+      if(m.end() == 0)
+      {
+        continue;
+      }
 
-    if(limit_int < 1)
-    {
-      return split(s, re);
+      vec.emplace_back(make_box<obj::persistent_string>(s.substr(last, m.start() - last)));
+      last = m.end();
     }
 
-    auto const s_str(try_object<obj::persistent_string>(s)->data);
-    auto const regex(try_object<obj::re_pattern>(re)->regex);
-
-    std::string const search_str{ s_str.c_str() };
-
-    native_vector<object_ref> vec;
-    vec.reserve(limit_int);
-
-    std::sregex_token_iterator iter(search_str.begin(), search_str.end(), regex, -1);
-    std::sregex_token_iterator const end;
-
-    if(iter != end && iter->str().empty())
+    if(vec.empty())
     {
-      ++iter;
+      return make_box<obj::persistent_vector>(std::in_place, make_box<obj::persistent_string>(s));
     }
 
-    int i{ 1 };
-    for(; i < limit_int && iter != end; ++i, ++iter)
-    {
-      vec.emplace_back(make_box<obj::persistent_string>(iter->str().c_str()));
-    }
+    vec.emplace_back(make_box<obj::persistent_string>(s.substr(last)));
 
-    if(i == limit_int)
+    if(limit == 0)
     {
-      vec.emplace_back(make_box(s_str.substr(iter->first - search_str.begin())));
+      while(!vec.empty() && expect_object<obj::persistent_string>(vec.back())->data.empty())
+      {
+        vec.pop_back();
+      }
     }
 
     return make_box<obj::persistent_vector>(
       runtime::detail::native_persistent_vector{ vec.begin(), vec.end() });
   }
+
+  object_ref split(object_ref const s, object_ref const re)
+  {
+    return split(try_object<obj::persistent_string>(s)->data,
+                 try_object<obj::re_pattern>(re)->regex,
+                 0);
+  }
+
+  object_ref split(object_ref const s, object_ref const re, object_ref const limit)
+  {
+    return split(try_object<obj::persistent_string>(s)->data,
+                 try_object<obj::re_pattern>(re)->regex,
+                 try_object<obj::integer>(limit)->data);
+  }
 }
@@ -246,7 +246,8 @@ int main(int argc, const char** argv)
       compiler_args.push_back(strdup("-Wl,--export-dynamic"));
     }
     compiler_args.push_back(strdup("-rdynamic"));
-    compiler_args.push_back(strdup("-O2"));
+    compiler_args.push_back(
+      strdup(util::format("-O{}", util::cli::opts.optimization_level).c_str()));
 
     /* Required because of `strdup` usage and need to manually free the memory.
      * Clang expects C strings that we own. */
@@ -9,8 +9,10 @@
 
 #include <jank/c_api.h>
 #include <jank/runtime/visit.hpp>
+#include <jank/runtime/call_site.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/core.hpp>
+#include <jank/runtime/gc.hpp>
 #include <jank/aot/resource.hpp>
 #include <jank/profile/time.hpp>
 #include <jank/util/scope_exit.hpp>
@@ -347,6 +349,69 @@ extern "C"
       .erase();
   }
 
+  void *jank_call_site_create()
+  {
+    return call_site::create();
+  }
+
+  jank_object_ref jank_call0_cached(void * const site, jank_object_ref const f)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+    static_cast<call_site *>(site)->update(f_obj, 0);
+    return dynamic_call(f_obj).erase();
+  }
+
+  jank_object_ref
+  jank_call1_cached(void * const site, jank_object_ref const f, jank_object_ref const a1)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+    auto const a1_obj(reinterpret_cast<object *>(a1));
+    static_cast<call_site *>(site)->update(f_obj, 1);
+    return dynamic_call(f_obj, a1_obj).erase();
+  }
+
+  jank_object_ref jank_call2_cached(void * const site,
+                                    jank_object_ref const f,
+                                    jank_object_ref const a1,
+                                    jank_object_ref const a2)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+    auto const a1_obj(reinterpret_cast<object *>(a1));
+    auto const a2_obj(reinterpret_cast<object *>(a2));
+    static_cast<call_site *>(site)->update(f_obj, 2);
+    return dynamic_call(f_obj, a1_obj, a2_obj).erase();
+  }
+
+  jank_object_ref jank_call3_cached(void * const site,
+                                    jank_object_ref const f,
+                                    jank_object_ref const a1,
+                                    jank_object_ref const a2,
+                                    jank_object_ref const a3)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+    auto const a1_obj(reinterpret_cast<object *>(a1));
+    auto const a2_obj(reinterpret_cast<object *>(a2));
+    auto const a3_obj(reinterpret_cast<object *>(a3));
+    static_cast<call_site *>(site)->update(f_obj, 3);
+    return dynamic_call(f_obj, a1_obj, a2_obj, a3_obj).erase();
+  }
+
+  jank_object_ref jank_call4_cached(void * const site,
+                                    jank_object_ref const f,
+                                    jank_object_ref const a1,
+                                    jank_object_ref const a2,
+                                    jank_object_ref const a3,
+                                    jank_object_ref const a4)
+  {
+    auto const f_obj(reinterpret_cast<object *>(f));
+    auto const a1_obj(reinterpret_cast<object *>(a1));
+    auto const a2_obj(reinterpret_cast<object *>(a2));
+    auto const a3_obj(reinterpret_cast<object *>(a3));
+    auto const a4_obj(reinterpret_cast<object *>(a4));
+    static_cast<call_site *>(site)->update(f_obj, 4);
+    return dynamic_call(f_obj, a1_obj, a2_obj, a3_obj, a4_obj).erase();
+  }
+
   jank_object_ref jank_const_nil()
   {
     return jank_nil.erase();
@@ -408,7 +473,7 @@ extern "C"
   jank_object_ref jank_character_create(char const *s)
   {
     jank_debug_assert(s);
-    return make_box<obj::character>(read::parse::get_char_from_literal(s).unwrap()).erase();
+    return make_box(read::parse::get_char_from_literal(s).unwrap()).erase();
   }
 
   jank_object_ref jank_regex_create(char const *s)
@@ -507,6 +572,60 @@ extern "C"
     return trans.to_persistent().erase();
   }
 
+  jank_object_ref jank_const_list_create(jank_u64 const size, jank_object_ref const * const items)
+  {
+    runtime::detail::native_persistent_list npl;
+    for(u64 i{ size }; i > 0; --i)
+    {
+      npl = npl.conj(reinterpret_cast<object *>(items[i - 1]));
+    }
+    return make_box<obj::persistent_list>(std::move(npl)).erase();
+  }
+
+  jank_object_ref jank_const_vector_create(jank_u64 const size, jank_object_ref const * const items)
+  {
+    obj::transient_vector trans;
+    for(u64 i{}; i < size; ++i)
+    {
+      trans.conj_in_place(reinterpret_cast<object *>(items[i]));
+    }
+    return trans.to_persistent().erase();
+  }
+
+  jank_object_ref
+  jank_const_array_map_create(jank_u64 const pairs, jank_object_ref const * const items)
+  {
+    runtime::detail::native_array_map m;
+    for(u64 i{}; i < pairs; ++i)
+    {
+      m.insert_unique(reinterpret_cast<object *>(items[i * 2]),
+                      reinterpret_cast<object *>(items[i * 2 + 1]));
+    }
+    return make_box<obj::persistent_array_map>(std::move(m)).erase();
+  }
+
+  jank_object_ref
+  jank_const_hash_map_create(jank_u64 const pairs, jank_object_ref const * const items)
+  {
+    obj::transient_hash_map trans;
+    for(u64 i{}; i < pairs; ++i)
+    {
+      trans.assoc_in_place(reinterpret_cast<object *>(items[i * 2]),
+                           reinterpret_cast<object *>(items[i * 2 + 1]));
+    }
+    return trans.to_persistent().erase();
+  }
+
+  jank_object_ref jank_const_set_create(jank_u64 const size, jank_object_ref const * const items)
+  {
+    obj::transient_hash_set trans;
+    for(u64 i{}; i < size; ++i)
+    {
+      trans.conj_in_place(reinterpret_cast<object *>(items[i]));
+    }
+    return trans.to_persistent().erase();
+  }
+
   jank_object_ref jank_box(void const * const o)
   {
     return make_box<obj::opaque_box>(o).erase();
@@ -917,6 +1036,169 @@ extern "C"
     return integer;
   }
 
+  jank_object_ref jank_add(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return add(l_obj, r_obj).erase();
+  }
+
+  jank_object_ref jank_sub(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return sub(l_obj, r_obj).erase();
+  }
+
+  jank_object_ref jank_mul(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return mul(l_obj, r_obj).erase();
+  }
+
+  jank_object_ref jank_div(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return div(l_obj, r_obj).erase();
+  }
+
+  jank_object_ref jank_inc(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return inc(o_obj).erase();
+  }
+
+  jank_object_ref jank_dec(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return dec(o_obj).erase();
+  }
+
+  jank_bool jank_lt(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return static_cast<jank_bool>(lt(l_obj, r_obj));
+  }
+
+  jank_bool jank_lte(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return static_cast<jank_bool>(lte(l_obj, r_obj));
+  }
+
+  jank_bool jank_is_equiv(jank_object_ref const l, jank_object_ref const r)
+  {
+    auto const l_obj(reinterpret_cast<object *>(l));
+    auto const r_obj(reinterpret_cast<object *>(r));
+    return static_cast<jank_bool>(is_equiv(l_obj, r_obj));
+  }
+
+  jank_bool jank_is_zero(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return static_cast<jank_bool>(is_zero(o_obj));
+  }
+
+  jank_bool jank_is_pos(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return static_cast<jank_bool>(is_pos(o_obj));
+  }
+
+  jank_bool jank_is_neg(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return static_cast<jank_bool>(is_neg(o_obj));
+  }
+
+  jank_object_ref jank_get(jank_object_ref const m, jank_object_ref const key)
+  {
+    auto const m_obj(reinterpret_cast<object *>(m));
+    auto const key_obj(reinterpret_cast<object *>(key));
+    return get(m_obj, key_obj).erase();
+  }
+
+  jank_object_ref
+  jank_get_or(jank_object_ref const m, jank_object_ref const key, jank_object_ref const fallback)
+  {
+    auto const m_obj(reinterpret_cast<object *>(m));
+    auto const key_obj(reinterpret_cast<object *>(key));
+    auto const fallback_obj(reinterpret_cast<object *>(fallback));
+    return get(m_obj, key_obj, fallback_obj).erase();
+  }
+
+  jank_object_ref jank_nth(jank_object_ref const o, jank_object_ref const index)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    auto const index_obj(reinterpret_cast<object *>(index));
+    return nth(o_obj, index_obj).erase();
+  }
+
+  jank_object_ref
+  jank_nth_or(jank_object_ref const o, jank_object_ref const index, jank_object_ref const fallback)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    auto const index_obj(reinterpret_cast<object *>(index));
+    auto const fallback_obj(reinterpret_cast<object *>(fallback));
+    return nth(o_obj, index_obj, fallback_obj).erase();
+  }
+
+  jank_i64 jank_count(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return static_cast<jank_i64>(sequence_length(o_obj));
+  }
+
+  jank_object_ref jank_first(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return first(o_obj).erase();
+  }
+
+  jank_object_ref jank_next(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return next(o_obj).erase();
+  }
+
+  jank_object_ref jank_rest(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return rest(o_obj).erase();
+  }
+
+  jank_object_ref jank_conj(jank_object_ref const coll, jank_object_ref const o)
+  {
+    auto const coll_obj(reinterpret_cast<object *>(coll));
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return conj(coll_obj, o_obj).erase();
+  }
+
+  jank_object_ref
+  jank_assoc(jank_object_ref const m, jank_object_ref const key, jank_object_ref const val)
+  {
+    auto const m_obj(reinterpret_cast<object *>(m));
+    auto const key_obj(reinterpret_cast<object *>(key));
+    auto const val_obj(reinterpret_cast<object *>(val));
+    return assoc(m_obj, key_obj, val_obj).erase();
+  }
+
+  jank_i64 jank_long_cast(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return to_int(o_obj);
+  }
+
+  jank_f64 jank_double_cast(jank_object_ref const o)
+  {
+    auto const o_obj(reinterpret_cast<object *>(o));
+    return to_real(o_obj);
+  }
+
   void jank_set_meta(jank_object_ref const o, jank_object_ref const meta)
   {
     auto const o_obj(reinterpret_cast<object *>(o));
@@ -1016,8 +1298,7 @@ extern "C"
 
       /* The GC needs to enabled even before arg parsing, since our native types,
        * like strings, use the GC for allocations. It can still be configured later. */
-      GC_set_all_interior_pointers(1);
-      GC_enable();
+      runtime::gc::init(argc, argv);
 
       llvm::llvm_shutdown_obj const Y{};
 
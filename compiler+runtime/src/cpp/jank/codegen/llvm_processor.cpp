@@ -23,6 +23,7 @@
 #include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 
 #include <jank/runtime/visit.hpp>
+#include <jank/runtime/call_site.hpp>
 #include <jank/codegen/llvm_processor.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/core/meta.hpp>
@@ -31,6 +32,7 @@
 #include <jank/analyze/visit.hpp>
 #include <jank/analyze/rtti.hpp>
 #include <jank/analyze/cpp_util.hpp>
+#include <jank/analyze/pass/walk.hpp>
 #include <jank/profile/time.hpp>
 #include <jank/util/fmt/print.hpp>
 #include <jank/util/scope_exit.hpp>
@@ -49,10 +51,37 @@ namespace jank::codegen
     llvm::Value *field_ptr{};
   };
 
+  /* The analysis managers and pass pipeline are tied to an LLVM context, but not to any
+   * particular module, so they can be shared by every module built within that context. */
+  struct optimization_pipeline
+  {
+    optimization_pipeline(llvm::LLVMContext &llvm_ctx, u8 level);
+
+    void run(llvm::Module &module);
+
+    std::unique_ptr<llvm::LoopAnalysisManager> lam;
+    std::unique_ptr<llvm::FunctionAnalysisManager> fam;
+    std::unique_ptr<llvm::CGSCCAnalysisManager> cgam;
+    std::unique_ptr<llvm::ModuleAnalysisManager> mam;
+    std::unique_ptr<llvm::PassInstrumentationCallbacks> pic;
+    std::unique_ptr<llvm::StandardInstrumentations> si;
+    llvm::ModulePassManager mpm;
+  };
+
+  /* The state shared by every module generated while a module_batch_scope is alive. */
+  struct module_batch
+  {
+    module_batch();
+
+    llvm::orc::ThreadSafeContext llvm_ctx;
+    std::shared_ptr<optimization_pipeline> pipeline;
+  };
+
+  static thread_local std::shared_ptr<module_batch> current_batch;
+
   struct reusable_context
   {
-    reusable_context(jtl::immutable_string const &module_name,
-                     std::unique_ptr<llvm::LLVMContext> llvm_ctx);
+    reusable_context(jtl::immutable_string const &module_name, compilation_target target);
 
     jtl::immutable_string module_name;
     jtl::immutable_string ctor_name;
@@ -71,16 +100,113 @@ namespace jank::codegen
     native_unordered_map<obj::symbol_ref, llvm::Value *> var_root_globals;
     native_unordered_map<jtl::immutable_string, llvm::Value *> c_string_globals;
 
-    /* Optimization details. */
-    std::unique_ptr<llvm::LoopAnalysisManager> lam;
-    std::unique_ptr<llvm::FunctionAnalysisManager> fam;
-    std::unique_ptr<llvm::CGSCCAnalysisManager> cgam;
-    std::unique_ptr<llvm::ModuleAnalysisManager> mam;
-    std::unique_ptr<llvm::PassInstrumentationCallbacks> pic;
-    std::unique_ptr<llvm::StandardInstrumentations> si;
-    llvm::ModulePassManager mpm;
+    /* Optimization details. Shared with the current batch, if there is one. */
+    std::shared_ptr<optimization_pipeline> pipeline;
+  };
+
+  enum class intrinsic_op : u8
+  {
+    add,
+    sub,
+    mul,
+    div,
+    inc,
+    dec,
+    lt,
+    lte,
+    gt,
+    gte,
+    equiv,
+    is_zero,
+    is_pos,
+    is_neg,
+    equal,
+    identical,
+    is_nil,
+    is_some,
+    not_,
+    get,
+    nth,
+    count,
+    first,
+    next,
+    rest,
+    conj,
+    assoc,
+    long_cast,
+    double_cast
+  };
+
+  /* A clojure.core fn which we can call without going through its var. */
+  struct intrinsic
+  {
+    jtl::immutable_string_view name;
+    usize arity{};
+    intrinsic_op op{};
+    /* The C API fn which does the work, when it's not done inline. */
+    char const *c_fn{};
+  };
+
+  enum class native_number_kind : u8
+  {
+    none,
+    integer,
+    real
+  };
+
+  /* A local which we keep as an i64 or an f64. If it's ever needed as an object, we box it
+   * where it's used, so a box on one path isn't paid for on the others. */
+  struct unboxed_local
+  {
+    native_number_kind kind{};
+    llvm::Value *value{};
+    llvm::BasicBlock *bound_block{};
+    /* The last instruction in the block when the local was bound, if there was one. */
+    llvm::Instruction *bound_after{};
+    /* How many loops we were within when the local was bound. */
+    usize loop_depth{};
+    /* Index into impl::local_boxes. */
+    usize box_index{};
+  };
+
+  /* A loop which we generate in place, rather than as a fn, so that a recur is just a branch
+   * back to the top of it. Each loop local is a phi, so numbers can stay unboxed. */
+  struct inline_loop
+  {
+    analyze::local_frame_ptr frame;
+    llvm::BasicBlock *block{};
+    native_vector<obj::symbol_ref> params;
+    native_vector<native_number_kind> kinds;
+    native_vector<llvm::PHINode *> phis;
   };
 
+  /* A param can be hinted with ^long or ^double to make it a primitive. */
+  static native_number_kind hinted_number_kind(obj::symbol_ref const sym)
+  {
+    if(sym->meta.is_none())
+    {
+      return native_number_kind::none;
+    }
+
+    auto const tag(
+      runtime::get(sym->meta.unwrap(), __rt_ctx->intern_keyword("tag").expect_ok()));
+    if(tag->type != runtime::object_type::symbol)
+    {
+      return native_number_kind::none;
+    }
+
+    auto const tag_sym(runtime::expect_object<obj::symbol>(tag));
+    if(tag_sym->ns.empty() && tag_sym->name == "long")
+    {
+      return native_number_kind::integer;
+    }
+    if(tag_sym->ns.empty() && tag_sym->name == "double")
+    {
+      return native_number_kind::real;
+    }
+    return native_number_kind::none;
+  }
+
   struct llvm_processor::impl
   {
     impl(analyze::expr::function_ref const expr,
@@ -132,6 +258,41 @@ namespace jank::codegen
     llvm::Value *gen(analyze::expr::cpp_new_ref, analyze::expr::function_arity const &);
     llvm::Value *gen(analyze::expr::cpp_delete_ref, analyze::expr::function_arity const &);
 
+    llvm::Value *gen_intrinsic(analyze::expr::call_ref,
+                               intrinsic const &,
+                               analyze::expr::function_arity const &);
+    llvm::Value *gen_native_intrinsic(analyze::expr::call_ref,
+                                      intrinsic const &,
+                                      analyze::expr::function_arity const &);
+    llvm::Value *gen_native_op(analyze::expr::call_ref,
+                               intrinsic const &,
+                               analyze::expr::function_arity const &);
+    llvm::Value *gen_native_number(analyze::expression_ref, analyze::expr::function_arity const &);
+    llvm::Value *gen_coerced_number(analyze::expression_ref,
+                                    native_number_kind kind,
+                                    analyze::expr::function_arity const &);
+    llvm::Value *gen_object(analyze::expression_ref, analyze::expr::function_arity const &);
+    llvm::Value *gen_condition(analyze::expression_ref, analyze::expr::function_arity const &);
+    llvm::Value *gen_boxed_bool(llvm::Value *cond) const;
+    llvm::Value *gen_boxed_number(llvm::Value *number) const;
+    llvm::Value *gen_unboxed_number(llvm::Value *object, native_number_kind kind) const;
+
+    native_number_kind native_number_kind_of(analyze::expression_ref) const;
+    native_number_kind
+    binding_number_kind(obj::symbol_ref name, analyze::expression_ref value_expr) const;
+    void bind_unboxed_local(obj::symbol_ref name,
+                            native_number_kind kind,
+                            llvm::Value *value,
+                            llvm::Value *box = nullptr);
+    llvm::Value *box_local(unboxed_local const &local);
+
+    jtl::ptr<analyze::expr::function> find_inline_loop(analyze::expr::call_ref) const;
+    llvm::Value *gen_inline_loop(analyze::expr::call_ref,
+                                 analyze::expr::function const &,
+                                 analyze::expr::function_arity const &);
+    void refine_loop_kinds(analyze::expression_ref, inline_loop &);
+    llvm::Value *gen_cached_call(llvm::ArrayRef<llvm::Value *> args);
+
     llvm::Value *gen_var(obj::symbol_ref qualified_name) const;
     llvm::Value *gen_var_root(obj::symbol_ref qualified_name, var_root_kind kind) const;
     llvm::Value *gen_c_string(jtl::immutable_string const &s) const;
@@ -155,6 +316,8 @@ namespace jank::codegen
     llvm::Value *gen_global(runtime::obj::re_pattern_ref re) const;
     llvm::Value *gen_global(runtime::obj::uuid_ref u) const;
     llvm::Value *gen_global(runtime::obj::inst_ref i) const;
+    llvm::Value *gen_global_constant(runtime::object_ref o) const;
+    llvm::Value *gen_global_collection(runtime::object_ref o) const;
     llvm::Value *gen_global_from_read_string(runtime::object_ref o) const;
     llvm::Value *gen_function_instance(analyze::expr::function_ref expr,
                                        analyze::expr::function_arity const &fn_arity);
@@ -183,6 +346,14 @@ namespace jank::codegen
     jtl::ptr<llvm::Function> fn{};
     std::unique_ptr<reusable_context> ctx;
     native_unordered_map<obj::symbol_ref, jtl::ptr<llvm::Value>> locals;
+    /* These shadow any local of the same name. */
+    native_unordered_map<obj::symbol_ref, unboxed_local> unboxed_locals;
+    /* Boxes for unboxed locals, made on demand, by the block they're in. These outlive any
+     * one scope, so they're kept apart from unboxed_locals, which is saved and restored
+     * around each scope. */
+    native_vector<native_unordered_map<llvm::BasicBlock *, llvm::Value *>> local_boxes;
+    /* The loops we're within, innermost last. */
+    native_vector<inline_loop> loops;
     /* TODO: Use gc allocator to avoid leaks. */
     std::list<deferred_init> deferred_inits{};
     jtl::ref<llvm::LLVMContext> llvm_ctx;
@@ -469,36 +640,21 @@ namespace jank::codegen
     return load_ret;
   }
 
-  reusable_context::reusable_context(jtl::immutable_string const &module_name,
-                                     std::unique_ptr<llvm::LLVMContext> llvm_ctx)
-    : module_name{ module_name }
-    , ctor_name{ __rt_ctx->unique_munged_string("jank_global_init") }
-    //, llvm_ctx{ std::make_unique<llvm::LLVMContext>() }
-    //, llvm_ctx{ reinterpret_cast<std::unique_ptr<llvm::orc::ThreadSafeContext> *>(
-    //              reinterpret_cast<void *>(
-    //                &static_cast<clang::Interpreter &>(*__rt_ctx->jit_prc.interpreter)))
-    //              ->getContext() }
-    , lam{ std::make_unique<llvm::LoopAnalysisManager>() }
+  /* With tiered compilation, everything starts at -O0 and only hot functions are
+   * recompiled at the requested level. */
+  static u8 jit_optimization_level()
+  {
+    return util::cli::opts.tiered_compilation ? 0 : util::cli::opts.optimization_level;
+  }
+
+  optimization_pipeline::optimization_pipeline(llvm::LLVMContext &llvm_ctx, u8 const level)
+    : lam{ std::make_unique<llvm::LoopAnalysisManager>() }
     , fam{ std::make_unique<llvm::FunctionAnalysisManager>() }
     , cgam{ std::make_unique<llvm::CGSCCAnalysisManager>() }
     , mam{ std::make_unique<llvm::ModuleAnalysisManager>() }
     , pic{ std::make_unique<llvm::PassInstrumentationCallbacks>() }
+    , si{ std::make_unique<llvm::StandardInstrumentations>(llvm_ctx, /*DebugLogging*/ false) }
   {
-    auto m{ std::make_unique<llvm::Module>(__rt_ctx->unique_munged_string(module_name).c_str(),
-                                           *llvm_ctx) };
-    module = llvm::orc::ThreadSafeModule{ std::move(m), std::move(llvm_ctx) };
-    builder = std::make_unique<llvm::IRBuilder<>>(*module.getContext().getContextUnlocked());
-    global_ctor_block
-      = llvm::BasicBlock::Create(*module.getContext().getContextUnlocked(), "entry");
-    si = std::make_unique<llvm::StandardInstrumentations>(*module.getContext().getContextUnlocked(),
-                                                          /*DebugLogging*/ false);
-
-    /* The LLVM front-end tips documentation suggests setting the target triple and
-     * data layout to improve back-end codegen performance. */
-    auto const raw_module{ module.getModuleUnlocked() };
-    raw_module->setTargetTriple(llvm::Triple{ util::default_target_triple().c_str() });
-    raw_module->setDataLayout(__rt_ctx->jit_prc.interpreter->getExecutionEngine()->getDataLayout());
-
     /* TODO: Add more passes and measure the order of the passes. */
 
     si->registerCallbacks(*pic, mam.get());
@@ -509,9 +665,92 @@ namespace jank::codegen
     pb.registerFunctionAnalyses(*fam);
     pb.registerLoopAnalyses(*lam);
     pb.crossRegisterProxies(*lam, *fam, *cgam, *mam);
-    /* TODO: Configure this level based on the CLI optimization flag.
-     * Benchmark to find the best default. */
-    mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    switch(level)
+    {
+      case 0:
+        mpm = pb.buildO0DefaultPipeline(llvm::OptimizationLevel::O0);
+        break;
+      case 1:
+        mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O1);
+        break;
+      case 2:
+        mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+        break;
+      default:
+        mpm = pb.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O3);
+        break;
+    }
+  }
+
+  void optimization_pipeline::run(llvm::Module &module)
+  {
+    mpm.run(module, *mam);
+
+    /* Cached analyses are keyed by the module and function addresses. Once this module
+     * is handed off to the JIT, it may be freed and its addresses reused by the next
+     * module, so we can't keep any results around. */
+    lam->clear();
+    fam->clear();
+    cgam->clear();
+    mam->clear();
+  }
+
+  module_batch::module_batch()
+    : llvm_ctx{ std::make_unique<llvm::LLVMContext>() }
+    , pipeline{ std::make_shared<optimization_pipeline>(*llvm_ctx.getContextUnlocked(),
+                                                      jit_optimization_level()) }
+  {
+  }
+
+  module_batch_scope::module_batch_scope()
+  {
+    /* Nested module loads just join the outer batch. */
+    if(!current_batch)
+    {
+      current_batch = std::make_shared<module_batch>();
+      owner = true;
+    }
+  }
+
+  module_batch_scope::~module_batch_scope()
+  {
+    if(owner)
+    {
+      current_batch.reset();
+    }
+  }
+
+  reusable_context::reusable_context(jtl::immutable_string const &module_name,
+                                     compilation_target const target)
+    : module_name{ module_name }
+    , ctor_name{ __rt_ctx->unique_munged_string("jank_global_init") }
+  {
+    /* Creating an LLVM context and building the pass pipeline is a fixed cost which
+     * otherwise dominates small modules. When we're within a batch, such as when loading
+     * a whole source file, every top-level form shares these.
+     *
+     * Modules being compiled to object files are the exception. They're optimized and
+     * emitted on another thread, which they can only do if they have a context to
+     * themselves. */
+    auto const batch{ target == compilation_target::module ? nullptr : current_batch };
+    llvm::orc::ThreadSafeContext const llvm_ctx{
+      batch ? batch->llvm_ctx : llvm::orc::ThreadSafeContext{ std::make_unique<llvm::LLVMContext>() }
+    };
+    auto &raw_ctx{ *llvm_ctx.getContextUnlocked() };
+    pipeline = batch ? batch->pipeline
+                     : std::make_shared<optimization_pipeline>(raw_ctx, jit_optimization_level());
+
+    auto m{ std::make_unique<llvm::Module>(__rt_ctx->unique_munged_string(module_name).c_str(),
+                                           raw_ctx) };
+    module = llvm::orc::ThreadSafeModule{ std::move(m), llvm_ctx };
+    builder = std::make_unique<llvm::IRBuilder<>>(raw_ctx);
+    global_ctor_block = llvm::BasicBlock::Create(raw_ctx, "entry");
+
+    /* The LLVM front-end tips documentation suggests setting the target triple and
+     * data layout to improve back-end codegen performance. */
+    auto const raw_module{ module.getModuleUnlocked() };
+    raw_module->setTargetTriple(llvm::Triple{ util::default_target_triple().c_str() });
+    raw_module->setDataLayout(__rt_ctx->jit_prc.interpreter->getExecutionEngine()->getDataLayout());
   }
 
   /* There are three places where a var-root could be generated,
@@ -553,7 +792,7 @@ namespace jank::codegen
                              compilation_target const target)
     : target{ target }
     , root_fn{ expr }
-    , ctx{ std::make_unique<reusable_context>(module_name, std::make_unique<llvm::LLVMContext>()) }
+    , ctx{ std::make_unique<reusable_context>(module_name, target) }
     , llvm_ctx{ ctx->module.getContext().getContextUnlocked() }
     , llvm_module{ ctx->module.getModuleUnlocked() }
   {
@@ -644,6 +883,7 @@ namespace jank::codegen
      * impossible to have as a local, so it's safe. */
     locals[make_box<obj::symbol>("virtual/this")] = this_arg;
     locals[make_box<obj::symbol>(root_fn->name)] = this_arg;
+    unboxed_locals.clear();
 
     for(usize i{}; i < arity.params.size(); ++i)
     {
@@ -651,6 +891,14 @@ namespace jank::codegen
       auto arg(fn->getArg(i + 1));
       arg->setName(param->get_name().c_str());
       locals[param] = arg;
+
+      /* Args are always passed boxed, so a hinted param is unboxed on the way in. */
+      auto const kind{ hinted_number_kind(param) };
+      auto const is_rest_param{ arity.fn_ctx->is_variadic && i + 1 == arity.params.size() };
+      if(kind != native_number_kind::none && !is_rest_param)
+      {
+        bind_unboxed_local(param, kind, gen_unboxed_number(arg, kind));
+      }
     }
 
     if(is_closure)
@@ -782,8 +1030,7 @@ namespace jank::codegen
                                 false));
       auto const set_meta_fn(llvm_module->getOrInsertFunction("jank_set_meta", set_meta_fn_type));
 
-      auto const meta(
-        gen_global_from_read_string(strip_source_from_meta(expr->name->meta.unwrap())));
+      auto const meta(gen_global_constant(strip_source_from_meta(expr->name->meta.unwrap())));
       ctx->builder->CreateCall(set_meta_fn, { ref, meta });
     }
 
@@ -877,9 +1124,672 @@ namespace jank::codegen
     }
   }
 
+  /* Clojure's codegen skips the var for certain calls to clojure.core fns, so that calls to
+   * `+` become `Numbers.add`, calls to `get` become `RT.get`, and so on. We do the same, by
+   * calling straight into the C API rather than derefing the var and doing a dynamic call.
+   * This means redefining one of these fns, with `def`, `alter-var-root`, or
+   * `with-redefs`, won't affect code which was compiled before. We only do this for the
+   * numeric and comparison fns, which the C++ codegen also skips the var for.
+   *
+   * When the operands of a numeric intrinsic are known to be native numbers, the work is
+   * done inline, without any boxing of the operands. `>` and `>=` are done with `<` and
+   * `<=`, with the operands swapped. `long` and `double` are here so that their results can
+   * be kept unboxed, like Clojure's primitive coercions. */
+  static native_vector<intrinsic> const intrinsics{
+    {          "+", 2,         intrinsic_op::add,         "jank_add" },
+    {          "-", 2,         intrinsic_op::sub,         "jank_sub" },
+    {          "*", 2,         intrinsic_op::mul,         "jank_mul" },
+    {          "/", 2,         intrinsic_op::div,         "jank_div" },
+    {        "inc", 1,         intrinsic_op::inc,         "jank_inc" },
+    {        "dec", 1,         intrinsic_op::dec,         "jank_dec" },
+    {          "<", 2,          intrinsic_op::lt,          "jank_lt" },
+    {         "<=", 2,         intrinsic_op::lte,         "jank_lte" },
+    {          ">", 2,          intrinsic_op::gt,          "jank_lt" },
+    {         ">=", 2,         intrinsic_op::gte,         "jank_lte" },
+    {         "==", 2,       intrinsic_op::equiv,    "jank_is_equiv" },
+    {      "zero?", 1,     intrinsic_op::is_zero,     "jank_is_zero" },
+    {       "pos?", 1,      intrinsic_op::is_pos,      "jank_is_pos" },
+    {       "neg?", 1,      intrinsic_op::is_neg,      "jank_is_neg" },
+    { "identical?", 2,   intrinsic_op::identical,            nullptr },
+    {       "nil?", 1,      intrinsic_op::is_nil,            nullptr },
+    {      "some?", 1,     intrinsic_op::is_some,            nullptr },
+    {       "long", 1,   intrinsic_op::long_cast,   "jank_long_cast" },
+    {     "double", 1, intrinsic_op::double_cast, "jank_double_cast" },
+  };
+
+  /* The rest of these are only used with --direct-call, which already gives up on
+   * redefinition being seen by existing code. */
+  static native_vector<intrinsic> const direct_call_intrinsics{
+    {     "=", 2, intrinsic_op::equal,  "jank_equal" },
+    {   "not", 1,  intrinsic_op::not_, "jank_truthy" },
+    {   "get", 2,   intrinsic_op::get,    "jank_get" },
+    {   "get", 3,   intrinsic_op::get, "jank_get_or" },
+    {   "nth", 2,   intrinsic_op::nth,    "jank_nth" },
+    {   "nth", 3,   intrinsic_op::nth, "jank_nth_or" },
+    { "count", 1, intrinsic_op::count,  "jank_count" },
+    { "first", 1, intrinsic_op::first,  "jank_first" },
+    {  "next", 1,  intrinsic_op::next,   "jank_next" },
+    {  "rest", 1,  intrinsic_op::rest,   "jank_rest" },
+    {  "conj", 2,  intrinsic_op::conj,   "jank_conj" },
+    { "assoc", 3, intrinsic_op::assoc,  "jank_assoc" },
+  };
+
+  static intrinsic const *find_intrinsic(expr::call_ref const expr)
+  {
+    auto const ref{ llvm::dyn_cast<expr::var_deref>(expr->source_expr.data) };
+    /* Dynamic vars can be rebound, so we always need to go through them. */
+    if(!ref || ref->var->dynamic.load() || ref->var->n->name->name != "clojure.core")
+    {
+      return nullptr;
+    }
+
+    auto const &name{ ref->var->name->name };
+    auto const arity{ expr->arg_exprs.size() };
+    for(auto const &i : intrinsics)
+    {
+      if(i.arity == arity && name == i.name)
+      {
+        return &i;
+      }
+    }
+    if(__rt_ctx->opts.direct_call)
+    {
+      for(auto const &i : direct_call_intrinsics)
+      {
+        if(i.arity == arity && name == i.name)
+        {
+          return &i;
+        }
+      }
+    }
+    return nullptr;
+  }
+
+  /* Number literals are known to be numbers and native values are only converted into objects
+   * so they can be passed to the fn. In both cases, we can use the number directly. We only
+   * handle signed integers and floating point values here, since the conversion trait is the
+   * source of truth for how anything else becomes an object. Unboxed locals are native
+   * numbers, as is any arithmetic done on native numbers. */
+  native_number_kind llvm_processor::impl::native_number_kind_of(expression_ref const expr) const
+  {
+    if(auto const literal = llvm::dyn_cast<expr::primitive_literal>(expr.data))
+    {
+      if(literal->data->type == runtime::object_type::integer)
+      {
+        return native_number_kind::integer;
+      }
+      if(literal->data->type == runtime::object_type::real)
+      {
+        return native_number_kind::real;
+      }
+      return native_number_kind::none;
+    }
+
+    if(auto const ref = llvm::dyn_cast<expr::local_reference>(expr.data))
+    {
+      auto const local(unboxed_locals.find(ref->binding->name));
+      return local == unboxed_locals.end() ? native_number_kind::none : local->second.kind;
+    }
+
+    if(auto const call = llvm::dyn_cast<expr::call>(expr.data))
+    {
+      auto const intrinsic{ find_intrinsic(call) };
+      if(!intrinsic)
+      {
+        return native_number_kind::none;
+      }
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+      switch(intrinsic->op)
+      {
+        case intrinsic_op::long_cast:
+          return native_number_kind::integer;
+        case intrinsic_op::double_cast:
+          return native_number_kind::real;
+        case intrinsic_op::add:
+        case intrinsic_op::sub:
+        case intrinsic_op::mul:
+        case intrinsic_op::div:
+        case intrinsic_op::inc:
+        case intrinsic_op::dec:
+          break;
+        default:
+          return native_number_kind::none;
+      }
+#pragma clang diagnostic pop
+
+      bool is_real{};
+      for(auto const &arg_expr : call->arg_exprs)
+      {
+        auto const kind{ native_number_kind_of(arg_expr) };
+        if(kind == native_number_kind::none)
+        {
+          return native_number_kind::none;
+        }
+        is_real |= kind == native_number_kind::real;
+      }
+
+      /* Dividing integers gives us a ratio, which is best left to the runtime. */
+      if(intrinsic->op == intrinsic_op::div && !is_real)
+      {
+        return native_number_kind::none;
+      }
+      return is_real ? native_number_kind::real : native_number_kind::integer;
+    }
+
+    auto const cast{ llvm::dyn_cast<expr::cpp_cast>(expr.data) };
+    if(!cast || cast->policy != conversion_policy::into_object)
+    {
+      return native_number_kind::none;
+    }
+
+    auto const type{ cpp_util::expression_type(cast->value_expr) };
+    if(Cpp::IsReferenceType(type) || !Cpp::IsBuiltin(type) || 8 < Cpp::GetSizeOfType(type))
+    {
+      return native_number_kind::none;
+    }
+
+    auto const qtype{ clang::QualType::getFromOpaquePtr(type).getCanonicalType() };
+    if(qtype->isSignedIntegerType() && !qtype->isAnyCharacterType())
+    {
+      return native_number_kind::integer;
+    }
+    if(qtype->isRealFloatingType() && 4 <= Cpp::GetSizeOfType(type))
+    {
+      return native_number_kind::real;
+    }
+    return native_number_kind::none;
+  }
+
+  /* A let binding or loop local stays unboxed if its value is a native number. Unlike a
+   * param, a hinted binding isn't coerced, since Clojure doesn't do that either. If the hint
+   * doesn't match the kind of number the value already is, the binding stays boxed. */
+  native_number_kind
+  llvm_processor::impl::binding_number_kind(obj::symbol_ref const name,
+                                            expression_ref const value_expr) const
+  {
+    auto const kind{ native_number_kind_of(value_expr) };
+    auto const hint{ hinted_number_kind(name) };
+    if(hint != native_number_kind::none && hint != kind)
+    {
+      return native_number_kind::none;
+    }
+    return kind;
+  }
+
+  /* Generates the operand as an i64 or an f64, based on its native_number_kind. */
+  llvm::Value *llvm_processor::impl::gen_native_number(expression_ref const expr,
+                                                       expr::function_arity const &arity)
+  {
+    if(auto const literal = llvm::dyn_cast<expr::primitive_literal>(expr.data))
+    {
+      if(literal->data->type == runtime::object_type::integer)
+      {
+        return ctx->builder->getInt64(runtime::expect_object<obj::integer>(literal->data)->data);
+      }
+      return llvm::ConstantFP::get(ctx->builder->getDoubleTy(),
+                                   runtime::expect_object<obj::real>(literal->data)->data);
+    }
+
+    if(auto const ref = llvm::dyn_cast<expr::local_reference>(expr.data))
+    {
+      auto const local(unboxed_locals.find(ref->binding->name));
+      jank_debug_assert(local != unboxed_locals.end());
+      return local->second.value;
+    }
+
+    if(auto const call = llvm::dyn_cast<expr::call>(expr.data))
+    {
+      return gen_native_op(expr::call_ref{ call }, *find_intrinsic(call), arity);
+    }
+
+    /* Native values are generated as a pointer to their storage. */
+    auto const cast{ llvm::cast<expr::cpp_cast>(expr.data) };
+    auto const type{ cpp_util::expression_type(cast->value_expr) };
+    auto const ir_type{ llvm_builtin_type(*ctx, llvm_ctx, type) };
+    auto const value{ ctx->builder->CreateLoad(ir_type, gen(cast->value_expr, arity)) };
+    if(ir_type->isIntegerTy())
+    {
+      return ctx->builder->CreateSExt(value, ctx->builder->getInt64Ty());
+    }
+    return ctx->builder->CreateFPExt(value, ctx->builder->getDoubleTy());
+  }
+
+  /* Generates the operand as a number of the given kind, whatever it is. Objects are coerced
+   * the same way as `long` and `double` would do it. */
+  llvm::Value *llvm_processor::impl::gen_coerced_number(expression_ref const expr,
+                                                        native_number_kind const kind,
+                                                        expr::function_arity const &arity)
+  {
+    auto &builder{ *ctx->builder };
+    auto const expr_kind{ native_number_kind_of(expr) };
+    if(expr_kind == native_number_kind::none)
+    {
+      return gen_unboxed_number(gen_object(expr, arity), kind);
+    }
+
+    auto const number{ gen_native_number(expr, arity) };
+    if(expr_kind == kind)
+    {
+      return number;
+    }
+    if(kind == native_number_kind::real)
+    {
+      return builder.CreateSIToFP(number, builder.getDoubleTy());
+    }
+    return builder.CreateFPToSI(number, builder.getInt64Ty());
+  }
+
+  /* Generates the operand as an object, loading it if it's on the stack. */
+  llvm::Value *
+  llvm_processor::impl::gen_object(expression_ref const expr, expr::function_arity const &arity)
+  {
+    auto ret{ gen(expr, arity) };
+    if(llvm::isa<llvm::AllocaInst>(ret))
+    {
+      ret = ctx->builder->CreateLoad(ctx->builder->getPtrTy(), ret);
+    }
+    return ret;
+  }
+
+  /* Generates the i1 to branch on. Native comparisons can be branched on directly, rather than
+   * boxing them as a boolean just to check if that's truthy. */
+  llvm::Value *
+  llvm_processor::impl::gen_condition(expression_ref const expr, expr::function_arity const &arity)
+  {
+    auto &builder{ *ctx->builder };
+    if(auto const call = llvm::dyn_cast<expr::call>(expr.data))
+    {
+      auto const intrinsic{ find_intrinsic(call) };
+      auto const cond{ intrinsic ? gen_native_op(expr::call_ref{ call }, *intrinsic, arity)
+                                 : nullptr };
+      if(cond)
+      {
+        /* Numbers are always truthy. */
+        return cond->getType()->isIntegerTy(1) ? cond : builder.getTrue();
+      }
+    }
+
+    auto const truthy_fn_type(
+      llvm::FunctionType::get(builder.getInt8Ty(), { builder.getPtrTy() }, false));
+    auto const fn(llvm_module->getOrInsertFunction("jank_truthy", truthy_fn_type));
+    llvm::SmallVector<llvm::Value *, 1> const args{ gen_object(expr, arity) };
+    auto const call(builder.CreateCall(fn, args));
+    return builder.CreateICmpEQ(call, builder.getInt8(1), "iftmp");
+  }
+
+  llvm::Value *llvm_processor::impl::gen_boxed_bool(llvm::Value * const cond) const
+  {
+    auto const true_value{ gen_global(runtime::jank_true) };
+    auto const false_value{ gen_global(runtime::jank_false) };
+    return ctx->builder->CreateSelect(cond, true_value, false_value);
+  }
+
+  llvm::Value *llvm_processor::impl::gen_boxed_number(llvm::Value * const number) const
+  {
+    auto &builder{ *ctx->builder };
+    auto const is_real{ number->getType()->isDoubleTy() };
+    auto const fn_type(llvm::FunctionType::get(builder.getPtrTy(), { number->getType() }, false));
+    auto const fn(
+      llvm_module->getOrInsertFunction(is_real ? "jank_real_create" : "jank_integer_create",
+                                       fn_type));
+    llvm::SmallVector<llvm::Value *, 1> const args{ number };
+    return builder.CreateCall(fn, args);
+  }
+
+  llvm::Value *llvm_processor::impl::gen_unboxed_number(llvm::Value * const object,
+                                                        native_number_kind const kind) const
+  {
+    auto &builder{ *ctx->builder };
+    auto const is_real{ kind == native_number_kind::real };
+    auto const fn_type(
+      llvm::FunctionType::get(is_real ? builder.getDoubleTy() : builder.getInt64Ty(),
+                              { builder.getPtrTy() },
+                              false));
+    auto const fn(
+      llvm_module->getOrInsertFunction(is_real ? "jank_double_cast" : "jank_long_cast", fn_type));
+    llvm::SmallVector<llvm::Value *, 1> const args{ object };
+    return builder.CreateCall(fn, args);
+  }
+
+  void llvm_processor::impl::bind_unboxed_local(obj::symbol_ref const name,
+                                                native_number_kind const kind,
+                                                llvm::Value * const value,
+                                                llvm::Value * const box)
+  {
+    auto &builder{ *ctx->builder };
+    unboxed_local local;
+    local.kind = kind;
+    local.value = value;
+    local.bound_block = builder.GetInsertBlock();
+    if(builder.GetInsertPoint() != local.bound_block->begin())
+    {
+      local.bound_after = &*std::prev(builder.GetInsertPoint());
+    }
+    local.loop_depth = loops.size();
+    local.box_index = local_boxes.size();
+
+    local_boxes.emplace_back();
+    if(box)
+    {
+      local_boxes.back().emplace(local.bound_block, box);
+    }
+    unboxed_locals.insert_or_assign(name, local);
+  }
+
+  /* A box in the block where the local was bound comes before every use, so anything can
+   * share it. Otherwise, the box goes where it's used and is only shared within that block.
+   * That way, a loop local which is only boxed on the way out of the loop isn't boxed on
+   * every iteration. Uses within a loop which is nested inside the local's scope are the
+   * exception, since the box where the local was bound is made once, rather than once per
+   * iteration of that loop. */
+  llvm::Value *llvm_processor::impl::box_local(unboxed_local const &local)
+  {
+    auto &boxes{ local_boxes[local.box_index] };
+    if(auto const bound_box{ boxes.find(local.bound_block) }; bound_box != boxes.end())
+    {
+      return bound_box->second;
+    }
+
+    auto &builder{ *ctx->builder };
+    if(local.loop_depth < loops.size())
+    {
+      llvm::IRBuilder<>::InsertPointGuard const guard{ builder };
+      builder.SetInsertPoint(local.bound_block,
+                             local.bound_after ? std::next(local.bound_after->getIterator())
+                                               : local.bound_block->begin());
+      auto const box{ gen_boxed_number(local.value) };
+      boxes.emplace(local.bound_block, box);
+      return box;
+    }
+
+    auto &box{ boxes[builder.GetInsertBlock()] };
+    if(!box)
+    {
+      box = gen_boxed_number(local.value);
+    }
+    return box;
+  }
+
+  /* Returns null if the intrinsic can't be done inline, since not all of its operands are
+   * native numbers. Nothing is generated in that case. Otherwise, arithmetic gives us an
+   * i64 or an f64 and comparisons give us an i1. */
+  llvm::Value *llvm_processor::impl::gen_native_op(expr::call_ref const expr,
+                                                   intrinsic const &intrinsic,
+                                                   expr::function_arity const &arity)
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(intrinsic.op)
+    {
+      case intrinsic_op::long_cast:
+        return gen_coerced_number(expr->arg_exprs[0], native_number_kind::integer, arity);
+      case intrinsic_op::double_cast:
+        return gen_coerced_number(expr->arg_exprs[0], native_number_kind::real, arity);
+      case intrinsic_op::add:
+      case intrinsic_op::sub:
+      case intrinsic_op::mul:
+      case intrinsic_op::div:
+      case intrinsic_op::inc:
+      case intrinsic_op::dec:
+      case intrinsic_op::lt:
+      case intrinsic_op::lte:
+      case intrinsic_op::gt:
+      case intrinsic_op::gte:
+      case intrinsic_op::equiv:
+      case intrinsic_op::is_zero:
+      case intrinsic_op::is_pos:
+      case intrinsic_op::is_neg:
+        break;
+      default:
+        return nullptr;
+    }
+#pragma clang diagnostic pop
+
+    bool is_real{};
+    for(auto const &arg_expr : expr->arg_exprs)
+    {
+      auto const kind{ native_number_kind_of(arg_expr) };
+      if(kind == native_number_kind::none)
+      {
+        return nullptr;
+      }
+      is_real |= kind == native_number_kind::real;
+    }
+
+    /* Dividing integers gives us a ratio, which is best left to the runtime. */
+    if(intrinsic.op == intrinsic_op::div && !is_real)
+    {
+      return nullptr;
+    }
+
+    auto &builder{ *ctx->builder };
+    llvm::SmallVector<llvm::Value *, 2> args;
+    for(auto const &arg_expr : expr->arg_exprs)
+    {
+      auto arg{ gen_native_number(arg_expr, arity) };
+      if(is_real && arg->getType()->isIntegerTy())
+      {
+        arg = builder.CreateSIToFP(arg, builder.getDoubleTy());
+      }
+      args.emplace_back(arg);
+    }
+
+    auto const lhs{ args[0] };
+    auto const rhs{ args.size() == 2 ? args[1]
+                    : is_real        ? llvm::ConstantFP::get(builder.getDoubleTy(), 0.0)
+                                     : builder.getInt64(0) };
+    auto const one{ is_real ? llvm::ConstantFP::get(builder.getDoubleTy(), 1.0)
+                            : builder.getInt64(1) };
+
+    /* For the unary predicates, rhs is zero. */
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(intrinsic.op)
+    {
+      case intrinsic_op::add:
+        return is_real ? builder.CreateFAdd(lhs, rhs) : builder.CreateAdd(lhs, rhs);
+      case intrinsic_op::sub:
+        return is_real ? builder.CreateFSub(lhs, rhs) : builder.CreateSub(lhs, rhs);
+      case intrinsic_op::mul:
+        return is_real ? builder.CreateFMul(lhs, rhs) : builder.CreateMul(lhs, rhs);
+      case intrinsic_op::div:
+        return builder.CreateFDiv(lhs, rhs);
+      case intrinsic_op::inc:
+        return is_real ? builder.CreateFAdd(lhs, one) : builder.CreateAdd(lhs, one);
+      case intrinsic_op::dec:
+        return is_real ? builder.CreateFSub(lhs, one) : builder.CreateSub(lhs, one);
+      case intrinsic_op::lt:
+      case intrinsic_op::is_neg:
+        return is_real ? builder.CreateFCmpOLT(lhs, rhs) : builder.CreateICmpSLT(lhs, rhs);
+      case intrinsic_op::lte:
+        return is_real ? builder.CreateFCmpOLE(lhs, rhs) : builder.CreateICmpSLE(lhs, rhs);
+      case intrinsic_op::gt:
+      case intrinsic_op::is_pos:
+        return is_real ? builder.CreateFCmpOGT(lhs, rhs) : builder.CreateICmpSGT(lhs, rhs);
+      case intrinsic_op::gte:
+        return is_real ? builder.CreateFCmpOGE(lhs, rhs) : builder.CreateICmpSGE(lhs, rhs);
+      case intrinsic_op::equiv:
+      case intrinsic_op::is_zero:
+        return is_real ? builder.CreateFCmpOEQ(lhs, rhs) : builder.CreateICmpEQ(lhs, rhs);
+      default:
+        jank_debug_assert(false);
+        return nullptr;
+    }
+#pragma clang diagnostic pop
+  }
+
+  /* Like gen_native_op, but the result is boxed. */
+  llvm::Value *llvm_processor::impl::gen_native_intrinsic(expr::call_ref const expr,
+                                                          intrinsic const &intrinsic,
+                                                          expr::function_arity const &arity)
+  {
+    auto const ret{ gen_native_op(expr, intrinsic, arity) };
+    if(!ret)
+    {
+      return nullptr;
+    }
+    if(ret->getType()->isIntegerTy(1))
+    {
+      return gen_boxed_bool(ret);
+    }
+    return gen_boxed_number(ret);
+  }
+
+  llvm::Value *llvm_processor::impl::gen_intrinsic(expr::call_ref const expr,
+                                                   intrinsic const &intrinsic,
+                                                   expr::function_arity const &arity)
+  {
+    auto &builder{ *ctx->builder };
+    auto ret{ gen_native_intrinsic(expr, intrinsic, arity) };
+    if(!ret)
+    {
+      llvm::SmallVector<llvm::Value *, 3> args;
+      llvm::SmallVector<llvm::Type *, 3> arg_types;
+      for(auto const &arg_expr : expr->arg_exprs)
+      {
+        auto arg_handle{ gen(arg_expr, arity) };
+        if(llvm::isa<llvm::AllocaInst>(arg_handle))
+        {
+          arg_handle = builder.CreateLoad(builder.getPtrTy(), arg_handle);
+        }
+        args.emplace_back(arg_handle);
+        arg_types.emplace_back(builder.getPtrTy());
+      }
+
+      /* The operands are only swapped after they've been generated, to keep jank's left to
+       * right evaluation order. */
+      if(intrinsic.op == intrinsic_op::gt || intrinsic.op == intrinsic_op::gte)
+      {
+        std::swap(args[0], args[1]);
+      }
+
+      auto const call_c_fn([&](llvm::Type * const ret_type) {
+        auto const fn_type(llvm::FunctionType::get(ret_type, arg_types, false));
+        auto const fn(llvm_module->getOrInsertFunction(intrinsic.c_fn, fn_type));
+        return builder.CreateCall(fn, args);
+      });
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+      switch(intrinsic.op)
+      {
+        case intrinsic_op::identical:
+          ret = gen_boxed_bool(builder.CreateICmpEQ(args[0], args[1]));
+          break;
+        case intrinsic_op::is_nil:
+          ret = gen_boxed_bool(builder.CreateICmpEQ(args[0], gen_global(runtime::jank_nil)));
+          break;
+        case intrinsic_op::is_some:
+          ret = gen_boxed_bool(builder.CreateICmpNE(args[0], gen_global(runtime::jank_nil)));
+          break;
+        case intrinsic_op::not_:
+          ret = gen_boxed_bool(
+            builder.CreateICmpEQ(call_c_fn(builder.getInt8Ty()), builder.getInt8(0)));
+          break;
+        case intrinsic_op::lt:
+        case intrinsic_op::lte:
+        case intrinsic_op::gt:
+        case intrinsic_op::gte:
+        case intrinsic_op::equiv:
+        case intrinsic_op::is_zero:
+        case intrinsic_op::is_pos:
+        case intrinsic_op::is_neg:
+        case intrinsic_op::equal:
+          ret = gen_boxed_bool(
+            builder.CreateICmpNE(call_c_fn(builder.getInt8Ty()), builder.getInt8(0)));
+          break;
+        case intrinsic_op::count:
+          ret = gen_boxed_number(call_c_fn(builder.getInt64Ty()));
+          break;
+        default:
+          ret = call_c_fn(builder.getPtrTy());
+          break;
+      }
+#pragma clang diagnostic pop
+    }
+
+    if(expr->position == expression_position::tail)
+    {
+      return builder.CreateRet(ret);
+    }
+
+    return ret;
+  }
+
+  /* Each call site gets its own inline cache. When the callee is the same one we saw last
+   * time, we call straight into its arity fn. Otherwise, we go through the C API, which
+   * calls it dynamically and updates the cache. See runtime::call_site. */
+  llvm::Value *llvm_processor::impl::gen_cached_call(llvm::ArrayRef<llvm::Value *> const args)
+  {
+    auto &builder{ *ctx->builder };
+    auto const ptr_type{ builder.getPtrTy() };
+
+    auto const site_global{ create_global_var("call_site") };
+    llvm_module->insertGlobalVariable(site_global);
+    {
+      llvm::IRBuilder<>::InsertPointGuard const guard{ builder };
+      builder.SetInsertPoint(ctx->global_ctor_block);
+
+      auto const create_fn_type(llvm::FunctionType::get(ptr_type, false));
+      auto const create_fn(
+        llvm_module->getOrInsertFunction("jank_call_site_create", create_fn_type));
+      builder.CreateStore(builder.CreateCall(create_fn), site_global);
+    }
+
+    /* The entry is swapped in by other threads, so it needs an acquire load. Its fields
+     * never change after that. */
+    auto const site{ builder.CreateLoad(ptr_type, site_global) };
+    auto const entry{ builder.CreateAlignedLoad(ptr_type, site, llvm::Align{ alignof(void *) }) };
+    entry->setAtomic(llvm::AtomicOrdering::Acquire);
+    auto const cached_callee{ builder.CreateLoad(ptr_type, entry) };
+    auto const is_hit{ builder.CreateICmpEQ(cached_callee, args[0]) };
+
+    auto const current_fn(builder.GetInsertBlock()->getParent());
+    auto const hit_block(llvm::BasicBlock::Create(*llvm_ctx, "call_site_hit", current_fn));
+    auto const miss_block(llvm::BasicBlock::Create(*llvm_ctx, "call_site_miss", current_fn));
+    auto const merge_block(llvm::BasicBlock::Create(*llvm_ctx, "call_site_cont", current_fn));
+    builder.CreateCondBr(is_hit, hit_block, miss_block);
+
+    builder.SetInsertPoint(hit_block);
+    llvm::SmallVector<llvm::Type *> const direct_arg_types(args.size(), ptr_type);
+    auto const direct_fn_type(llvm::FunctionType::get(ptr_type, direct_arg_types, false));
+    auto const direct_fn_field{ builder.CreateConstInBoundsGEP1_64(ptr_type, entry, 1) };
+    auto const direct_fn{ builder.CreateLoad(ptr_type, direct_fn_field) };
+    auto const direct_call{ builder.CreateCall(direct_fn_type, direct_fn, args) };
+    builder.CreateBr(merge_block);
+
+    builder.SetInsertPoint(miss_block);
+    llvm::SmallVector<llvm::Value *> miss_args{ site };
+    miss_args.append(args.begin(), args.end());
+    llvm::SmallVector<llvm::Type *> const miss_arg_types(miss_args.size(), ptr_type);
+    auto const miss_fn_type(llvm::FunctionType::get(ptr_type, miss_arg_types, false));
+    auto const miss_fn_name(util::format("jank_call{}_cached", args.size() - 1));
+    auto const miss_fn(llvm_module->getOrInsertFunction(miss_fn_name.c_str(), miss_fn_type));
+    auto const miss_call{ builder.CreateCall(miss_fn, miss_args) };
+    builder.CreateBr(merge_block);
+
+    builder.SetInsertPoint(merge_block);
+    auto const phi{ builder.CreatePHI(ptr_type, 2) };
+    phi->addIncoming(direct_call, hit_block);
+    phi->addIncoming(miss_call, miss_block);
+    return phi;
+  }
+
   llvm::Value *
   llvm_processor::impl::gen(expr::call_ref const expr, expr::function_arity const &arity)
   {
+    if(auto const loop_fn{ find_inline_loop(expr) })
+    {
+      return gen_inline_loop(expr, *loop_fn, arity);
+    }
+
+    if(auto const intrinsic{ find_intrinsic(expr) })
+    {
+      return gen_intrinsic(expr, *intrinsic, arity);
+    }
+
     auto const callee(gen(expr->source_expr, arity));
 
     llvm::SmallVector<llvm::Value *> arg_handles;
@@ -888,7 +1798,7 @@ namespace jank::codegen
     arg_handles.reserve(expr->arg_exprs.size() + 1);
     arg_types.reserve(expr->arg_exprs.size() + 1);
 
-    llvm::CallInst *call{};
+    llvm::Value *call{};
     if(cpp_util::is_any_object(cpp_util::expression_type(expr->source_expr)))
     {
       arg_handles.emplace_back(callee);
@@ -906,10 +1816,17 @@ namespace jank::codegen
         arg_types.emplace_back(ctx->builder->getPtrTy());
       }
 
-      auto const call_fn_name(arity_to_call_fn(expr->arg_exprs.size()));
-      auto const fn_type(llvm::FunctionType::get(ctx->builder->getPtrTy(), arg_types, false));
-      auto const fn(llvm_module->getOrInsertFunction(call_fn_name.c_str(), fn_type));
-      call = ctx->builder->CreateCall(fn, arg_handles);
+      if(expr->arg_exprs.size() <= runtime::call_site::max_arity)
+      {
+        call = gen_cached_call(arg_handles);
+      }
+      else
+      {
+        auto const call_fn_name(arity_to_call_fn(expr->arg_exprs.size()));
+        auto const fn_type(llvm::FunctionType::get(ctx->builder->getPtrTy(), arg_types, false));
+        auto const fn(llvm_module->getOrInsertFunction(call_fn_name.c_str(), fn_type));
+        call = ctx->builder->CreateCall(fn, arg_handles);
+      }
     }
     /* TODO: This can be deleted, I'm pretty sure. */
     else
@@ -935,6 +1852,213 @@ namespace jank::codegen
     return call;
   }
 
+  /* A loop is analyzed into a fn which is called on the spot, like so:
+   *
+   * ```
+   * ((fn* [a b] ...) a b)
+   * ```
+   *
+   * When that call is in tail position, we can generate the fn's body right here instead,
+   * since its tail positions are also ours. We don't do this for a fn which refers to itself,
+   * since there'd be no fn object to refer to, nor for one which uses C++ interop, since
+   * those values are put on the stack and our stack isn't unwound between iterations. */
+  jtl::ptr<expr::function> llvm_processor::impl::find_inline_loop(expr::call_ref const expr) const
+  {
+    auto const fn{ llvm::dyn_cast<expr::function>(expr->source_expr.data) };
+    if(!fn || expr->position != expression_position::tail || fn->arities.size() != 1)
+    {
+      return nullptr;
+    }
+
+    auto const &arity(fn->arities[0]);
+    if(arity.fn_ctx->is_variadic || arity.params.size() != expr->arg_exprs.size())
+    {
+      return nullptr;
+    }
+
+    bool inlinable{ true };
+    pass::prewalk(arity.body, [&](expression_ref const e) {
+      if(expression_kind::cpp_value_min <= e->kind && e->kind <= expression_kind::cpp_value_max)
+      {
+        inlinable = false;
+      }
+      else if(auto const ref = llvm::dyn_cast<expr::recursion_reference>(e.data))
+      {
+        inlinable &= ref->fn_ctx->fn.data != fn;
+      }
+      else if(auto const call = llvm::dyn_cast<expr::named_recursion>(e.data))
+      {
+        inlinable &= call->recursion_ref.fn_ctx->fn.data != fn;
+      }
+    });
+    return inlinable ? fn : nullptr;
+  }
+
+  llvm::Value *llvm_processor::impl::gen_inline_loop(expr::call_ref const expr,
+                                                     expr::function const &fn,
+                                                     expr::function_arity const &arity)
+  {
+    auto &builder{ *ctx->builder };
+    auto const &loop_arity(fn.arities[0]);
+
+    inline_loop loop;
+    loop.frame = loop_arity.frame;
+    loop.params = loop_arity.params;
+    /* Loop locals are bound just like let bindings, so hints don't coerce them either. */
+    for(usize i{}; i < loop.params.size(); ++i)
+    {
+      loop.kinds.emplace_back(binding_number_kind(loop.params[i], expr->arg_exprs[i]));
+    }
+
+    /* A loop local can only stay unboxed if every recur gives it the same kind of number it
+     * started with. Boxing one local can change what the others are given, so we keep going
+     * until nothing changes. */
+    {
+      auto const old_unboxed_locals(unboxed_locals);
+      native_vector<native_number_kind> previous;
+      do
+      {
+        previous = loop.kinds;
+        for(usize i{}; i < loop.params.size(); ++i)
+        {
+          unboxed_locals.erase(loop.params[i]);
+          if(loop.kinds[i] != native_number_kind::none)
+          {
+            unboxed_local local;
+            local.kind = loop.kinds[i];
+            unboxed_locals.emplace(loop.params[i], local);
+          }
+        }
+        refine_loop_kinds(loop_arity.body, loop);
+      } while(previous != loop.kinds);
+      unboxed_locals = old_unboxed_locals;
+    }
+
+    /* The initial values belong to the enclosing scope, so they come before the loop. */
+    native_vector<llvm::Value *> inits;
+    inits.reserve(loop.params.size());
+    for(usize i{}; i < loop.params.size(); ++i)
+    {
+      inits.emplace_back(loop.kinds[i] == native_number_kind::none
+                           ? gen_object(expr->arg_exprs[i], arity)
+                           : gen_native_number(expr->arg_exprs[i], arity));
+    }
+
+    auto const entry_block{ builder.GetInsertBlock() };
+    loop.block = llvm::BasicBlock::Create(*llvm_ctx, "loop", entry_block->getParent());
+    builder.CreateBr(loop.block);
+    builder.SetInsertPoint(loop.block);
+
+    auto old_locals(locals);
+    auto old_unboxed_locals(unboxed_locals);
+    for(usize i{}; i < loop.params.size(); ++i)
+    {
+      auto const phi{ builder.CreatePHI(inits[i]->getType(), 2, loop.params[i]->name.c_str()) };
+      phi->addIncoming(inits[i], entry_block);
+      loop.phis.emplace_back(phi);
+    }
+
+    /* This is done once all of the phis are in, since any boxes need to come after them.
+     * The loop is pushed first, since its locals are bound within it. */
+    loops.emplace_back(std::move(loop));
+    auto const &current_loop{ loops.back() };
+    for(usize i{}; i < current_loop.params.size(); ++i)
+    {
+      if(current_loop.kinds[i] == native_number_kind::none)
+      {
+        unboxed_locals.erase(current_loop.params[i]);
+        locals[current_loop.params[i]] = current_loop.phis[i];
+      }
+      else
+      {
+        bind_unboxed_local(current_loop.params[i], current_loop.kinds[i], current_loop.phis[i]);
+      }
+    }
+
+    auto const ret(gen(loop_arity.body, arity));
+    loops.pop_back();
+    locals = std::move(old_locals);
+    unboxed_locals = std::move(old_unboxed_locals);
+
+    /* XXX: No return creation, since we rely on the body to do that. */
+
+    return ret;
+  }
+
+  /* Finds each recur back to the loop, by following the tail positions of its body, and
+   * boxes any loop local which a recur would give a different kind of number. The unboxed
+   * locals are tracked just as codegen will track them, so each recur arg is seen just as
+   * it'll be generated. */
+  void llvm_processor::impl::refine_loop_kinds(expression_ref const expr, inline_loop &loop)
+  {
+    if(auto const do_expr = llvm::dyn_cast<expr::do_>(expr.data))
+    {
+      if(!do_expr->values.empty())
+      {
+        refine_loop_kinds(do_expr->values.back(), loop);
+      }
+    }
+    else if(auto const if_expr = llvm::dyn_cast<expr::if_>(expr.data))
+    {
+      refine_loop_kinds(if_expr->then, loop);
+      if(if_expr->else_.is_some())
+      {
+        refine_loop_kinds(if_expr->else_.unwrap(), loop);
+      }
+    }
+    else if(auto const case_expr = llvm::dyn_cast<expr::case_>(expr.data))
+    {
+      refine_loop_kinds(case_expr->default_expr, loop);
+      for(auto const &e : case_expr->exprs)
+      {
+        refine_loop_kinds(e, loop);
+      }
+    }
+    else if(auto const let_expr = llvm::dyn_cast<expr::let>(expr.data))
+    {
+      auto const old_unboxed_locals(unboxed_locals);
+      for(auto const &pair : let_expr->pairs)
+      {
+        auto const kind{ binding_number_kind(pair.first, pair.second) };
+        unboxed_locals.erase(pair.first);
+        if(kind != native_number_kind::none)
+        {
+          unboxed_local local;
+          local.kind = kind;
+          unboxed_locals.emplace(pair.first, local);
+        }
+      }
+      refine_loop_kinds(let_expr->body, loop);
+      unboxed_locals = old_unboxed_locals;
+    }
+    else if(auto const letfn_expr = llvm::dyn_cast<expr::letfn>(expr.data))
+    {
+      auto const old_unboxed_locals(unboxed_locals);
+      for(auto const &pair : letfn_expr->pairs)
+      {
+        unboxed_locals.erase(pair.first);
+      }
+      refine_loop_kinds(letfn_expr->body, loop);
+      unboxed_locals = old_unboxed_locals;
+    }
+    else if(auto const recur_expr = llvm::dyn_cast<expr::recur>(expr.data))
+    {
+      if(&local_frame::find_closest_fn_frame(*recur_expr->frame) != loop.frame.data)
+      {
+        return;
+      }
+
+      for(usize i{}; i < recur_expr->arg_exprs.size(); ++i)
+      {
+        if(loop.kinds[i] != native_number_kind::none
+           && native_number_kind_of(recur_expr->arg_exprs[i]) != loop.kinds[i])
+        {
+          loop.kinds[i] = native_number_kind::none;
+        }
+      }
+    }
+  }
+
   llvm::Value *
   llvm_processor::impl::gen(expr::primitive_literal_ref const expr, expr::function_arity const &)
   {
@@ -964,7 +2088,7 @@ namespace jank::codegen
                           /* Cons, etc. */
                           || runtime::behavior::seqable<T>)
         {
-          return gen_global_from_read_string(typed_o);
+          return gen_global_constant(typed_o);
         }
         else
         {
@@ -1094,7 +2218,9 @@ namespace jank::codegen
   llvm::Value *llvm_processor::impl::gen(expr::local_reference_ref const expr,
                                          [[maybe_unused]] expr::function_arity const &arity)
   {
-    auto ret(locals[expr->binding->name]);
+    auto const unboxed(unboxed_locals.find(expr->binding->name));
+    llvm::Value *ret{ unboxed == unboxed_locals.end() ? locals[expr->binding->name].data
+                                                      : box_local(unboxed->second) };
     jank_debug_assert_fmt(ret,
                           "Unable to find binding for local '{}' in fn '{}'",
                           expr->binding->name->to_code_string(),
@@ -1102,7 +2228,7 @@ namespace jank::codegen
 
     if(expr->position == expression_position::tail)
     {
-      if(llvm::isa<llvm::AllocaInst>(ret.data))
+      if(llvm::isa<llvm::AllocaInst>(ret))
       {
         ret = ctx->builder->CreateLoad(ctx->builder->getPtrTy(), ret);
       }
@@ -1155,6 +2281,31 @@ namespace jank::codegen
   llvm::Value *
   llvm_processor::impl::gen(expr::recur_ref const expr, expr::function_arity const &arity)
   {
+    /* Within an inline loop, we just jump back to the top with the new values. They're all
+     * generated before any phi is updated, so each one sees the old values. */
+    if(!loops.empty()
+       && &local_frame::find_closest_fn_frame(*expr->frame) == loops.back().frame.data)
+    {
+      auto const loop_index{ loops.size() - 1 };
+      native_vector<llvm::Value *> values;
+      values.reserve(expr->arg_exprs.size());
+      for(usize i{}; i < expr->arg_exprs.size(); ++i)
+      {
+        auto const kind{ loops[loop_index].kinds[i] };
+        values.emplace_back(kind == native_number_kind::none
+                              ? gen_object(expr->arg_exprs[i], arity)
+                              : gen_native_number(expr->arg_exprs[i], arity));
+      }
+
+      auto const &loop(loops[loop_index]);
+      auto const block{ ctx->builder->GetInsertBlock() };
+      for(usize i{}; i < values.size(); ++i)
+      {
+        loop.phis[i]->addIncoming(values[i], block);
+      }
+      return ctx->builder->CreateBr(loop.block);
+    }
+
     /* The codegen for the special recur form is very similar to the named recursion
      * codegen, but it's simpler. The key difference is that named recursion requires
      * arg packing, whereas the special recur form does not. This means, for variadic
@@ -1308,6 +2459,7 @@ namespace jank::codegen
   llvm_processor::impl::gen(expr::let_ref const expr, expr::function_arity const &arity)
   {
     auto old_locals(locals);
+    auto old_unboxed_locals(unboxed_locals);
     for(auto const &pair : expr->pairs)
     {
       auto const local(expr->frame->find_local_or_capture(pair.first));
@@ -1317,12 +2469,34 @@ namespace jank::codegen
                                                pair.first->to_string()) };
       }
 
-      locals[pair.first] = gen(pair.second, arity);
-      locals[pair.first]->setName(pair.first->to_string().c_str());
+      auto const kind{ binding_number_kind(pair.first, pair.second) };
+      if(kind == native_number_kind::none)
+      {
+        unboxed_locals.erase(pair.first);
+        locals[pair.first] = gen(pair.second, arity);
+        locals[pair.first]->setName(pair.first->to_string().c_str());
+        continue;
+      }
+
+      /* Literals already have a box, so we may as well use it. */
+      llvm::Value *box{};
+      if(llvm::isa<expr::primitive_literal>(pair.second.data)
+         && native_number_kind_of(pair.second) == kind)
+      {
+        box = gen(pair.second, arity);
+      }
+
+      auto const value{ gen_coerced_number(pair.second, kind, arity) };
+      if(llvm::isa<llvm::Instruction>(value))
+      {
+        value->setName(pair.first->to_string().c_str());
+      }
+      bind_unboxed_local(pair.first, kind, value, box);
     }
 
     auto const ret(gen(expr->body, arity));
     locals = std::move(old_locals);
+    unboxed_locals = std::move(old_unboxed_locals);
 
     /* XXX: No return creation, since we rely on the body to do that. */
 
@@ -1353,6 +2527,14 @@ namespace jank::codegen
     deferred_inits = {};
 
     auto old_locals(locals);
+    auto old_unboxed_locals(unboxed_locals);
+    /* These fns can refer to each other, so all of their names need to be shadowed before
+     * any of them are generated. */
+    for(auto const &pair : expr->pairs)
+    {
+      unboxed_locals.erase(pair.first);
+    }
+
     for(auto const &pair : expr->pairs)
     {
       auto const local(expr->frame->find_local_or_capture(pair.first));
@@ -1379,6 +2561,7 @@ namespace jank::codegen
 
     auto const ret(gen(expr->body, arity));
     locals = std::move(old_locals);
+    unboxed_locals = std::move(old_unboxed_locals);
     deferred_inits = std::move(old_deferred_inits);
 
     /* XXX: No return creation, since we rely on the body to do that. */
@@ -1405,18 +2588,7 @@ namespace jank::codegen
      * for us. Since LLVM basic blocks can only have one terminating instruction, we need
      * to take care to not generate our own, too. */
     auto const is_return(expr->position == expression_position::tail);
-    auto condition(gen(expr->condition, arity));
-    if(llvm::isa<llvm::AllocaInst>(condition))
-    {
-      condition = ctx->builder->CreateLoad(ctx->builder->getPtrTy(), condition);
-    }
-
-    auto const truthy_fn_type(
-      llvm::FunctionType::get(ctx->builder->getInt8Ty(), { ctx->builder->getPtrTy() }, false));
-    auto const fn(llvm_module->getOrInsertFunction("jank_truthy", truthy_fn_type));
-    llvm::SmallVector<llvm::Value *, 1> const args{ condition };
-    auto const call(ctx->builder->CreateCall(fn, args));
-    auto const cmp(ctx->builder->CreateICmpEQ(call, ctx->builder->getInt8(1), "iftmp"));
+    auto const cmp(gen_condition(expr->condition, arity));
 
     auto const current_fn(ctx->builder->GetInsertBlock()->getParent());
     auto then_block(llvm::BasicBlock::Create(*llvm_ctx, "then", current_fn));
@@ -2828,7 +4000,7 @@ namespace jank::codegen
 
         /* TODO: Can strip here, when the flag is enabled: strip_source_from_meta
          * Otherwise, we need this info for macro expansion errors. i.e. `(foo ~'bar) */
-        auto const meta(gen_global_from_read_string(s->meta.unwrap()));
+        auto const meta(gen_global_constant(s->meta.unwrap()));
         ctx->builder->CreateCall(set_meta_fn, { call, meta });
       }
 
@@ -2917,6 +4089,187 @@ namespace jank::codegen
     return ctx->builder->CreateLoad(ctx->builder->getPtrTy(), global);
   }
 
+  llvm::Value *llvm_processor::impl::gen_global_constant(object_ref const o) const
+  {
+    return runtime::visit_object(
+      [&](auto const typed_o) -> llvm::Value * {
+        using T = typename decltype(typed_o)::value_type;
+
+        if constexpr(std::same_as<T, runtime::obj::nil> || std::same_as<T, runtime::obj::boolean>
+                     || std::same_as<T, runtime::obj::integer>
+                     || std::same_as<T, runtime::obj::real> || std::same_as<T, runtime::obj::symbol>
+                     || std::same_as<T, runtime::obj::character>
+                     || std::same_as<T, runtime::obj::keyword>
+                     || std::same_as<T, runtime::obj::persistent_string>
+                     || std::same_as<T, runtime::obj::ratio>
+                     || std::same_as<T, runtime::obj::big_integer>
+                     || std::same_as<T, runtime::obj::big_decimal>
+                     || std::same_as<T, runtime::obj::uuid> || std::same_as<T, runtime::obj::inst>
+                     || std::same_as<T, runtime::obj::re_pattern>)
+        {
+          return gen_global(typed_o);
+        }
+        /* Sorted collections need their comparator, which we can't build from items alone. */
+        else if constexpr(std::same_as<T, runtime::obj::persistent_sorted_map>
+                          || std::same_as<T, runtime::obj::persistent_sorted_set>)
+        {
+          return gen_global_from_read_string(typed_o);
+        }
+        else if constexpr(std::same_as<T, runtime::obj::persistent_vector>
+                          || std::same_as<T, runtime::obj::persistent_list>
+                          || std::same_as<T, runtime::obj::persistent_hash_set>
+                          || std::same_as<T, runtime::obj::persistent_array_map>
+                          || std::same_as<T, runtime::obj::persistent_hash_map>
+                          /* Cons, etc. */
+                          || runtime::behavior::seqable<T>)
+        {
+          return gen_global_collection(typed_o);
+        }
+        else
+        {
+          return gen_global_from_read_string(typed_o);
+        }
+      },
+      o);
+  }
+
+  /* Builds a constant collection directly from the globals of its items, so loading the
+   * module doesn't need to print and re-read it. Each item is itself a constant global,
+   * which means nested collections and repeated keywords are shared within the module. */
+  llvm::Value *llvm_processor::impl::gen_global_collection(object_ref const o) const
+  {
+    auto const found(ctx->literal_globals.find(o));
+    if(found != ctx->literal_globals.end())
+    {
+      return ctx->builder->CreateLoad(ctx->builder->getPtrTy(), found->second);
+    }
+
+    auto &global(ctx->literal_globals[o]);
+    auto const name(util::format("data_{}", to_hash(o)));
+    auto const var(create_global_var(name));
+    llvm_module->insertGlobalVariable(var);
+    global = var;
+
+    auto const prev_block(ctx->builder->GetInsertBlock());
+    {
+      llvm::IRBuilder<>::InsertPointGuard const guard{ *ctx->builder };
+      ctx->builder->SetInsertPoint(ctx->global_ctor_block);
+
+      native_vector<object_ref> items;
+      jtl::option<object_ref> meta;
+      char const *create_fn_name{};
+      u64 size{};
+      runtime::visit_object(
+        [&](auto const typed_o) {
+          using T = typename decltype(typed_o)::value_type;
+
+          if constexpr(std::same_as<T, runtime::obj::persistent_array_map>
+                       || std::same_as<T, runtime::obj::persistent_hash_map>)
+          {
+            for(auto const &pair : typed_o->data)
+            {
+              items.emplace_back(pair.first);
+              items.emplace_back(pair.second);
+            }
+            size = items.size() / 2;
+            create_fn_name = "jank_const_hash_map_create";
+            if constexpr(std::same_as<T, runtime::obj::persistent_array_map>)
+            {
+              create_fn_name = "jank_const_array_map_create";
+            }
+          }
+          else if constexpr(std::same_as<T, runtime::obj::persistent_vector>
+                            || std::same_as<T, runtime::obj::persistent_list>
+                            || std::same_as<T, runtime::obj::persistent_hash_set>)
+          {
+            for(auto const &item : typed_o->data)
+            {
+              items.emplace_back(item);
+            }
+            size = items.size();
+            create_fn_name = "jank_const_set_create";
+            if constexpr(std::same_as<T, runtime::obj::persistent_vector>)
+            {
+              create_fn_name = "jank_const_vector_create";
+            }
+            else if constexpr(std::same_as<T, runtime::obj::persistent_list>)
+            {
+              create_fn_name = "jank_const_list_create";
+            }
+          }
+          /* Cons, etc. These are read back as lists, so that's what we build. */
+          else if constexpr(runtime::behavior::seqable<T>)
+          {
+            for(auto const item : runtime::make_sequence_range(typed_o))
+            {
+              items.emplace_back(item);
+            }
+            size = items.size();
+            create_fn_name = "jank_const_list_create";
+          }
+
+          if constexpr(behavior::metadatable<T>)
+          {
+            meta = typed_o->meta;
+          }
+        },
+        o);
+
+      /* Items go into an internal array rather than onto the stack, since the global ctor
+       * can build a great many of these and literal tables can be large. */
+      llvm::Value *items_ptr{ llvm::ConstantPointerNull::get(ctx->builder->getPtrTy()) };
+      if(!items.empty())
+      {
+        auto const array_type(llvm::ArrayType::get(ctx->builder->getPtrTy(), items.size()));
+        auto const items_var(
+          new llvm::GlobalVariable{ array_type,
+                                    false,
+                                    llvm::GlobalVariable::InternalLinkage,
+                                    llvm::ConstantAggregateZero::get(array_type),
+                                    util::format("{}_items", name).c_str() });
+        llvm_module->insertGlobalVariable(items_var);
+
+        for(usize i{}; i < items.size(); ++i)
+        {
+          auto const item(gen_global_constant(items[i]));
+          auto const item_ptr(
+            ctx->builder->CreateConstInBoundsGEP2_64(array_type, items_var, 0, i));
+          ctx->builder->CreateStore(item, item_ptr);
+        }
+        items_ptr = items_var;
+      }
+
+      auto const create_fn_type(
+        llvm::FunctionType::get(ctx->builder->getPtrTy(),
+                                { ctx->builder->getInt64Ty(), ctx->builder->getPtrTy() },
+                                false));
+      auto const create_fn(llvm_module->getOrInsertFunction(create_fn_name, create_fn_type));
+
+      llvm::SmallVector<llvm::Value *, 2> const args{ ctx->builder->getInt64(size), items_ptr };
+      auto const call(ctx->builder->CreateCall(create_fn, args));
+      ctx->builder->CreateStore(call, global);
+
+      if(meta.is_some())
+      {
+        auto const set_meta_fn_type(
+          llvm::FunctionType::get(ctx->builder->getVoidTy(),
+                                  { ctx->builder->getPtrTy(), ctx->builder->getPtrTy() },
+                                  false));
+        auto const set_meta_fn(llvm_module->getOrInsertFunction("jank_set_meta", set_meta_fn_type));
+
+        auto const meta_value(gen_global_constant(strip_source_from_meta(meta.unwrap())));
+        ctx->builder->CreateCall(set_meta_fn, { call, meta_value });
+      }
+
+      if(prev_block == ctx->global_ctor_block)
+      {
+        return call;
+      }
+    }
+
+    return ctx->builder->CreateLoad(ctx->builder->getPtrTy(), global);
+  }
+
   llvm::Value *llvm_processor::impl::gen_global_from_read_string(object_ref const o) const
   {
     auto const found(ctx->literal_globals.find(o));
@@ -2960,8 +4313,7 @@ namespace jank::codegen
                 llvm_module->getOrInsertFunction("jank_set_meta", set_meta_fn_type));
 
               /* TODO: This shouldn't be its own global; we don't need to reference it later. */
-              auto const meta(
-                gen_global_from_read_string(strip_source_from_meta(typed_o->meta.unwrap())));
+              auto const meta(gen_global_constant(strip_source_from_meta(typed_o->meta.unwrap())));
               auto const meta_name(util::format("{}_meta", name));
               meta->setName(meta_name.c_str());
               ctx->builder->CreateCall(set_meta_fn, { call, meta });
@@ -3047,7 +4399,7 @@ namespace jank::codegen
       {
         auto const field_ptr(ctx->builder->CreateStructGEP(closure_ctx_type, closure_obj, index++));
         auto const name(capture.first);
-        if(!locals.contains(name))
+        if(!locals.contains(name) && !unboxed_locals.contains(name))
         {
           deferred_inits.emplace_back(expr, name, capture.second, field_ptr);
         }
@@ -3110,7 +4462,7 @@ namespace jank::codegen
                                 false));
       auto const set_meta_fn(llvm_module->getOrInsertFunction("jank_set_meta", set_meta_fn_type));
 
-      auto const meta(gen_global_from_read_string(strip_source_from_meta(expr->meta)));
+      auto const meta(gen_global_constant(strip_source_from_meta(expr->meta)));
       ctx->builder->CreateCall(set_meta_fn, { fn_obj, meta });
     }
 
@@ -3189,7 +4541,7 @@ namespace jank::codegen
     }
 #endif
 
-    _impl->ctx->mpm.run(*_impl->llvm_module, *_impl->ctx->mam);
+    _impl->ctx->pipeline->run(*_impl->llvm_module);
 
     if(print_settings == "2")
     {
@@ -3197,6 +4549,13 @@ namespace jank::codegen
     }
   }
 
+  void optimize_module(llvm::Module &module, u8 const level)
+  {
+    profile::timer const timer{ "ir optimize" };
+    optimization_pipeline pipeline{ module.getContext(), level };
+    pipeline.run(module);
+  }
+
   void llvm_processor::print() const
   {
     _impl->llvm_module->print(llvm::outs(), nullptr);
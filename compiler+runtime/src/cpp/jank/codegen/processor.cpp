@@ -173,17 +173,14 @@ namespace jank::codegen
           }
           else if constexpr(std::same_as<T, runtime::obj::integer>)
           {
-            util::format_to(
-              buffer,
-              "jank::runtime::make_box<jank::runtime::obj::integer>(static_cast<jank::"
-              "i64>({}))",
-              typed_o->data);
+            util::format_to(buffer,
+                            "jank::runtime::make_box(static_cast<jank::i64>({}))",
+                            typed_o->data);
           }
           else if constexpr(std::same_as<T, runtime::obj::real>)
           {
             util::format_to(buffer,
-                            "jank::runtime::make_box<jank::runtime::obj::real>(static_cast<jank::"
-                            "f64>({}))",
+                            "jank::runtime::make_box(static_cast<jank::f64>({}))",
                             typed_o->data);
           }
           else if constexpr(std::same_as<T, runtime::obj::symbol>)
@@ -323,6 +320,21 @@ namespace jank::codegen
                               util::escape(runtime::to_code_string(typed_o->meta.unwrap())));
             }
           }
+          /* Quoted forms keep the reader's source info in their meta. */
+          else if constexpr(std::same_as<T, runtime::obj::source_info>)
+          {
+            util::format_to(buffer, "jank::runtime::make_box<jank::runtime::obj::source_info>(");
+            gen_constant(typed_o->file, buffer, true);
+            util::format_to(buffer,
+                            ", jank::read::source_position{ {}, {}, {} }"
+                            ", jank::read::source_position{ {}, {}, {} })",
+                            typed_o->start.offset,
+                            typed_o->start.line,
+                            typed_o->start.col,
+                            typed_o->end.offset,
+                            typed_o->end.line,
+                            typed_o->end.col);
+          }
           /* Cons, etc. */
           else if constexpr(runtime::behavior::seqable<T>)
           {
@@ -105,6 +105,8 @@ namespace jank::error
         return "Invalid ratio.";
       case kind::parse_invalid_keyword:
         return "Invalid keyword.";
+      case kind::parse_unsupported_edn_form:
+        return "This form is not supported in EDN.";
       case kind::internal_parse_failure:
         return "Internal parse failure.";
 
@@ -262,6 +262,12 @@ namespace jank::error
     return make_error(kind::parse_invalid_keyword, message, source);
   }
 
+  error_ref
+  parse_unsupported_edn_form(read::source const &source, jtl::immutable_string const &note)
+  {
+    return make_error(kind::parse_unsupported_edn_form, source, note);
+  }
+
   error_ref internal_parse_failure(jtl::immutable_string const &message, read::source const &source)
   {
     return make_error(kind::internal_parse_failure, message, source);
@@ -3,6 +3,7 @@
 #include <clang/Interpreter/CppInterOp.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
 
+#include <jank/c_api.h>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/ns.hpp>
 #include <jank/runtime/visit.hpp>
@@ -265,6 +266,60 @@ namespace jank::evaluate
       expr);
   }
 
+  /* Most top-level forms are evaluated once and thrown away, so JIT compiling them costs far
+   * more than it gains. We interpret any form which doesn't need native code, which is any
+   * form without fns, loops, or C++ interop. Since there are no fns, there's nothing which
+   * could capture a local, so locals can just live on a stack while their form is evaluated. */
+  static bool is_interpretable(expression_ref const expr)
+  {
+    switch(expr->kind)
+    {
+      case expression_kind::def:
+      case expression_kind::var_deref:
+      case expression_kind::var_ref:
+      case expression_kind::call:
+      case expression_kind::primitive_literal:
+      case expression_kind::list:
+      case expression_kind::vector:
+      case expression_kind::map:
+      case expression_kind::set:
+      case expression_kind::local_reference:
+      case expression_kind::let:
+      case expression_kind::do_:
+      case expression_kind::if_:
+      case expression_kind::throw_:
+      case expression_kind::try_:
+      case expression_kind::case_:
+        break;
+      default:
+        return false;
+    }
+
+    bool ret{ true };
+    expr->walk([&](expression_ref const e) { ret = ret && is_interpretable(e); });
+    return ret;
+  }
+
+  /* Locals bound by interpreted forms. Lookups search from the back, so the most recent
+   * binding of a name shadows any earlier ones. */
+  /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+  static thread_local native_vector<std::pair<obj::symbol_ref, object_ref>> interpreted_locals;
+
+  struct interpreted_scope
+  {
+    interpreted_scope()
+      : size{ interpreted_locals.size() }
+    {
+    }
+
+    ~interpreted_scope()
+    {
+      interpreted_locals.resize(size);
+    }
+
+    usize size{};
+  };
+
   object_ref eval(expression_ref const ex)
   {
     profile::timer const timer{ "eval ast node" };
@@ -572,9 +627,17 @@ namespace jank::evaluate
     }
   }
 
-  object_ref eval(expr::local_reference_ref const)
-  /* Doesn't make sense to eval these, since let is wrapped in a fn and JIT compiled. */
+  object_ref eval(expr::local_reference_ref const expr)
   {
+    for(auto it{ interpreted_locals.rbegin() }; it != interpreted_locals.rend(); ++it)
+    {
+      if(it->first->name == expr->name->name)
+      {
+        return it->second;
+      }
+    }
+
+    /* Any other locals belong to a fn, which will be JIT compiled. */
     throw make_box("unsupported eval: local_reference").erase();
   }
 
@@ -595,7 +658,14 @@ namespace jank::evaluate
       cg_prc.gen().expect_ok();
       cg_prc.optimize();
 
-      __rt_ctx->jit_prc.load_ir_module(jtl::move(cg_prc.get_module()));
+      if(util::cli::opts.tiered_compilation)
+      {
+        __rt_ctx->jit_prc.load_tiered_ir_module(jtl::move(cg_prc.get_module()));
+      }
+      else
+      {
+        __rt_ctx->jit_prc.load_ir_module(jtl::move(cg_prc.get_module()));
+      }
 
       auto const fn(
         __rt_ctx->jit_prc.find_symbol(util::format("{}_0", munge(cg_prc.get_root_fn_name())))
@@ -652,7 +722,18 @@ namespace jank::evaluate
 
   object_ref eval(expr::let_ref const expr)
   {
-    return dynamic_call(eval(wrap_expression(expr, "let", {})));
+    if(!is_interpretable(expr))
+    {
+      return dynamic_call(eval(wrap_expression(expr, "let", {})));
+    }
+
+    interpreted_scope const scope;
+    for(auto const &pair : expr->pairs)
+    {
+      auto const value(eval(pair.second));
+      interpreted_locals.emplace_back(pair.first, value);
+    }
+    return eval(expr->body);
   }
 
   object_ref eval(expr::letfn_ref const expr)
@@ -702,16 +783,37 @@ namespace jank::evaluate
     }
     catch(object_ref const e)
     {
-      return dynamic_call(eval(wrap_expression(expr->catch_body.unwrap().body,
-                                               "catch",
-                                               { expr->catch_body.unwrap().sym })),
-                          e);
+      auto const &catch_body(expr->catch_body.unwrap());
+      if(!is_interpretable(catch_body.body))
+      {
+        return dynamic_call(
+          eval(wrap_expression(catch_body.body, "catch", { catch_body.sym })),
+          e);
+      }
+
+      interpreted_scope const scope;
+      interpreted_locals.emplace_back(catch_body.sym, e);
+      return eval(catch_body.body);
     }
   }
 
   object_ref eval(expr::case_ref const expr)
   {
-    return dynamic_call(eval(wrap_expression(expr, "case", {})));
+    if(!is_interpretable(expr))
+    {
+      return dynamic_call(eval(wrap_expression(expr, "case", {})));
+    }
+
+    auto const value(eval(expr->value_expr));
+    auto const key(jank_shift_mask_case_integer(value.erase(), expr->shift, expr->mask));
+    for(usize i{}; i < expr->keys.size(); ++i)
+    {
+      if(expr->keys[i] == key)
+      {
+        return eval(expr->exprs[i]);
+      }
+    }
+    return eval(expr->default_expr);
   }
 
   object_ref eval(expr::cpp_raw_ref const expr)
@@ -1,4 +1,11 @@
 #include <cstdlib>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <gc/gc.h>
 
 #include <clang/AST/Type.h>
 #include <clang/Basic/Diagnostic.h>
@@ -15,6 +22,7 @@
 #include <llvm/ExecutionEngine/Orc/TargetProcess/JITLoaderPerf.h>
 #include <llvm/ExecutionEngine/JITEventListener.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
 
 #include <cpptrace/gdb_jit.hpp>
 
@@ -24,6 +32,7 @@
 #include <jank/util/clang.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/jit/processor.hpp>
+#include <jank/codegen/llvm_processor.hpp>
 #include <jank/profile/time.hpp>
 
 namespace jank::jit
@@ -77,7 +86,122 @@ namespace jank::jit
     }
   }
 
+  /* A function JIT compiled at -O0, waiting to get hot. We keep an unoptimized copy of
+   * its whole module, which is shared with the module's other functions. */
+  struct tiered_function
+  {
+    std::shared_ptr<llvm::orc::ThreadSafeModule> module;
+    std::string name;
+    /* The -O0 function is still defined in the JIT, so the optimized one needs a new name.
+     * This is picked when it's queued, since the tiering thread doesn't generate names. */
+    std::string optimized_name;
+    bool queued{};
+  };
+
+  struct tiered_compiler
+  {
+    ~tiered_compiler();
+
+    void start();
+    void run();
+    void recompile(void *address, tiered_function const &fn);
+
+    /* Changing the JIT, or running code within it, isn't safe to do concurrently, so every
+     * processor fn which does goes through this, on both the JIT thread and the tiering
+     * thread. It's recursive, since the code we run can load more code. */
+    std::recursive_mutex jit_mutex;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    /* Keyed by the address of each function's -O0 code. */
+    std::unordered_map<void *, tiered_function> functions;
+    std::unordered_map<void *, void *> optimized;
+    std::deque<void *> queue;
+    std::thread worker;
+    bool stopping{};
+  };
+
+  tiered_compiler::~tiered_compiler()
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      stopping = true;
+    }
+    cv.notify_one();
+    if(worker.joinable())
+    {
+      worker.join();
+    }
+  }
+
+  void tiered_compiler::start()
+  {
+    /* We go through the runtime, which allocates, while recompiling, so the GC needs to
+     * know about us. */
+    GC_allow_register_threads();
+    worker = std::thread{ [this] {
+      GC_stack_base sb{};
+      GC_get_stack_base(&sb);
+      GC_register_my_thread(&sb);
+      run();
+      GC_unregister_my_thread();
+    } };
+  }
+
+  void tiered_compiler::run()
+  {
+    while(true)
+    {
+      void *address{};
+      tiered_function fn;
+      {
+        std::unique_lock lock{ mutex };
+        cv.wait(lock, [this] { return stopping || !queue.empty(); });
+        if(stopping)
+        {
+          return;
+        }
+        address = queue.front();
+        queue.pop_front();
+        fn = functions.at(address);
+      }
+
+      recompile(address, fn);
+    }
+  }
+
+  void tiered_compiler::recompile(void * const address, tiered_function const &fn)
+  {
+    profile::timer const timer{ "jit tier up" };
+
+    /* Only the hot function is compiled again. Everything else it uses, including the
+     * globals set up by the module's initializer, is linked against the -O0 copy, so we
+     * leave out the initializer. Running it again would give us a second set of globals. */
+    auto recompiled{ llvm::orc::cloneToNewContext(
+      *fn.module,
+      [&](llvm::GlobalValue const &global) { return global.getName() == fn.name; }) };
+    auto &module{ *recompiled.getModuleUnlocked() };
+    if(auto const ctors{ module.getNamedGlobal("llvm.global_ctors") })
+    {
+      ctors->eraseFromParent();
+    }
+
+    module.getFunction(fn.name)->setName(fn.optimized_name);
+
+    codegen::optimize_module(module, util::cli::opts.optimization_level);
+    __rt_ctx->jit_prc.load_ir_module(std::move(recompiled));
+
+    /* If the function can't be found, for whatever reason, we just stick with its -O0
+     * code rather than trying again. */
+    auto const found{ __rt_ctx->jit_prc.find_symbol(fn.optimized_name.c_str()) };
+
+    std::lock_guard const lock{ mutex };
+    optimized.insert_or_assign(address, found.is_ok() ? found.expect_ok() : address);
+    functions.erase(address);
+  }
+
   processor::processor(jtl::immutable_string const &binary_version)
+    : tiering{ std::make_unique<tiered_compiler>() }
   {
     profile::timer const timer{ "jit ctor" };
 
@@ -228,6 +352,7 @@ namespace jank::jit
   {
     profile::timer const timer{ "jit eval_string" };
     //util::println("// eval_string:\n{}\n", s);
+    std::lock_guard const lock{ tiering->jit_mutex };
     auto err(interpreter->ParseAndExecute({ s.data(), s.size() }));
     /* TODO: Throw on errors. */
     llvm::logAllUnhandledErrors(std::move(err), llvm::errs(), "error: ");
@@ -245,6 +370,7 @@ namespace jank::jit
     /* XXX: Object files won't be able to use global ctors until jank is on the ORC
      * runtime, which likely won't happen until clang::Interpreter is on the ORC runtime. */
     /* TODO: Return result on failure. */
+    std::lock_guard const lock{ tiering->jit_mutex };
     llvm::cantFail(ee->addObjectFile(std::move(file.get())));
     register_jit_stack_frames();
   }
@@ -257,12 +383,88 @@ namespace jank::jit
       jtl::immutable_string_view{ module_name.data(), module_name.size() }) };
     //m->print(llvm::outs(), nullptr);
 
+    std::lock_guard const lock{ tiering->jit_mutex };
     auto const ee(interpreter->getExecutionEngine());
     llvm::cantFail(ee->addIRModule(jtl::move(m)));
     llvm::cantFail(ee->initialize(ee->getMainJITDylib()));
     register_jit_stack_frames();
   }
 
+  void processor::load_tiered_ir_module(llvm::orc::ThreadSafeModule &&m) const
+  {
+    auto &module{ *m.getModuleUnlocked() };
+    std::vector<std::string> names;
+    for(auto const &fn : module)
+    {
+      if(!fn.isDeclaration() && !fn.hasLocalLinkage())
+      {
+        names.emplace_back(fn.getName().str());
+      }
+    }
+
+    /* Recompiled functions are linked against this module's globals, rather than getting
+     * their own, so those need to be visible outside of it. Their names are only unique
+     * within the module, though. */
+    auto const suffix{ __rt_ctx->unique_munged_string("_tiered") };
+    for(auto &global : module.global_values())
+    {
+      if(!global.isDeclaration() && global.hasLocalLinkage())
+      {
+        global.setName(global.getName().str() + suffix.c_str());
+        global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+      }
+    }
+
+    auto const unoptimized{ std::make_shared<llvm::orc::ThreadSafeModule>(
+      llvm::orc::cloneToNewContext(m)) };
+    load_ir_module(jtl::move(m));
+
+    std::vector<std::pair<void *, tiered_function>> loaded;
+    for(auto const &name : names)
+    {
+      auto const found{ find_symbol(name.c_str()) };
+      if(found.is_ok())
+      {
+        loaded.emplace_back(found.expect_ok(), tiered_function{ unoptimized, name });
+      }
+    }
+
+    std::lock_guard const lock{ tiering->mutex };
+    for(auto &fn : loaded)
+    {
+      tiering->functions.emplace(fn.first, std::move(fn.second));
+    }
+  }
+
+  jtl::option<void *> processor::tier_up(void * const fn) const
+  {
+    std::lock_guard const lock{ tiering->mutex };
+    if(auto const found{ tiering->optimized.find(fn) }; found != tiering->optimized.end())
+    {
+      return found->second;
+    }
+
+    auto const found{ tiering->functions.find(fn) };
+    if(found == tiering->functions.end())
+    {
+      return fn;
+    }
+
+    if(!found->second.queued)
+    {
+      found->second.queued = true;
+      found->second.optimized_name
+        = found->second.name + __rt_ctx->unique_munged_string("_tier_up").c_str();
+      if(!tiering->worker.joinable())
+      {
+        tiering->start();
+      }
+      tiering->queue.emplace_back(fn);
+      tiering->cv.notify_one();
+    }
+    return none;
+  }
+
   void processor::load_bitcode(jtl::immutable_string const &module,
                                jtl::immutable_string_view const &bitcode) const
   {
@@ -284,6 +486,7 @@ namespace jank::jit
 
   jtl::string_result<void> processor::remove_symbol(jtl::immutable_string const &name) const
   {
+    std::lock_guard const lock{ tiering->jit_mutex };
     auto const ee{ interpreter->getExecutionEngine() };
     llvm::orc::SymbolNameSet to_remove{};
     to_remove.insert(ee->mangleAndIntern(name.c_str()));
@@ -298,6 +501,8 @@ namespace jank::jit
 
   jtl::string_result<void *> processor::find_symbol(jtl::immutable_string const &name) const
   {
+    /* Looking up a symbol can materialize it, which changes the JIT. */
+    std::lock_guard const lock{ tiering->jit_mutex };
     if(auto symbol{ interpreter->getSymbolAddress(name.c_str()) })
     {
       return symbol.get().toPtr<void *>();
@@ -358,6 +563,7 @@ namespace jank::jit
 
   void processor::load_dynamic_library(jtl::immutable_string const &path) const
   {
+    std::lock_guard const lock{ tiering->jit_mutex };
     llvm::cantFail(static_cast<clang::Interpreter &>(*interpreter).LoadDynamicLibrary(path.data()));
   }
 }
@@ -1,4 +1,5 @@
 #include <fstream>
+#include <mutex>
 
 #include <jank/profile/time.hpp>
 #include <jank/util/fmt/print.hpp>
@@ -11,6 +12,9 @@ namespace jank::profile
   static constexpr jtl::immutable_string_view tag{ "jank::profile" };
   // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
   static std::ofstream output;
+  /* Timers may run on any thread, such as when modules are written in parallel. */
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+  static std::mutex output_mutex;
 
   static auto now()
   {
@@ -42,7 +46,9 @@ namespace jank::profile
   {
     if(opts.profiler_enabled)
     {
-      output << util::format("{} {} enter {}\n", tag, now(), region);
+      auto const line{ util::format("{} {} enter {}\n", tag, now(), region) };
+      std::lock_guard<std::mutex> const lock{ output_mutex };
+      output << line;
     }
   }
 
@@ -50,7 +56,9 @@ namespace jank::profile
   {
     if(opts.profiler_enabled)
     {
-      output << util::format("{} {} exit {}\n", tag, now(), region);
+      auto const line{ util::format("{} {} exit {}\n", tag, now(), region) };
+      std::lock_guard<std::mutex> const lock{ output_mutex };
+      output << line;
     }
   }
 
@@ -58,7 +66,9 @@ namespace jank::profile
   {
     if(opts.profiler_enabled)
     {
-      output << util::format("{} {} report {}\n", tag, now(), boundary);
+      auto const line{ util::format("{} {} report {}\n", tag, now(), boundary) };
+      std::lock_guard<std::mutex> const lock{ output_mutex };
+      output << line;
     }
   }
 
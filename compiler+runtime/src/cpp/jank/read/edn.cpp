@@ -0,0 +1,637 @@
+#include <limits>
+
+#include <jank/read/edn.hpp>
+#include <jank/read/parse.hpp>
+#include <jank/error/parse.hpp>
+#include <jank/util/escape.hpp>
+#include <jank/util/fmt.hpp>
+#include <jank/runtime/visit.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/behavior/callable.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/symbol.hpp>
+#include <jank/runtime/obj/ratio.hpp>
+
+namespace jank::read::edn
+{
+  using namespace jank::runtime;
+
+  processor::processor(jtl::immutable_string_view const &data)
+    : lexer{ data }
+  {
+  }
+
+  processor::processor(jtl::immutable_string_view const &data, options const &opts)
+    : lexer{ data }
+    , opts{ opts }
+  {
+  }
+
+  processor::object_result processor::next()
+  {
+    return next(none);
+  }
+
+  /* Reads the next form, skipping over comments and #_ forms. None is returned when we
+   * reach the expected closer or the end of the input. Callers within a collection can tell
+   * the two apart by checking the latest token. */
+  processor::object_result processor::next(jtl::option<lex::token_kind> const closer)
+  {
+    while(true)
+    {
+      auto const token_result(lexer.next());
+      if(token_result.is_err())
+      {
+        return token_result.expect_err();
+      }
+      latest_token = token_result.expect_ok();
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+      switch(latest_token.kind)
+      {
+        case lex::token_kind::comment:
+          continue;
+        case lex::token_kind::reader_macro_comment:
+          {
+            auto const start_token(latest_token);
+            auto const ignored_result(next(none));
+            if(ignored_result.is_err())
+            {
+              return ignored_result;
+            }
+            else if(ignored_result.expect_ok().is_none())
+            {
+              return error::parse_invalid_reader_comment({ start_token.start, latest_token.end },
+                                                         "Value after #_ must be present.");
+            }
+            continue;
+          }
+        case lex::token_kind::eof:
+          return ok(none);
+        case lex::token_kind::close_paren:
+        case lex::token_kind::close_square_bracket:
+        case lex::token_kind::close_curly_bracket:
+          if(closer != latest_token.kind)
+          {
+            return error::parse_unexpected_closing_character(latest_token);
+          }
+          return ok(none);
+        default:
+          return read_form();
+      }
+#pragma clang diagnostic pop
+    }
+  }
+
+  processor::object_result processor::read_form()
+  {
+    auto const &token(latest_token);
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(token.kind)
+    {
+      case lex::token_kind::open_paren:
+        return read_list();
+      case lex::token_kind::open_square_bracket:
+        return read_vector();
+      case lex::token_kind::open_curly_bracket:
+        return read_map(none);
+      case lex::token_kind::reader_macro:
+        return read_dispatch();
+      case lex::token_kind::character:
+        return read_character();
+      case lex::token_kind::nil:
+        return jank_nil;
+      case lex::token_kind::boolean:
+        return make_box(std::get<bool>(token.data));
+      case lex::token_kind::symbol:
+        return read_symbol();
+      case lex::token_kind::keyword:
+        return read_keyword();
+      case lex::token_kind::integer:
+        return make_box<obj::integer>(std::get<i64>(token.data));
+      case lex::token_kind::real:
+        return make_box<obj::real>(std::get<f64>(token.data));
+      case lex::token_kind::ratio:
+        return read_ratio();
+      case lex::token_kind::big_integer:
+        {
+          auto const &[number_literal, radix, is_negative](std::get<lex::big_integer>(token.data));
+          return obj::big_integer::create(number_literal, radix, is_negative);
+        }
+      case lex::token_kind::big_decimal:
+        return obj::big_decimal::create(std::get<lex::big_decimal>(token.data).number_literal);
+      case lex::token_kind::string:
+        {
+          auto const sv(std::get<jtl::immutable_string_view>(token.data));
+          return make_string({ sv.data(), sv.size() });
+        }
+      case lex::token_kind::escaped_string:
+        {
+          auto const sv(std::get<jtl::immutable_string_view>(token.data));
+          auto res(util::unescape({ sv.data(), sv.size() }));
+          if(res.is_err())
+          {
+            return error::internal_parse_failure(res.expect_err().message,
+                                                 { token.start, token.end });
+          }
+          return make_string(res.expect_ok_move());
+        }
+      case lex::token_kind::single_quote:
+      case lex::token_kind::meta_hint:
+      case lex::token_kind::syntax_quote:
+      case lex::token_kind::unquote:
+      case lex::token_kind::unquote_splice:
+      case lex::token_kind::deref:
+      case lex::token_kind::reader_macro_conditional:
+      case lex::token_kind::reader_macro_conditional_splice:
+        return error::parse_unsupported_edn_form(
+          { token.start, token.end },
+          "Quoting, meta hints, derefs, and reader conditionals are only supported in code.");
+      default:
+        return error::internal_parse_failure("Unexpected token.", { token.start, token.end });
+    }
+#pragma clang diagnostic pop
+  }
+
+  processor::object_result processor::read_list()
+  {
+    auto const start_token(latest_token);
+    native_vector<object_ref> items;
+    while(true)
+    {
+      auto item(next(some(lex::token_kind::close_paren)));
+      if(item.is_err())
+      {
+        return item;
+      }
+      else if(item.expect_ok().is_none())
+      {
+        break;
+      }
+      items.push_back(item.expect_ok().unwrap());
+    }
+    if(latest_token.kind == lex::token_kind::eof)
+    {
+      return error::parse_unterminated_list({ start_token.start, latest_token.end });
+    }
+
+    return make_box<obj::persistent_list>(std::in_place, items.rbegin(), items.rend());
+  }
+
+  processor::object_result processor::read_vector()
+  {
+    auto const start_token(latest_token);
+    runtime::detail::native_transient_vector ret;
+    while(true)
+    {
+      auto item(next(some(lex::token_kind::close_square_bracket)));
+      if(item.is_err())
+      {
+        return item;
+      }
+      else if(item.expect_ok().is_none())
+      {
+        break;
+      }
+      ret.push_back(item.expect_ok().unwrap());
+    }
+    if(latest_token.kind == lex::token_kind::eof)
+    {
+      return error::parse_unterminated_vector(start_token.start);
+    }
+
+    return make_box<obj::persistent_vector>(ret.persistent());
+  }
+
+  /* We don't know how many entries a map has until we reach its end, so we start with an
+   * array map and switch over to a transient hash map once it's too big. */
+  /* Puts an unqualified keyword or symbol key into the ns of a #:ns{} map. As in Clojure,
+   * the _ ns is used to keep a key unqualified. Any other key is left alone. */
+  static jtl::result<object_ref, error_ref>
+  qualify_map_key(object_ref const key, jtl::immutable_string const &ns, lex::token const &token)
+  {
+    if(key->type == object_type::keyword)
+    {
+      auto const kw(expect_object<obj::keyword>(key));
+      jtl::immutable_string qualified_ns;
+      if(kw->sym->ns.empty())
+      {
+        qualified_ns = ns;
+      }
+      else if(kw->sym->ns != "_")
+      {
+        return key;
+      }
+
+      auto const intern_res(__rt_ctx->intern_keyword(qualified_ns, kw->sym->name, true));
+      if(intern_res.is_err())
+      {
+        return error::parse_invalid_keyword(intern_res.expect_err(), { token.start, token.end });
+      }
+      return intern_res.expect_ok();
+    }
+    else if(key->type == object_type::symbol)
+    {
+      auto const sym(expect_object<obj::symbol>(key));
+      if(sym->ns.empty())
+      {
+        return make_box<obj::symbol>(ns, sym->name);
+      }
+      else if(sym->ns == "_")
+      {
+        return make_box<obj::symbol>("", sym->name);
+      }
+    }
+    return key;
+  }
+
+  processor::object_result processor::read_map(jtl::option<jtl::immutable_string> const &ns)
+  {
+    auto const start_token(latest_token);
+    runtime::detail::native_array_map array_map;
+    runtime::detail::native_transient_hash_map hash_map;
+    bool use_hash_map{};
+    while(true)
+    {
+      auto key_result(next(some(lex::token_kind::close_curly_bracket)));
+      if(key_result.is_err())
+      {
+        return key_result;
+      }
+      else if(key_result.expect_ok().is_none())
+      {
+        break;
+      }
+      auto key(key_result.expect_ok().unwrap());
+      auto const key_token(latest_token);
+      if(ns.is_some())
+      {
+        auto const qualified(qualify_map_key(key, ns.unwrap(), key_token));
+        if(qualified.is_err())
+        {
+          return qualified.expect_err();
+        }
+        key = qualified.expect_ok();
+      }
+
+      auto value_result(next(some(lex::token_kind::close_curly_bracket)));
+      if(value_result.is_err())
+      {
+        return value_result;
+      }
+      else if(value_result.expect_ok().is_none())
+      {
+        if(latest_token.kind == lex::token_kind::eof)
+        {
+          break;
+        }
+        return error::parse_odd_entries_in_map({ start_token.start, latest_token.end },
+                                               { key_token.start, key_token.end });
+      }
+      auto const value(value_result.expect_ok().unwrap());
+
+      if(use_hash_map ? hash_map.find(key) != nullptr : array_map.find(key).is_some())
+      {
+        return error::parse_duplicate_keys_in_map(
+          { key_token.start, key_token.end },
+          { "Map starts here.", start_token.start, error::note::kind::info });
+      }
+
+      if(use_hash_map)
+      {
+        hash_map.set(key, value);
+      }
+      else if(array_map.size() < runtime::detail::native_array_map::max_size)
+      {
+        array_map.insert_unique(key, value);
+      }
+      else
+      {
+        for(auto const &entry : array_map)
+        {
+          hash_map.set(entry.first, entry.second);
+        }
+        hash_map.set(key, value);
+        use_hash_map = true;
+      }
+    }
+    if(latest_token.kind == lex::token_kind::eof)
+    {
+      return error::parse_unterminated_map(start_token.start);
+    }
+
+    if(use_hash_map)
+    {
+      return make_box<obj::persistent_hash_map>(hash_map.persistent());
+    }
+    return make_box<obj::persistent_array_map>(std::move(array_map));
+  }
+
+  processor::object_result processor::read_set()
+  {
+    auto const start_token(latest_token);
+    runtime::detail::native_transient_hash_set ret;
+    while(true)
+    {
+      auto item_result(next(some(lex::token_kind::close_curly_bracket)));
+      if(item_result.is_err())
+      {
+        return item_result;
+      }
+      else if(item_result.expect_ok().is_none())
+      {
+        break;
+      }
+
+      auto const size(ret.size());
+      ret.insert(item_result.expect_ok().unwrap());
+      if(ret.size() == size)
+      {
+        return error::parse_duplicate_items_in_set(
+          { latest_token.start, latest_token.end },
+          { "Set starts here.", start_token.start, error::note::kind::info });
+      }
+    }
+    if(latest_token.kind == lex::token_kind::eof)
+    {
+      return error::parse_unterminated_set({ start_token.start, latest_token.end });
+    }
+
+    return make_box<obj::persistent_hash_set>(std::move(ret).persistent());
+  }
+
+  processor::object_result processor::read_dispatch()
+  {
+    auto const start_token(latest_token);
+    auto const token_result(lexer.next());
+    if(token_result.is_err())
+    {
+      return token_result.expect_err();
+    }
+    latest_token = token_result.expect_ok();
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(latest_token.kind)
+    {
+      case lex::token_kind::open_curly_bracket:
+        return read_set();
+      case lex::token_kind::reader_macro:
+        return read_symbolic_value(start_token);
+      case lex::token_kind::symbol:
+        return read_tagged(start_token);
+      case lex::token_kind::keyword:
+        return read_namespaced_map(start_token);
+      case lex::token_kind::open_paren:
+      case lex::token_kind::single_quote:
+      case lex::token_kind::string:
+      case lex::token_kind::escaped_string:
+        return error::parse_unsupported_edn_form(
+          { start_token.start, latest_token.end },
+          "Anonymous fns, var quotes, and regexes are only supported in code.");
+      default:
+        return error::parse_unsupported_reader_macro({ start_token.start, latest_token.end });
+    }
+#pragma clang diagnostic pop
+  }
+
+  processor::object_result processor::read_namespaced_map(lex::token const &start_token)
+  {
+    auto const sv(std::get<jtl::immutable_string_view>(latest_token.data));
+    if(sv[0] == ':')
+    {
+      return error::parse_unsupported_edn_form(
+        { start_token.start, latest_token.end },
+        "Auto-resolved namespaced maps are only supported in code.");
+    }
+    else if(sv.find('/') != jtl::immutable_string::npos)
+    {
+      return error::parse_unsupported_edn_form({ start_token.start, latest_token.end },
+                                               "The ns of a namespaced map can't be qualified.");
+    }
+    jtl::immutable_string const ns{ sv.data(), sv.size() };
+
+    auto const token_result(lexer.next());
+    if(token_result.is_err())
+    {
+      return token_result.expect_err();
+    }
+    latest_token = token_result.expect_ok();
+    if(latest_token.kind != lex::token_kind::open_curly_bracket)
+    {
+      return error::parse_unsupported_edn_form({ start_token.start, latest_token.end },
+                                               "A namespaced map must be followed by a map.");
+    }
+    return read_map(some(ns));
+  }
+
+  processor::object_result processor::read_tagged(lex::token const &start_token)
+  {
+    auto const tag_result(read_symbol());
+    if(tag_result.is_err())
+    {
+      return tag_result;
+    }
+    auto const tag(tag_result.expect_ok().unwrap());
+
+    auto const value_result(next(none));
+    if(value_result.is_err())
+    {
+      return value_result;
+    }
+    else if(value_result.expect_ok().is_none())
+    {
+      return error::parse_invalid_reader_tag_value(
+        util::format("The form after this '#{}' is missing.", runtime::to_string(tag)),
+        { start_token.start, latest_token.end });
+    }
+    auto const value(value_result.expect_ok().unwrap());
+
+    if(auto const reader(get(opts.readers, tag)); !reader.is_nil())
+    {
+      return dynamic_call(reader, value);
+    }
+
+    auto const sym(expect_object<obj::symbol>(tag));
+    if(sym->ns.empty() && (sym->name == "inst" || sym->name == "uuid"))
+    {
+      if(value->type != object_type::persistent_string)
+      {
+        return error::parse_invalid_reader_tag_value(
+          util::format("The form after '#{}' must be a string literal.", sym->name),
+          { start_token.start, latest_token.end });
+      }
+
+      auto const str(expect_object<obj::persistent_string>(value));
+      try
+      {
+        if(sym->name == "inst")
+        {
+          return make_box<obj::inst>(str->data);
+        }
+        return make_box<obj::uuid>(str->data);
+      }
+      catch(jank::runtime::object * const e)
+      {
+        auto const message(try_object<obj::persistent_string>(e)->data);
+        if(sym->name == "inst")
+        {
+          return error::parse_invalid_inst(message, { start_token.start, latest_token.end });
+        }
+        return error::parse_invalid_uuid(message, { start_token.start, latest_token.end });
+      }
+    }
+
+    if(!opts.default_reader.is_nil())
+    {
+      return dynamic_call(opts.default_reader, tag, value);
+    }
+
+    return error::parse_invalid_reader_tag_value(
+      util::format("No reader function for tag '{}'.", sym->to_string()),
+      { start_token.start, latest_token.end });
+  }
+
+  processor::object_result processor::read_symbolic_value(lex::token const &start_token)
+  {
+    auto const token_result(lexer.next());
+    if(token_result.is_err())
+    {
+      return token_result.expect_err();
+    }
+    latest_token = token_result.expect_ok();
+
+    if(latest_token.kind != lex::token_kind::symbol)
+    {
+      return error::parse_invalid_reader_symbolic_value("Value after ## must be a symbol.",
+                                                        { start_token.start, latest_token.end });
+    }
+
+    auto const sv(std::get<jtl::immutable_string_view>(latest_token.data));
+    if(sv == "Inf")
+    {
+      return make_box<obj::real>(std::numeric_limits<f64>::infinity());
+    }
+    else if(sv == "-Inf")
+    {
+      return make_box<obj::real>(-std::numeric_limits<f64>::infinity());
+    }
+    else if(sv == "NaN")
+    {
+      return make_box<obj::real>(std::numeric_limits<f64>::quiet_NaN());
+    }
+
+    return error::parse_invalid_reader_symbolic_value("Invalid symbolic value.",
+                                                      { start_token.start, latest_token.end });
+  }
+
+  processor::object_result processor::read_character()
+  {
+    auto const &token(latest_token);
+    auto const sv(std::get<jtl::immutable_string_view>(token.data));
+    auto const character(parse::get_char_from_literal(sv));
+
+    if(character.is_none())
+    {
+      /* Hexadecimal unicode */
+      if(sv[0] == '\\' && (sv[1] == 'u' || sv[1] == 'o'))
+      {
+        auto const base{ (sv[1] == 'u' ? 16 : 8) };
+        auto const char_bytes(parse::parse_character_in_base(sv.substr(2), base));
+
+        if(char_bytes.is_err())
+        {
+          return error::parse_invalid_unicode({ token.start, token.end },
+                                              char_bytes.expect_err().error);
+        }
+
+        return make_box<obj::character>(char_bytes.expect_ok());
+      }
+
+      return error::parse_invalid_character(token);
+    }
+
+    return make_box<obj::character>(character.unwrap());
+  }
+
+  /* Unlike the code reader, the ns of a symbol is taken as is. There's no current ns for
+   * data, so nothing is resolved. */
+  processor::object_result processor::read_symbol()
+  {
+    auto const sv(std::get<jtl::immutable_string_view>(latest_token.data));
+    auto const slash(sv.find('/'));
+    /* If it's only a slash, it's a name. Otherwise, it's a ns/name separator. */
+    if(slash == jtl::immutable_string::npos || sv.size() == 1)
+    {
+      return make_box<obj::symbol>(jtl::immutable_string{ sv });
+    }
+
+    return make_box<obj::symbol>(jtl::immutable_string{ sv.substr(0, slash) },
+                                 jtl::immutable_string{ sv.substr(slash + 1) });
+  }
+
+  processor::object_result processor::read_keyword()
+  {
+    auto const &token(latest_token);
+    auto const sv(std::get<jtl::immutable_string_view>(token.data));
+    if(sv[0] == ':')
+    {
+      return error::parse_unsupported_edn_form(
+        { token.start, token.end },
+        "Auto-resolved keywords are only supported in code, since there's no current ns.");
+    }
+
+    /* Keywords are interned by the runtime context, so repeated keywords are always
+     * deduplicated. */
+    auto const slash(sv.find('/'));
+    jtl::immutable_string ns, name;
+    if(slash != jtl::immutable_string::npos)
+    {
+      ns = sv.substr(0, slash);
+      name = sv.substr(slash + 1);
+    }
+    else
+    {
+      name = sv;
+    }
+
+    auto const intern_res(__rt_ctx->intern_keyword(ns, name, true));
+    if(intern_res.is_err())
+    {
+      return error::parse_invalid_keyword(intern_res.expect_err(), { token.start, token.end });
+    }
+    return intern_res.expect_ok();
+  }
+
+  processor::object_result processor::read_ratio()
+  {
+    auto const &token(latest_token);
+    auto const &ratio_data(std::get<lex::ratio>(token.data));
+    if(ratio_data.denominator == 0)
+    {
+      return error::parse_invalid_ratio({ token.start, token.end },
+                                        "A ratio may not have a denominator of zero.");
+    }
+    return obj::ratio::create(ratio_data.numerator, ratio_data.denominator);
+  }
+
+  object_ref processor::make_string(jtl::immutable_string &&s)
+  {
+    if(!opts.dedupe_strings)
+    {
+      return make_box<obj::persistent_string>(std::move(s));
+    }
+
+    if(auto const found(strings.find(s)); found != strings.end())
+    {
+      return found->second;
+    }
+    auto const ret(make_box<obj::persistent_string>(s));
+    strings.emplace(std::move(s), ret);
+    return ret;
+  }
+}
@@ -1,5 +1,7 @@
 #include <iostream>
 #include <iomanip>
+#include <array>
+#include <cstring>
 
 #include <jank/read/lex.hpp>
 #include <jank/error/lex.hpp>
@@ -362,10 +364,27 @@ namespace jank::read::lex
 
   movable_position &movable_position::operator+=(usize const count)
   {
-    for(usize i{}; i < count; ++i)
+    jank_debug_assert(offset + count <= proc->file.size());
+
+    /* Bulk skips, like string bodies and comments, only need to care about the newlines,
+     * which memchr can find much faster than we can step through them. */
+    auto it{ proc->file.data() + offset };
+    auto const end{ it + count };
+    while(it != end)
     {
-      ++(*this);
+      auto const remaining{ static_cast<usize>(end - it) };
+      auto const newline{ static_cast<char const *>(std::memchr(it, '\n', remaining)) };
+      if(!newline)
+      {
+        col += remaining;
+        break;
+      }
+      ++line;
+      col = 1;
+      it = newline + 1;
     }
+
+    offset += count;
     return *this;
   }
 
@@ -382,10 +401,7 @@ namespace jank::read::lex
   movable_position movable_position::operator+(usize const count) const
   {
     movable_position ret{ *this };
-    for(usize i{}; i < count; ++i)
-    {
-      ++ret;
-    }
+    ret += count;
     return ret;
   }
 
@@ -440,9 +456,21 @@ namespace jank::read::lex
     return none;
   }
 
+  /* The vast majority of source is ASCII, which doesn't need to go through the locale's
+   * multibyte decoding at all. NUL is left to mbrtowc, to keep its odd zero length. */
+  static bool is_ascii(char const c)
+  {
+    return static_cast<unsigned char>(c) - 1u < 0x7Fu;
+  }
+
   static jtl::result<codepoint, error_ref>
   convert_to_codepoint(jtl::immutable_string_view const sv, movable_position const &pos)
   {
+    if(!sv.empty() && is_ascii(sv[0]))
+    {
+      return ok(codepoint{ static_cast<char32_t>(sv[0]), 1 });
+    }
+
     std::mbstate_t state{};
     wchar_t wc{};
     auto const len{ std::mbrtowc(&wc, sv.data(), sv.size(), &state) };
@@ -481,7 +509,7 @@ namespace jank::read::lex
     return false;
   }
 
-  static bool is_special_char(char32_t const c)
+  static constexpr bool is_special_char(char32_t const c)
   {
     return c == '(' || c == ')' || c == '{' || c == '}' || c == '[' || c == ']' || c == '"'
       || c == '^' || c == '\\' || c == '`' || c == '~' || c == ',' || c == ';';
@@ -495,6 +523,69 @@ namespace jank::read::lex
           || c == '>' || c == '#' || c == '%' || is_utf8_char(c));
   }
 
+  /* For printable ASCII, every character is a symbol character unless it's a space or
+   * special. This mirrors is_symbol_char, but without any of the wide character
+   * classification. Control characters are left to is_symbol_char, since the locale
+   * decides which of them are whitespace. */
+  static constexpr auto ascii_symbol_chars{ [] {
+    std::array<bool, 128> ret{};
+    for(char32_t c{ '!' }; c < 0x7F; ++c)
+    {
+      ret[c] = !is_special_char(c);
+    }
+    return ret;
+  }() };
+
+  /* Returns how many bytes, starting at the offset, form a run of ASCII symbol characters. */
+  static usize ascii_symbol_run(jtl::immutable_string_view const file, usize const offset)
+  {
+    usize i{ offset };
+    while(i < file.size() && is_ascii(file[i])
+          && ascii_symbol_chars[static_cast<unsigned char>(file[i])])
+    {
+      ++i;
+    }
+    return i - offset;
+  }
+
+  /* Finds the first byte, at or after the offset, which is either a stop byte or not ASCII.
+   * This works on eight bytes at a time, using the usual SWAR zero byte trick, and then
+   * narrows down within the word once something is found. Returns the file size if
+   * nothing is found. */
+  static usize
+  find_ascii_stop(jtl::immutable_string_view const file, usize offset, char const a, char const b)
+  {
+    static constexpr u64 ones{ 0x0101010101010101ull };
+    static constexpr u64 highs{ 0x8080808080808080ull };
+    auto const has_zero_byte([](u64 const w) { return (w - ones) & ~w & highs; });
+    auto const a_word{ ones * static_cast<unsigned char>(a) };
+    auto const b_word{ ones * static_cast<unsigned char>(b) };
+
+    while(offset + sizeof(u64) <= file.size())
+    {
+      u64 word{};
+      std::memcpy(&word, file.data() + offset, sizeof(word));
+      if((has_zero_byte(word ^ a_word) | has_zero_byte(word ^ b_word) | has_zero_byte(word)
+          | (word & highs))
+         != 0)
+      {
+        break;
+      }
+      offset += sizeof(u64);
+    }
+
+    while(offset < file.size())
+    {
+      auto const c{ file[offset] };
+      if(c == a || c == b || !is_ascii(c))
+      {
+        break;
+      }
+      ++offset;
+    }
+    return offset;
+  }
+
   static bool is_lower_letter(char32_t const c)
   {
     return c >= 'a' && c <= 'z';
@@ -546,7 +637,8 @@ namespace jank::read::lex
         return ok(token{ pos, token_kind::eof });
       }
 
-      if(auto const c(file[pos.offset]); std::isspace(c) == 0 && c != ',')
+      if(auto const c(file[pos.offset]);
+         std::isspace(static_cast<unsigned char>(c)) == 0 && c != ',')
       {
         break;
       }
@@ -624,6 +716,13 @@ namespace jank::read::lex
           bool hit_non_semi{};
           while(true)
           {
+            /* Once past the leading semicolons, the ASCII body of the comment can be skipped in
+             * bulk. We still step through anything else one codepoint at a time. */
+            if(hit_non_semi)
+            {
+              pos += find_ascii_stop(file, pos.offset + 1, '\n', '\n') - pos.offset - 1;
+            }
+
             auto const oc(peek());
             if(oc.is_err())
             {
@@ -1147,6 +1246,8 @@ namespace jank::read::lex
           }
           while(true)
           {
+            pos += ascii_symbol_run(file, pos.offset + 1);
+
             auto const oc(peek());
             if(oc.is_err())
             {
@@ -1223,6 +1324,8 @@ namespace jank::read::lex
           }
           while(true)
           {
+            pos += ascii_symbol_run(file, pos.offset + 1);
+
             auto const oc(peek());
             if(oc.is_err())
             {
@@ -1265,6 +1368,13 @@ namespace jank::read::lex
           bool escaped{}, contains_escape{};
           while(true)
           {
+            /* Plain ASCII can be skipped in bulk. Quotes, escapes and anything which needs
+             * decoding still go through the codepoint by codepoint path below. */
+            if(!escaped)
+            {
+              pos += find_ascii_stop(file, pos.offset + 1, '"', '\\') - pos.offset - 1;
+            }
+
             auto const oc(peek());
             if(oc.is_err())
             {
@@ -1443,6 +1553,12 @@ namespace jank::read::lex
           pos += oc.expect_ok().len;
           while(pos <= file.size())
           {
+            pos += ascii_symbol_run(file, pos.offset);
+            if(pos.offset >= file.size())
+            {
+              break;
+            }
+
             auto const result(convert_to_codepoint(file.substr(pos), pos));
             if(result.is_err())
             {
@@ -1469,12 +1585,19 @@ namespace jank::read::lex
 
   jtl::result<codepoint, error_ref> processor::peek(usize const ahead) const
   {
-    auto const peek_pos{ pos + ahead };
-    if(peek_pos >= file.size())
+    auto const peek_offset{ pos.offset + ahead };
+    if(peek_offset >= file.size())
     {
       return error::lex_unexpected_eof(pos);
     }
-    auto const oc{ convert_to_codepoint(file.substr(peek_pos), peek_pos) };
+
+    /* Avoid building the position, which needs to scan for newlines, unless we need it for
+     * an error. */
+    if(is_ascii(file[peek_offset]))
+    {
+      return ok(codepoint{ static_cast<char32_t>(file[peek_offset]), 1 });
+    }
+    auto const oc{ convert_to_codepoint(file.substr(peek_offset), pos + ahead) };
     return oc;
   }
 }
@@ -0,0 +1,93 @@
+#include <jank/runtime/call_site.hpp>
+#include <jank/runtime/obj/jit_function.hpp>
+#include <jank/runtime/obj/jit_closure.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/jit/processor.hpp>
+
+namespace jank::runtime
+{
+  /* The callee is never null, so this always misses. */
+  static call_site::entry const empty_entry{};
+
+  static_assert(offsetof(call_site::entry, callee) == 0);
+  static_assert(offsetof(call_site::entry, fn) == sizeof(void *));
+
+  call_site::call_site()
+    : cached{ &empty_entry }
+  {
+  }
+
+  call_site *call_site::create()
+  {
+    return new(NoGC) call_site{};
+  }
+
+  template <typename T>
+  static void *direct_arity(T &fn, u8 const arity)
+  {
+    /* Tiering up swaps out the arity fns and relies on each call being counted. */
+    if(arity < fn.calls_until_tier_up.size()
+       && std::atomic_ref<u32>{ fn.calls_until_tier_up[arity] }.load(std::memory_order_relaxed)
+         != 0)
+    {
+      return nullptr;
+    }
+
+    /* If the variadic arity would take this call, the args need to be packed up. If the
+     * variadic arity is ambiguous with the fixed arity of the same size, the fixed one
+     * wins, which is what we want. */
+    auto const arity_flags{ fn.get_arity_flags() };
+    auto const mask{ behavior::callable::extract_variadic_arity_mask(arity_flags) };
+    for(u8 i{}; i <= arity; ++i)
+    {
+      if(mask == behavior::callable::mask_variadic_arity(i)
+         && (i < arity || !behavior::callable::is_variadic_ambiguous(arity_flags)))
+      {
+        return nullptr;
+      }
+    }
+
+    switch(arity)
+    {
+      case 0:
+        return reinterpret_cast<void *>(jit::load_arity(fn.arity_0));
+      case 1:
+        return reinterpret_cast<void *>(jit::load_arity(fn.arity_1));
+      case 2:
+        return reinterpret_cast<void *>(jit::load_arity(fn.arity_2));
+      case 3:
+        return reinterpret_cast<void *>(jit::load_arity(fn.arity_3));
+      case 4:
+        return reinterpret_cast<void *>(jit::load_arity(fn.arity_4));
+      default:
+        return nullptr;
+    }
+  }
+
+  void call_site::update(object_ref const callee, u8 const arity)
+  {
+    if(max_misses <= misses.fetch_add(1, std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    void *fn{};
+    if(auto const typed{ dyn_cast<obj::jit_function>(callee) }; typed.is_some())
+    {
+      fn = direct_arity(*typed, arity);
+    }
+    else if(auto const typed{ dyn_cast<obj::jit_closure>(callee) }; typed.is_some())
+    {
+      fn = direct_arity(*typed, arity);
+    }
+
+    /* A missing arity is left to dynamic_call, which will throw. */
+    if(fn)
+    {
+      auto const e{ new entry{} };
+      e->callee = callee.data;
+      e->fn = fn;
+      cached.store(e, std::memory_order_release);
+    }
+  }
+}
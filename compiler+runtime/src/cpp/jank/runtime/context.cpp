@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <exception>
+#include <fstream>
 
 #include <Interpreter/Compatibility.h>
 #include <clang/Interpreter/CppInterOp.h>
@@ -16,6 +18,7 @@
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/munge.hpp>
 #include <jank/runtime/core/meta.hpp>
+#include <jank/runtime/thread_pool.hpp>
 #include <jank/analyze/processor.hpp>
 #include <jank/analyze/expr/primitive_literal.hpp>
 #include <jank/analyze/pass/optimize.hpp>
@@ -34,7 +37,7 @@
 namespace jank::runtime
 {
   /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
-  thread_local decltype(context::thread_binding_frames) context::thread_binding_frames{};
+  thread_local thread_binding_stack context::thread_bindings{};
 
   /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
   context *__rt_ctx{};
@@ -95,7 +98,7 @@ namespace jank::runtime
 
   context::~context()
   {
-    thread_binding_frames.erase(this);
+    thread_bindings = {};
   }
 
   obj::symbol_ref context::qualify_symbol(obj::symbol_ref const &sym) const
@@ -114,15 +117,10 @@ namespace jank::runtime
     profile::timer const timer{ "rt find_var" };
     if(!sym->ns.empty())
     {
-      ns_ref ns{};
+      auto const ns(namespaces.find(make_box<obj::symbol>("", sym->ns)));
+      if(ns.is_nil())
       {
-        auto const locked_namespaces(namespaces.rlock());
-        auto const found(locked_namespaces->find(make_box<obj::symbol>("", sym->ns)));
-        if(found == locked_namespaces->end())
-        {
-          return {};
-        }
-        ns = found->second;
+        return {};
       }
 
       return ns->find_var(make_box<obj::symbol>("", sym->name));
@@ -202,10 +200,9 @@ namespace jank::runtime
 
       if(util::cli::opts.codegen == util::cli::codegen_type::llvm_ir)
       {
-        codegen::llvm_processor const cg_prc{ fn, module, codegen::compilation_target::module };
+        codegen::llvm_processor cg_prc{ fn, module, codegen::compilation_target::module };
         cg_prc.gen().expect_ok();
-        cg_prc.optimize();
-        write_module(cg_prc.get_module_name(), cg_prc.get_module().getModuleUnlocked()).expect_ok();
+        write_module_async(std::move(cg_prc));
       }
       else
       {
@@ -312,20 +309,42 @@ namespace jank::runtime
     return ret;
   }
 
-  jtl::result<void, jtl::immutable_string>
-  context::load_module(jtl::immutable_string_view const &module, module::origin const ori)
+  static jtl::immutable_string
+  absolute_module_name(ns_ref const ns, jtl::immutable_string_view const &module)
   {
-    auto const ns(current_ns());
-
-    jtl::immutable_string absolute_module;
     if(module.starts_with('/'))
     {
-      absolute_module = module.substr(1);
+      return module.substr(1);
     }
-    else
+    return module::nest_module(ns->to_string(), module);
+  }
+
+  void context::record_module_dependency(jtl::immutable_string_view const &module)
+  {
+    if(!current_module_var->is_bound())
+    {
+      return;
+    }
+
+    auto const parent{ runtime::to_string(current_module_var->deref()) };
+    auto const absolute_module{ absolute_module_name(current_ns(), module) };
+    auto &deps{ module_dependencies[parent] };
+    if(parent != absolute_module && std::ranges::find(deps, absolute_module) == deps.end())
     {
-      absolute_module = module::nest_module(ns->to_string(), module);
+      deps.emplace_back(absolute_module);
     }
+  }
+
+  jtl::result<void, jtl::immutable_string>
+  context::load_module(jtl::immutable_string_view const &module, module::origin const ori)
+  {
+    auto const ns(current_ns());
+    auto const absolute_module{ absolute_module_name(ns, module) };
+
+    /* We track which modules each module loads, so its cache manifest can cover all of its
+     * dependencies. The module's own dependencies are recorded again as it loads. */
+    record_module_dependency(module);
+    module_dependencies.erase(absolute_module);
 
     /* When we load a module, the `*ns*` var is still set to the previous module.
      * In the `clojure.core/ns` macro, `in-ns` is called that sets the value of the
@@ -353,12 +372,19 @@ namespace jank::runtime
   jtl::result<void, jtl::immutable_string>
   context::compile_module(jtl::immutable_string_view const &module)
   {
-    module_dependencies.clear();
-
     binding_scope const preserve{ obj::persistent_hash_map::create_unique(
       std::make_pair(compile_files_var, jank_true)) };
 
-    return load_module(util::format("/{}", module), module::origin::latest);
+    auto const res{ load_module(util::format("/{}", module), module::origin::latest) };
+
+    /* Even if loading failed, some modules may still be in flight and we can't leave
+     * them writing while we return. */
+    auto const write_res{ wait_for_module_writes() };
+    if(res.is_err())
+    {
+      return res;
+    }
+    return write_res;
   }
 
   object_ref context::eval(object_ref const o)
@@ -370,6 +396,13 @@ namespace jank::runtime
 
   jtl::string_result<void> context::write_module(jtl::immutable_string const &module_name,
                                                  jtl::ref<llvm::Module> const &module) const
+  {
+    return write_module(module_name, module_loader.cache_manifest(module_name), module);
+  }
+
+  jtl::string_result<void> context::write_module(jtl::immutable_string const &module_name,
+                                                 jtl::immutable_string const &manifest,
+                                                 jtl::ref<llvm::Module> const &module) const
   {
     profile::timer const timer{ util::format("write_module {}", module_name) };
     std::filesystem::path const module_path{
@@ -416,9 +449,87 @@ namespace jank::runtime
 
     pass.run(*module);
 
+    /* An object file written to a specific path is not one the module loader will find, so
+     * it doesn't need a manifest. */
+    if(util::cli::opts.output_object_filename.empty())
+    {
+      auto const manifest_path{ module::object_to_manifest_path(module_path.c_str()) };
+      std::ofstream manifest_file{ manifest_path.c_str() };
+      manifest_file << manifest;
+      if(!manifest_file)
+      {
+        return err(util::format("failed to write module manifest {}", manifest_path));
+      }
+    }
+
     return ok();
   }
 
+  struct write_module_task : task
+  {
+    write_module_task(codegen::llvm_processor &&cg_prc, jtl::immutable_string const &manifest)
+      : cg_prc{ std::move(cg_prc) }
+      , manifest{ manifest }
+    {
+    }
+
+    void run() override
+    {
+      /* Someone is waiting for this count to reach zero, so it must always go down. */
+      util::scope_exit const done{ [] { --__rt_ctx->pending_module_writes; } };
+
+      /* Anything thrown here would be lost in the pool, so it becomes an error instead. */
+      try
+      {
+        cg_prc.optimize();
+        auto const res{ __rt_ctx->write_module(cg_prc.get_module_name(),
+                                               manifest,
+                                               cg_prc.get_module().getModuleUnlocked()) };
+        if(res.is_err())
+        {
+          __rt_ctx->module_write_errors.wlock()->emplace_back(res.expect_err());
+        }
+      }
+      catch(std::exception const &e)
+      {
+        __rt_ctx->module_write_errors.wlock()->emplace_back(e.what());
+      }
+      catch(object_ref const e)
+      {
+        __rt_ctx->module_write_errors.wlock()->emplace_back(runtime::to_code_string(e));
+      }
+      catch(...)
+      {
+        __rt_ctx->module_write_errors.wlock()->emplace_back(
+          util::format("Unknown error while writing module {}", cg_prc.get_module_name()));
+      }
+    }
+
+    codegen::llvm_processor cg_prc;
+    jtl::immutable_string manifest;
+  };
+
+  void context::write_module_async(codegen::llvm_processor &&cg_prc)
+  {
+    auto const manifest{ module_loader.cache_manifest(cg_prc.get_module_name()) };
+    ++pending_module_writes;
+    thread_pool::shared().submit(new write_module_task{ std::move(cg_prc), manifest });
+  }
+
+  jtl::string_result<void> context::wait_for_module_writes()
+  {
+    thread_pool::shared().help_until([this] { return pending_module_writes.load() == 0; });
+
+    auto const locked_errors{ module_write_errors.wlock() };
+    if(locked_errors->empty())
+    {
+      return ok();
+    }
+    auto const error{ locked_errors->front() };
+    locked_errors->clear();
+    return err(error);
+  }
+
   jtl::immutable_string context::unique_namespaced_string() const
   {
     return unique_namespaced_string("G_");
@@ -468,39 +579,17 @@ namespace jank::runtime
       throw std::runtime_error{ util::format("Can't intern ns. Sym is qualified: {}",
                                              sym->to_string()) };
     }
-    auto locked_namespaces(namespaces.wlock());
-    auto const found(locked_namespaces->find(sym));
-    if(found != locked_namespaces->end())
-    {
-      return found->second;
-    }
-
-    auto const result(locked_namespaces->emplace(sym, make_box<ns>(sym)));
-    return result.first->second;
+    return namespaces.find_or_insert(sym, [&] { return make_box<ns>(sym); });
   }
 
   ns_ref context::remove_ns(obj::symbol_ref const &sym)
   {
-    auto locked_namespaces(namespaces.wlock());
-    auto const found(locked_namespaces->find(sym));
-    if(found != locked_namespaces->end())
-    {
-      auto const ret(found->second);
-      locked_namespaces->erase(found);
-      return ret;
-    }
-    return {};
+    return namespaces.erase(sym);
   }
 
   ns_ref context::find_ns(obj::symbol_ref const &sym)
   {
-    auto locked_namespaces(namespaces.rlock());
-    auto const found(locked_namespaces->find(sym));
-    if(found != locked_namespaces->end())
-    {
-      return found->second;
-    }
-    return {};
+    return namespaces.find(sym);
   }
 
   ns_ref context::resolve_ns(obj::symbol_ref const &target)
@@ -536,14 +625,13 @@ namespace jank::runtime
         util::format("Can't intern var. Sym isn't qualified: {}", qualified_sym->to_string()));
     }
 
-    auto locked_namespaces(namespaces.wlock());
-    auto const found_ns(locked_namespaces->find(make_box<obj::symbol>(qualified_sym->ns)));
-    if(found_ns == locked_namespaces->end())
+    auto const found_ns(namespaces.find(make_box<obj::symbol>(qualified_sym->ns)));
+    if(found_ns.is_nil())
     {
       return err(util::format("Can't intern var. Namespace doesn't exist: {}", qualified_sym->ns));
     }
 
-    return ok(found_ns->second->intern_var(qualified_sym));
+    return ok(found_ns->intern_var(qualified_sym));
   }
 
   jtl::result<obj::keyword_ref, jtl::immutable_string>
@@ -578,16 +666,9 @@ namespace jank::runtime
   {
     profile::timer const timer{ "rt intern_keyword" };
 
-    auto locked_keywords(keywords.wlock());
-    auto const found(locked_keywords->find(s));
-    if(found != locked_keywords->end())
-    {
-      return found->second;
-    }
-
-    auto const res(
-      locked_keywords->emplace(s, make_box<obj::keyword>(detail::must_be_interned{}, s)));
-    return res.first->second;
+    return keywords.find_or_insert(
+      s,
+      [&] { return make_box<obj::keyword>(detail::must_be_interned{}, s); });
   }
 
   object_ref context::macroexpand1(object_ref const o)
@@ -676,21 +757,29 @@ namespace jank::runtime
     }
   }
 
+  /* Shadows every current binding with a fresh binding of the same value. Any `set!` done
+   * within this frame is then undone when the frame is popped. */
   jtl::string_result<void> context::push_thread_bindings()
   {
-    auto bindings(obj::persistent_hash_map::empty());
-    auto &tbfs(thread_binding_frames[this]);
-    if(!tbfs.empty())
-    {
-      bindings = tbfs.front().bindings;
-    }
-    /* Nothing to preserve, if there are no current bindings. */
-    else
+    auto &tbs(thread_bindings);
+    auto const thread_id(std::this_thread::get_id());
+
+    thread_binding_frame frame;
+    for(usize slot{}; slot < tbs.slots.size(); ++slot)
     {
-      return ok();
+      auto &current(tbs.slots[slot]);
+      if(current.binding.is_nil())
+      {
+        continue;
+      }
+
+      auto const binding(make_box<var_thread_binding>(current.binding->value, thread_id));
+      frame.entries.push_back({ slot, current.binding });
+      current.binding = binding;
     }
 
-    return push_thread_bindings(bindings);
+    tbs.frames.push_back(std::move(frame));
+    return ok();
   }
 
   jtl::string_result<void> context::push_thread_bindings(object_ref const bindings)
@@ -707,78 +796,86 @@ namespace jank::runtime
   jtl::string_result<void>
   context::push_thread_bindings(obj::persistent_hash_map_ref const bindings)
   {
-    thread_binding_frame frame{ obj::persistent_hash_map::empty() };
-    auto &tbfs(thread_binding_frames[this]);
-    if(!tbfs.empty())
-    {
-      frame.bindings = tbfs.front().bindings;
-    }
-
+    auto &tbs(thread_bindings);
     auto const thread_id(std::this_thread::get_id());
 
+    /* We build up the whole frame before touching any slots, so an invalid binding
+     * leaves the current bindings untouched. */
+    thread_binding_frame frame;
+    frame.entries.reserve(bindings->count());
     for(auto it(bindings->fresh_seq()); it.is_some(); it = it->next_in_place())
     {
       auto const entry(it->first());
-      auto const var(expect_object<var>(entry->data[0]));
+      auto const var(expect_object<runtime::var>(entry->data[0]));
       if(!var->dynamic.load())
       {
         return err(
           util::format("Can't dynamically bind non-dynamic var: {}", var->to_code_string()));
       }
 
-      /* XXX: Once this is set to true, here, it's never unset. */
-      var->thread_bound.store(true);
-
       /* The binding may already be a thread binding if we're just pushing the previous
        * bindings again to give a scratch pad for some upcoming code. */
-      if(entry->data[1]->type == object_type::var_thread_binding)
+      auto value(entry->data[1]);
+      if(value->type == object_type::var_thread_binding)
       {
-        frame.bindings = frame.bindings->assoc(
-          var,
-          make_box<var_thread_binding>(expect_object<var_thread_binding>(entry->data[1])->value,
-                                       thread_id));
+        value = expect_object<var_thread_binding>(value)->value;
       }
-      else
+
+      auto const slot(var->get_binding_slot());
+      if(tbs.slots.size() <= slot)
       {
-        frame.bindings
-          = frame.bindings->assoc(var, make_box<var_thread_binding>(entry->data[1], thread_id));
+        tbs.slots.resize(slot + 1);
       }
+      tbs.slots[slot].var = var;
+      frame.entries.push_back({ slot, make_box<var_thread_binding>(value, thread_id) });
+
+      /* XXX: Once this is set to true, here, it's never unset. */
+      var->thread_bound.store(true);
     }
 
-    tbfs.push_front(std::move(frame));
+    /* Now the frame's entries hold the new bindings. We swap them into the slots, which
+     * leaves the entries holding the shadowed bindings, ready for the pop. */
+    for(auto &entry : frame.entries)
+    {
+      std::swap(tbs.slots[entry.slot].binding, entry.binding);
+    }
+
+    tbs.frames.push_back(std::move(frame));
     return ok();
   }
 
   jtl::string_result<void> context::pop_thread_bindings()
   {
-    auto &tbfs(thread_binding_frames[this]);
-    if(tbfs.empty())
+    auto &tbs(thread_bindings);
+    if(tbs.frames.empty())
     {
       return err("Mismatched thread binding pop");
     }
 
-    tbfs.pop_front();
+    auto const &frame(tbs.frames.back());
+    for(auto const &entry : frame.entries)
+    {
+      tbs.slots[entry.slot].binding = entry.binding;
+    }
+    tbs.frames.pop_back();
 
     return ok();
   }
 
+  /* Since frames only store what they've changed, building the full map of bindings
+   * requires a walk over all of the slots. This is only needed when conveying bindings
+   * elsewhere, so it's kept off of the deref path. */
   obj::persistent_hash_map_ref context::get_thread_bindings() const
   {
-    auto const &tbfs(thread_binding_frames[this]);
-    if(tbfs.empty())
+    auto const &tbs(thread_bindings);
+    auto ret(obj::persistent_hash_map::empty());
+    for(auto const &slot : tbs.slots)
     {
-      return obj::persistent_hash_map::empty();
-    }
-    return tbfs.front().bindings;
-  }
-
-  jtl::option<thread_binding_frame> context::current_thread_binding_frame()
-  {
-    auto &tbfs(thread_binding_frames[this]);
-    if(tbfs.empty())
-    {
-      return none;
+      if(slot.binding.is_some())
+      {
+        ret = ret->assoc(slot.var, slot.binding);
+      }
     }
-    return tbfs.front();
+    return ret;
   }
 }
@@ -2,9 +2,11 @@
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/behavior/nameable.hpp>
 #include <jank/runtime/behavior/derefable.hpp>
+#include <jank/runtime/behavior/pending.hpp>
 #include <jank/runtime/behavior/ref_like.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/sequence_range.hpp>
+#include <jank/runtime/thread_pool.hpp>
 #include <jank/util/fmt.hpp>
 
 namespace jank::runtime
@@ -472,6 +474,45 @@ namespace jank::runtime
       o);
   }
 
+  object_ref blocking_deref(object_ref const o,
+                            object_ref const timeout_ms,
+                            object_ref const timeout_val)
+  {
+    return visit_object(
+      [=](auto const typed_o) -> object_ref {
+        using T = typename decltype(typed_o)::value_type;
+
+        if constexpr(behavior::blocking_derefable<T>)
+        {
+          return typed_o->deref(timeout_ms, timeout_val);
+        }
+        else
+        {
+          throw std::runtime_error{ util::format("not a blocking deref: {}",
+                                                 typed_o->to_string()) };
+        }
+      },
+      o);
+  }
+
+  bool is_realized(object_ref const o)
+  {
+    return visit_object(
+      [=](auto const typed_o) -> bool {
+        using T = typename decltype(typed_o)::value_type;
+
+        if constexpr(behavior::pending<T>)
+        {
+          return typed_o->is_realized();
+        }
+        else
+        {
+          throw std::runtime_error{ util::format("not pending: {}", typed_o->to_string()) };
+        }
+      },
+      o);
+  }
+
   object_ref volatile_(object_ref const o)
   {
     return make_box<obj::volatile_>(o);
@@ -523,6 +564,153 @@ namespace jank::runtime
     return o;
   }
 
+  object_ref future_call(object_ref const fn)
+  {
+    return obj::future::submit(fn);
+  }
+
+  bool is_future(object_ref const o)
+  {
+    return o->type == object_type::future;
+  }
+
+  bool is_future_done(object_ref const o)
+  {
+    return try_object<obj::future>(o)->is_done();
+  }
+
+  bool future_cancel(object_ref const o)
+  {
+    return try_object<obj::future>(o)->cancel();
+  }
+
+  bool is_future_cancelled(object_ref const o)
+  {
+    return try_object<obj::future>(o)->is_cancelled();
+  }
+
+  object_ref promise()
+  {
+    return make_box<obj::promise>();
+  }
+
+  object_ref deliver(object_ref const promise, object_ref const val)
+  {
+    if(try_object<obj::promise>(promise)->deliver(val))
+    {
+      return promise;
+    }
+    return jank_nil;
+  }
+
+  i64 available_processors()
+  {
+    return static_cast<i64>(thread_pool::shared().size());
+  }
+
+  object_ref agent(object_ref const state)
+  {
+    return make_box<obj::agent>(state);
+  }
+
+  static object_ref send_action(object_ref const agent,
+                                obj::agent::executor_kind const kind,
+                                object_ref const fn,
+                                object_ref const args,
+                                object_ref const executor,
+                                object_ref const thunk)
+  {
+    auto const action{ new obj::agent::action{} };
+    action->fn = fn;
+    action->args = args;
+    action->bindings = __rt_ctx->get_thread_bindings();
+    action->kind = kind;
+    action->executor = executor;
+    action->thunk = thunk;
+    try_object<obj::agent>(agent)->dispatch(action);
+    return agent;
+  }
+
+  object_ref agent_send(object_ref const agent, object_ref const fn, object_ref const args)
+  {
+    return send_action(agent, obj::agent::executor_kind::pooled, fn, args, jank_nil, jank_nil);
+  }
+
+  object_ref agent_send_off(object_ref const agent, object_ref const fn, object_ref const args)
+  {
+    return send_action(agent, obj::agent::executor_kind::solo, fn, args, jank_nil, jank_nil);
+  }
+
+  object_ref agent_send_via(object_ref const executor,
+                            object_ref const agent,
+                            object_ref const fn,
+                            object_ref const args,
+                            object_ref const thunk)
+  {
+    return send_action(agent, obj::agent::executor_kind::custom, fn, args, executor, thunk);
+  }
+
+  object_ref agent_run_next(object_ref const agent)
+  {
+    try_object<obj::agent>(agent)->run_next();
+    return jank_nil;
+  }
+
+  object_ref agent_error(object_ref const agent)
+  {
+    return try_object<obj::agent>(agent)->get_error();
+  }
+
+  object_ref
+  restart_agent(object_ref const agent, object_ref const new_state, object_ref const clear_actions)
+  {
+    return try_object<obj::agent>(agent)->restart(new_state, truthy(clear_actions));
+  }
+
+  object_ref set_agent_error_handler(object_ref const agent, object_ref const fn)
+  {
+    try_object<obj::agent>(agent)->set_error_handler(fn);
+    return agent;
+  }
+
+  object_ref agent_error_handler(object_ref const agent)
+  {
+    return try_object<obj::agent>(agent)->get_error_handler();
+  }
+
+  object_ref set_agent_error_mode(object_ref const agent, object_ref const mode)
+  {
+    try_object<obj::agent>(agent)->set_error_mode(mode);
+    return agent;
+  }
+
+  object_ref agent_error_mode(object_ref const agent)
+  {
+    return try_object<obj::agent>(agent)->get_error_mode();
+  }
+
+  object_ref set_agent_validator(object_ref const agent, object_ref const fn)
+  {
+    try_object<obj::agent>(agent)->set_validator(fn);
+    return agent;
+  }
+
+  i64 agent_queue_count(object_ref const agent)
+  {
+    return static_cast<i64>(try_object<obj::agent>(agent)->queue_count());
+  }
+
+  i64 release_pending_sends()
+  {
+    return static_cast<i64>(obj::agent::release_pending_sends());
+  }
+
+  object_ref shutdown_agents()
+  {
+    obj::agent::shutdown();
+    return jank_nil;
+  }
+
   object_ref tagged_literal(object_ref const tag, object_ref const form)
   {
     return make_box<obj::tagged_literal>(tag, form);
@@ -544,48 +732,47 @@ namespace jank::runtime
                                      try_object<obj::persistent_string>(s)->data);
   }
 
-  object_ref smatch_to_vector(std::smatch const &match_results)
+  object_ref match_groups(jtl::immutable_string const &s, util::regex::match const &m)
   {
-    auto const size(match_results.size());
-    switch(size)
-    {
-      case 0:
+    auto const group([&](usize const i) -> object_ref {
+      if(!m.matched(i))
+      {
         return jank_nil;
-      case 1:
-        {
-          return make_box<obj::persistent_string>(match_results[0].str());
-        }
-      default:
-        {
-          native_vector<object_ref> vec;
-          vec.reserve(size);
+      }
+      return make_box<obj::persistent_string>(s.substr(m.start(i), m.end(i) - m.start(i)));
+    });
 
-          for(auto const s : match_results)
-          {
-            vec.emplace_back(make_box<obj::persistent_string>(s.str()));
-          }
+    auto const size(m.offsets.size() / 2);
+    if(size == 1)
+    {
+      return group(0);
+    }
 
-          return make_box<obj::persistent_vector>(
-            runtime::detail::native_persistent_vector{ vec.begin(), vec.end() });
-        }
+    native_vector<object_ref> vec;
+    vec.reserve(size);
+    for(usize i{}; i < size; ++i)
+    {
+      vec.emplace_back(group(i));
     }
+
+    return make_box<obj::persistent_vector>(
+      runtime::detail::native_persistent_vector{ vec.begin(), vec.end() });
   }
 
   object_ref re_find(object_ref const m)
   {
-    std::smatch match_results{};
     auto const matcher(try_object<obj::re_matcher>(m));
-    std::regex_search(matcher->match_input, match_results, matcher->re->regex);
-
-    // Copy out the match result substrings before mutating the source
-    // match_input string below.
-    matcher->groups = smatch_to_vector(match_results);
-
-    if(!match_results.empty())
+    auto const &input(matcher->match_input);
+    auto const found(matcher->re->regex.search(input, matcher->position));
+    if(found.is_none())
     {
-      matcher->match_input = match_results.suffix().str();
+      matcher->position = input.size() + 1;
+      matcher->groups = jank_nil;
+      return jank_nil;
     }
 
+    matcher->position = util::regex::resume_from(input, found.unwrap());
+    matcher->groups = match_groups(input, found.unwrap());
     return matcher->groups;
   }
 
@@ -603,20 +790,14 @@ namespace jank::runtime
 
   object_ref re_matches(object_ref const re, object_ref const s)
   {
-    std::smatch match_results{};
-    std::string const search_str{ try_object<obj::persistent_string>(s)->data.c_str() };
-
-    std::regex_search(search_str,
-                      match_results,
-                      try_object<obj::re_pattern>(re)->regex,
-                      std::regex_constants::match_continuous);
-
-    if(!match_results.suffix().str().empty())
+    auto const &input(try_object<obj::persistent_string>(s)->data);
+    auto const found(try_object<obj::re_pattern>(re)->regex.full_match(input));
+    if(found.is_none())
     {
       return jank_nil;
     }
 
-    return smatch_to_vector(match_results);
+    return match_groups(input, found.unwrap());
   }
 
   object_ref parse_uuid(object_ref const o)
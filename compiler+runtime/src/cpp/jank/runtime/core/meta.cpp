@@ -5,6 +5,7 @@
 #include <jank/runtime/core/make_box.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/behavior/metadatable.hpp>
+#include <jank/runtime/rtti.hpp>
 #include <jank/util/fmt.hpp>
 
 namespace jank::runtime
@@ -32,6 +33,26 @@ namespace jank::runtime
       m);
   }
 
+  /* The reader packs each form's source into a source_info, which only supports lookups.
+   * Meta which is handed to jank code could be used as any other map, so it gets a real
+   * map instead. */
+  object_ref materialized_meta(object_ref const o)
+  {
+    auto const m(meta(o));
+    if(m.is_nil())
+    {
+      return m;
+    }
+
+    auto const kw{ __rt_ctx->intern_keyword("jank/source").expect_ok() };
+    auto const source(get(m, kw));
+    if(source->type != object_type::source_info)
+    {
+      return m;
+    }
+    return assoc(m, kw, expect_object<obj::source_info>(source)->to_map());
+  }
+
   object_ref with_meta(object_ref const o, object_ref const m)
   {
     return visit_object(
@@ -109,6 +130,21 @@ namespace jank::runtime
       return read::source::unknown;
     }
 
+    auto const macro_expansion(
+      get(meta, __rt_ctx->intern_keyword("jank/macro-expansion").expect_ok()));
+
+    /* Anything the reader produced will still have its packed source info, so we can skip
+     * all of the map lookups. */
+    if(source->type == object_type::source_info)
+    {
+      auto const info(expect_object<obj::source_info>(source));
+      if(info->file == jank_nil)
+      {
+        return read::source::unknown;
+      }
+      return { to_string(info->file), info->start, info->end, macro_expansion };
+    }
+
     auto const file(get(source, __rt_ctx->intern_keyword("file").expect_ok()));
     if(file == jank_nil)
     {
@@ -126,9 +162,6 @@ namespace jank::runtime
     auto const end_line(get(end, __rt_ctx->intern_keyword("line").expect_ok()));
     auto const end_col(get(end, __rt_ctx->intern_keyword("col").expect_ok()));
 
-    auto const macro_expansion(
-      get(meta, __rt_ctx->intern_keyword("jank/macro-expansion").expect_ok()));
-
     return {
       to_string(file),
       { static_cast<size_t>(to_int(start_offset)),
@@ -162,28 +195,8 @@ namespace jank::runtime
                                               read::source_position const &end)
   {
     auto const file{ runtime::__rt_ctx->current_file_var->deref() };
-
-    auto const source{ obj::persistent_array_map::empty()->to_transient() };
-    source->assoc_in_place(__rt_ctx->intern_keyword("file").expect_ok(), file);
-
-    auto const start_map{ obj::persistent_array_map::create_unique(
-      __rt_ctx->intern_keyword("offset").expect_ok(),
-      make_box(start.offset),
-      __rt_ctx->intern_keyword("line").expect_ok(),
-      make_box(start.line),
-      __rt_ctx->intern_keyword("col").expect_ok(),
-      make_box(start.col)) };
-    auto const end_map{ obj::persistent_array_map::create_unique(
-      __rt_ctx->intern_keyword("offset").expect_ok(),
-      make_box(end.offset),
-      __rt_ctx->intern_keyword("line").expect_ok(),
-      make_box(end.line),
-      __rt_ctx->intern_keyword("col").expect_ok(),
-      make_box(end.col)) };
-    source->assoc_in_place(__rt_ctx->intern_keyword("start").expect_ok(), start_map);
-    source->assoc_in_place(__rt_ctx->intern_keyword("end").expect_ok(), end_map);
-
-    return obj::persistent_hash_map::create_unique(std::make_pair(key, source->to_persistent()));
+    return obj::persistent_hash_map::create_unique(
+      std::make_pair(key, make_box<obj::source_info>(file, start, end)));
   }
 
   object_ref strip_source_from_meta(object_ref const meta)
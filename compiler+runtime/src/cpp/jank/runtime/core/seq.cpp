@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <random>
 
+#include <immer/algorithm.hpp>
+
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/behavior/associatively_readable.hpp>
 #include <jank/runtime/behavior/associatively_writable.hpp>
@@ -15,10 +17,12 @@
 #include <jank/runtime/behavior/indexable.hpp>
 #include <jank/runtime/behavior/stackable.hpp>
 #include <jank/runtime/behavior/chunkable.hpp>
+#include <jank/runtime/behavior/reducible.hpp>
 #include <jank/runtime/behavior/metadatable.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/equal.hpp>
 #include <jank/runtime/sequence_range.hpp>
+#include <jank/runtime/thread_pool.hpp>
 #include <jank/util/fmt/print.hpp>
 
 namespace jank::runtime
@@ -1069,23 +1073,255 @@ namespace jank::runtime
   {
     return visit_seqable(
       [](auto const typed_coll, object_ref const f, object_ref const init) -> object_ref {
-        object_ref res{ init };
-        for(auto const e : make_sequence_range(typed_coll))
+        using T = typename decltype(typed_coll)::value_type;
+
+        if constexpr(behavior::reducible<T>)
         {
-          res = dynamic_call(f, res, e);
-          if(res->type == object_type::reduced)
+          return typed_coll->reduce(f, init);
+        }
+        else
+        {
+          object_ref res{ init };
+          for(auto const e : make_sequence_range(typed_coll))
           {
-            res = expect_object<obj::reduced>(res)->val;
-            break;
+            if(!reduce_step(res, f, e))
+            {
+              break;
+            }
           }
+          return res;
         }
-        return res;
       },
       s,
       f,
       init);
   }
 
+  bool reduce_step(object_ref &acc, object_ref const f, object_ref const e)
+  {
+    acc = dynamic_call(f, acc, e);
+    if(acc->type == object_type::reduced)
+    {
+      acc = expect_object<obj::reduced>(acc)->val;
+      return false;
+    }
+    return true;
+  }
+
+  struct fold_job
+  {
+    usize n{};
+    object_ref combinef;
+    /* Reduces the elements in [start, end) onto the given accumulator. */
+    std::function<object_ref(object_ref, usize, usize)> reduce_range;
+  };
+
+  /* Exceptions are caught and held so that each half of a fold is always joined before
+   * anything is thrown. jank exceptions are kept where the GC can see them. */
+  struct fold_result
+  {
+    template <typename F>
+    void capture(F const &f)
+    {
+      try
+      {
+        val = f();
+      }
+      catch(object_ref const e)
+      {
+        error = e;
+      }
+      catch(...)
+      {
+        native_error = std::current_exception();
+      }
+    }
+
+    object_ref get() const
+    {
+      if(error.is_some())
+      {
+        throw error;
+      }
+      if(native_error)
+      {
+        std::rethrow_exception(native_error);
+      }
+      return val;
+    }
+
+    object_ref val{};
+    object_ref error{};
+    std::exception_ptr native_error;
+  };
+
+  static object_ref fold_range(fold_job const &job, usize start, usize end);
+
+  /* The left half of a split, which is queued so another worker can steal it. Whoever
+   * claims it first runs it, so if nobody has taken it by the time the right half is done,
+   * the forking thread just runs it itself. */
+  struct fold_task : task
+  {
+    fold_task(fold_job const &job, usize const start, usize const end)
+      : job{ &job }
+      , start{ start }
+      , end{ end }
+    {
+    }
+
+    void run() override
+    {
+      if(!claimed.exchange(true))
+      {
+        compute();
+      }
+    }
+
+    void compute()
+    {
+      result.capture([this] { return fold_range(*job, start, end); });
+      done.store(true);
+    }
+
+    /* This lives on the stack of the thread which started the fold, which won't return
+     * until every task has been joined. */
+    fold_job const *job{};
+    usize start{};
+    usize end{};
+    fold_result result;
+    std::atomic_bool claimed{};
+    std::atomic_bool done{};
+  };
+
+  static object_ref fold_range(fold_job const &job, usize const start, usize const end)
+  {
+    if(end - start <= job.n)
+    {
+      return job.reduce_range(dynamic_call(job.combinef), start, end);
+    }
+
+    auto &pool{ thread_pool::shared() };
+    auto const mid{ start + (end - start) / 2 };
+    auto const left{ new fold_task{ job, start, mid } };
+    pool.submit(left);
+
+    fold_result right;
+    right.capture([&] { return fold_range(job, mid, end); });
+
+    if(!left->claimed.exchange(true))
+    {
+      left->compute();
+    }
+    else
+    {
+      pool.help_until([left] { return left->done.load(); });
+    }
+
+    auto const left_val{ left->result.get() };
+    return dynamic_call(job.combinef, left_val, right.get());
+  }
+
+  object_ref
+  fold(object_ref const n, object_ref const combinef, object_ref const reducef, object_ref const coll)
+  {
+    fold_job job{ static_cast<usize>(std::max<i64>(to_int(n), 1)), combinef, {} };
+
+    /* Maps are split by first gathering their entries, since the HAMT doesn't give us a
+     * way to split it directly. The gathered entries are GC allocated, so they're kept
+     * alive while we're using them. */
+    native_vector<std::pair<object_ref, object_ref>> entries;
+    /* Every map is folded with reducef called with the key and value as separate args. */
+    auto const reduce_entries(
+      [&entries, reducef](object_ref acc, usize const start, usize const end) {
+        for(auto i{ start }; i != end; ++i)
+        {
+          acc = dynamic_call(reducef, acc, entries[i].first, entries[i].second);
+          if(acc->type == object_type::reduced)
+          {
+            return expect_object<obj::reduced>(acc)->val;
+          }
+        }
+        return acc;
+      });
+
+    auto count{ visit_object(
+      [&](auto const typed_coll) -> jtl::option<usize> {
+        using T = typename decltype(typed_coll)::value_type;
+
+        if constexpr(std::same_as<T, obj::persistent_vector>)
+        {
+          job.reduce_range = [&data = typed_coll->data,
+                              reducef](object_ref acc, usize const start, usize const end) {
+            immer::for_each_chunk_p(data.begin() + start,
+                                    data.begin() + end,
+                                    [&](auto const first, auto const last) {
+                                      for(auto it{ first }; it != last; ++it)
+                                      {
+                                        if(!reduce_step(acc, reducef, *it))
+                                        {
+                                          return false;
+                                        }
+                                      }
+                                      return true;
+                                    });
+            return acc;
+          };
+          return typed_coll->data.size();
+        }
+        else if constexpr(std::same_as<T, obj::integer_range>)
+        {
+          job.reduce_range = [first = typed_coll->start->data,
+                              step = typed_coll->step->data,
+                              reducef](object_ref acc, usize const start, usize const end) {
+            for(auto i{ start }; i != end; ++i)
+            {
+              if(!reduce_step(acc, reducef, make_box(first + static_cast<i64>(i) * step)))
+              {
+                break;
+              }
+            }
+            return acc;
+          };
+          return typed_coll->count();
+        }
+        else if constexpr(std::same_as<T, obj::persistent_hash_map>
+                          || std::same_as<T, obj::persistent_array_map>)
+        {
+          entries.reserve(typed_coll->data.size());
+          for(auto const entry : typed_coll->data)
+          {
+            entries.emplace_back(entry.first, entry.second);
+          }
+
+          job.reduce_range = reduce_entries;
+          return entries.size();
+        }
+        else
+        {
+          return none;
+        }
+      },
+      coll) };
+
+    /* Other maps, such as sorted maps, have their entries gathered through their seq. */
+    if(count.is_none() && is_map(coll))
+    {
+      for(auto it(fresh_seq(coll)); it.is_some(); it = next_in_place(it))
+      {
+        auto const entry(first(it));
+        entries.emplace_back(first(entry), second(entry));
+      }
+      job.reduce_range = reduce_entries;
+      count = entries.size();
+    }
+
+    if(count.is_none())
+    {
+      return reduce(reducef, dynamic_call(combinef), coll);
+    }
+    return fold_range(job, 0, count.unwrap());
+  }
+
   object_ref reduced(object_ref const o)
   {
     return make_box<obj::reduced>(o);
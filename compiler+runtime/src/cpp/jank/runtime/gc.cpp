@@ -0,0 +1,168 @@
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <string_view>
+
+#include <gc/gc.h>
+
+#include <jank/runtime/gc.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/util/cli.hpp>
+
+namespace jank::runtime::gc
+{
+  using clock = std::chrono::steady_clock;
+
+  /* The collection event callback runs while the GC holds its allocation lock, so it must
+   * not allocate. Only the atomics are read from elsewhere. */
+  static clock::time_point pause_start;
+  static std::atomic<u64> pause_count;
+  static std::atomic<u64> total_pause_ns;
+  static std::atomic<u64> max_pause_ns;
+  static std::atomic<usize> heap_limit;
+
+  static void on_collection_event(GC_EventType const event)
+  {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    switch(event)
+    {
+      /* The world is stopped for marking. In incremental mode, this is only the final
+       * part of each collection. */
+      case GC_EVENT_PRE_STOP_WORLD:
+        pause_start = clock::now();
+        break;
+      case GC_EVENT_POST_START_WORLD:
+        {
+          auto const pause(static_cast<u64>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - pause_start)
+              .count()));
+          ++pause_count;
+          total_pause_ns += pause;
+          auto max(max_pause_ns.load());
+          while(max < pause && !max_pause_ns.compare_exchange_weak(max, pause))
+          {
+          }
+        }
+        break;
+      default:
+        break;
+    }
+#pragma clang diagnostic pop
+  }
+
+  /* Supports both `--gc-markers N` and `--gc-markers=N`. Anything invalid is left for the
+   * CLI parser to report. */
+  static unsigned find_markers_arg(int const argc, char const * const *argv)
+  {
+    std::string_view const flag{ "--gc-markers" };
+    for(int i{ 1 }; i < argc; ++i)
+    {
+      std::string_view arg{ argv[i] };
+      if(!arg.starts_with(flag))
+      {
+        continue;
+      }
+
+      arg.remove_prefix(flag.size());
+      if(arg.empty() && i + 1 < argc)
+      {
+        arg = argv[i + 1];
+      }
+      else if(arg.starts_with('='))
+      {
+        arg.remove_prefix(1);
+      }
+      else
+      {
+        continue;
+      }
+
+      unsigned markers{};
+      std::from_chars(arg.data(), arg.data() + arg.size(), markers);
+      return markers;
+    }
+    return 0;
+  }
+
+  void init(int const argc, char const * const *argv)
+  {
+    /* This has no effect if something has already allocated with the GC. */
+    if(auto const markers{ find_markers_arg(argc, argv) }; markers != 0)
+    {
+      GC_set_markers_count(markers);
+    }
+
+    GC_set_all_interior_pointers(1);
+    GC_set_on_collection_event(&on_collection_event);
+    GC_enable();
+  }
+
+  void configure()
+  {
+    auto const &opts(util::cli::opts);
+
+    if(opts.gc_incremental)
+    {
+      GC_enable_incremental();
+    }
+    if(opts.gc_free_space_divisor != 0)
+    {
+      GC_set_free_space_divisor(opts.gc_free_space_divisor);
+    }
+    if(opts.gc_max_heap != 0)
+    {
+      heap_limit = opts.gc_max_heap;
+      GC_set_max_heap_size(opts.gc_max_heap);
+    }
+    if(auto const heap_size{ GC_get_heap_size() }; heap_size < opts.gc_initial_heap)
+    {
+      GC_expand_hp(opts.gc_initial_heap - heap_size);
+    }
+  }
+
+  object_ref stats()
+  {
+    GC_word heap_size{}, free_bytes{}, unmapped_bytes{}, bytes_since_gc{}, total_bytes{};
+    GC_get_heap_usage_safe(&heap_size, &free_bytes, &unmapped_bytes, &bytes_since_gc, &total_bytes);
+
+    auto const kw([](jtl::immutable_string const &name) {
+      return __rt_ctx->intern_keyword(name).expect_ok();
+    });
+    auto const box([](auto const n) { return make_box(static_cast<i64>(n)); });
+
+    runtime::detail::native_transient_hash_map ret;
+    ret.set(kw("heap-size"), box(heap_size));
+    ret.set(kw("heap-limit"), box(heap_limit.load()));
+    ret.set(kw("free-bytes"), box(free_bytes));
+    ret.set(kw("unmapped-bytes"), box(unmapped_bytes));
+    ret.set(kw("bytes-since-gc"), box(bytes_since_gc));
+    ret.set(kw("bytes-allocated"), box(total_bytes));
+    ret.set(kw("collections"), box(GC_get_gc_no()));
+    ret.set(kw("pauses"), box(pause_count.load()));
+    ret.set(kw("total-pause-ns"), box(total_pause_ns.load()));
+    ret.set(kw("max-pause-ns"), box(max_pause_ns.load()));
+    return make_box<obj::persistent_hash_map>(ret.persistent());
+  }
+
+  object_ref collect()
+  {
+    GC_gcollect();
+    return jank_nil;
+  }
+
+  object_ref set_heap_limit(object_ref const bytes)
+  {
+    auto const limit(to_int(bytes));
+    if(limit < 0)
+    {
+      throw std::runtime_error{ "The heap limit must not be negative." };
+    }
+
+    heap_limit = static_cast<usize>(limit);
+    GC_set_max_heap_size(static_cast<GC_word>(limit));
+    return jank_nil;
+  }
+}
@@ -15,6 +15,7 @@
 #include <jank/runtime/obj/persistent_array_map.hpp>
 #include <jank/detail/to_runtime_data.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/codegen/llvm_processor.hpp>
 #include <jank/runtime/obj/atom.hpp>
 #include <jank/runtime/obj/jit_function.hpp>
 #include <jank/runtime/obj/native_function_wrapper.hpp>
@@ -23,6 +24,7 @@
 #include <jank/runtime/module/loader.hpp>
 #include <jank/runtime/rtti.hpp>
 #include <jank/util/dir.hpp>
+#include <jank/util/sha256.hpp>
 #include <jank/profile/time.hpp>
 
 namespace jank::runtime::module
@@ -58,6 +60,11 @@ namespace jank::runtime::module
     return util::format("jank_load_{}", ret);
   }
 
+  jtl::immutable_string object_to_manifest_path(jtl::immutable_string const &o_path)
+  {
+    return util::format("{}.manifest", o_path);
+  }
+
   jtl::immutable_string
   nest_module(jtl::immutable_string const &module, jtl::immutable_string const &sub)
   {
@@ -483,7 +490,7 @@ namespace jank::runtime::module
   }
 
   jtl::string_result<loader::find_result>
-  loader::find(jtl::immutable_string const &module, origin const ori)
+  loader::find(jtl::immutable_string const &module, origin const ori) const
   {
     static std::regex const underscore{ "_" };
     native_transient_string patched_module{ module };
@@ -522,24 +529,18 @@ namespace jank::runtime::module
          && (entry->second.jank.is_some() || entry->second.cljc.is_some()
              || entry->second.cpp.is_some()))
       {
-        auto const o_file_path{ native_transient_string{ entry->second.o.unwrap().path } };
-
-        std::time_t source_modified_time{};
         module_type module_type{};
 
         if(entry->second.jank.is_some() && entry->second.jank.unwrap().exists())
         {
-          source_modified_time = entry->second.jank.unwrap().last_modified_at();
           module_type = module_type::jank;
         }
         else if(entry->second.cljc.is_some() && entry->second.cljc.unwrap().exists())
         {
-          source_modified_time = entry->second.cljc.unwrap().last_modified_at();
           module_type = module_type::cljc;
         }
         else if(entry->second.cpp.is_some() && entry->second.cpp.unwrap().exists())
         {
-          source_modified_time = entry->second.cpp.unwrap().last_modified_at();
           module_type = module_type::cpp;
         }
         else
@@ -548,8 +549,7 @@ namespace jank::runtime::module
             util::format("Found a binary ({}), without a source", entry->second.o.unwrap().path));
         }
 
-        if(std::filesystem::last_write_time(o_file_path).time_since_epoch().count()
-           >= source_modified_time)
+        if(is_cache_valid(module, entry->second.o.unwrap()))
         {
           return find_result{ entry->second, module_type::o };
         }
@@ -575,6 +575,182 @@ namespace jank::runtime::module
     return err(util::format("No sources for registered module: {}", module));
   }
 
+  /* Everything we were invoked with which can change the code generated for a module. Some
+   * of this is already in the binary version, but having it here too means a manifest
+   * doesn't rely on which directory its object file happens to be in. */
+  static jtl::immutable_string const &options_hash()
+  {
+    static jtl::immutable_string const res{ [] {
+      auto const &opts{ util::cli::opts };
+      jtl::string_builder sb;
+      sb(util::format("{}.{}.{}.{}.{}",
+                      static_cast<int>(opts.optimization_level),
+                      static_cast<int>(opts.codegen),
+                      static_cast<int>(opts.debug),
+                      static_cast<int>(opts.direct_call),
+                      static_cast<int>(opts.tiered_compilation)));
+      for(auto const &inc : opts.include_dirs)
+      {
+        sb(' ');
+        sb(inc);
+      }
+      sb(" .");
+      for(auto const &def : opts.define_macros)
+      {
+        sb(' ');
+        sb(def);
+      }
+      return util::sha256(sb.release());
+    }() };
+    return res;
+  }
+
+  /* Modules without any source, such as those which are only defined natively, can't
+   * change under us, so they're all given the same placeholder hash. */
+  static constexpr char const *no_source_hash{ "-" };
+
+  static jtl::immutable_string
+  render_manifest(loader const &l, native_vector<jtl::immutable_string> const &modules)
+  {
+    jtl::string_builder sb;
+    sb("options ");
+    sb(options_hash());
+    sb('\n');
+    for(auto const &module : modules)
+    {
+      sb(module);
+      sb(' ');
+      sb(l.source_hash(module).unwrap_or(no_source_hash));
+      sb('\n');
+    }
+    return sb.release();
+  }
+
+  jtl::immutable_string loader::cache_manifest(jtl::immutable_string const &module) const
+  {
+    /* The module itself comes first, followed by its dependencies in breadth first order.
+     * Only the first occurrence of each dependency is kept. */
+    native_vector<jtl::immutable_string> modules{ module };
+    native_set<jtl::immutable_string> seen{ module };
+    for(usize i{}; i < modules.size(); ++i)
+    {
+      auto const found{ __rt_ctx->module_dependencies.find(modules[i]) };
+      if(found == __rt_ctx->module_dependencies.end())
+      {
+        continue;
+      }
+
+      for(auto const &dep : found->second)
+      {
+        if(seen.emplace(dep).second)
+        {
+          modules.emplace_back(dep);
+        }
+      }
+    }
+
+    return render_manifest(*this, modules);
+  }
+
+  bool loader::is_cache_valid(jtl::immutable_string const &module, file_entry const &o) const
+  {
+    auto const file{ read_file(object_to_manifest_path(o.path)) };
+    if(file.is_err())
+    {
+      return false;
+    }
+    jtl::immutable_string const manifest{ file.expect_ok().view() };
+
+    /* We don't need to know the dependency graph to check the manifest. Its first line is
+     * for the options and every other line starts with a module, so we can just hash
+     * those modules again and see if we get the same manifest. */
+    native_vector<jtl::immutable_string> modules;
+    for(auto line_start{ manifest.find('\n') + 1 };
+        line_start != 0 && line_start < manifest.size();)
+    {
+      auto const line_end{ manifest.find('\n', line_start) };
+      auto const space{ manifest.find(' ', line_start) };
+      if(line_end == jtl::immutable_string::npos || space == jtl::immutable_string::npos
+         || line_end < space)
+      {
+        return false;
+      }
+      modules.emplace_back(manifest.substr(line_start, space - line_start));
+      line_start = line_end + 1;
+    }
+
+    if(modules.empty() || modules[0] != module)
+    {
+      return false;
+    }
+
+    return render_manifest(*this, modules) == manifest;
+  }
+
+  jtl::option<jtl::immutable_string>
+  loader::source_hash(jtl::immutable_string const &module) const
+  {
+    auto const found{ find(module, origin::source) };
+    if(found.is_err())
+    {
+      return none;
+    }
+
+    auto const &sources{ found.expect_ok().sources };
+    jtl::option<file_entry> source;
+    switch(found.expect_ok().to_load.unwrap())
+    {
+      case module_type::jank:
+        source = sources.jank;
+        break;
+      case module_type::cljc:
+        source = sources.cljc;
+        break;
+      case module_type::cpp:
+        source = sources.cpp;
+        break;
+      case module_type::o:
+        break;
+    }
+    if(source.is_none() || !source.unwrap().exists())
+    {
+      return none;
+    }
+
+    auto const &entry{ source.unwrap() };
+    auto const key{ entry.archive_path.is_some()
+                      ? util::format("{}:{}", entry.archive_path.unwrap(), entry.path)
+                      : entry.path };
+    auto const modified_at{ entry.last_modified_at() };
+    {
+      auto const locked_hashes{ source_hashes.rlock() };
+      auto const cached{ locked_hashes->find(key) };
+      if(cached != locked_hashes->end() && cached->second.modified_at == modified_at)
+      {
+        return cached->second.hash;
+      }
+    }
+
+    jtl::immutable_string hash;
+    if(entry.archive_path.is_some())
+    {
+      visit_jar_entry(entry,
+                      [&](auto const &zip_entry) { hash = util::sha256(zip_entry.readAsText()); });
+    }
+    else
+    {
+      auto const file{ read_file(entry.path) };
+      if(file.is_err())
+      {
+        return none;
+      }
+      hash = util::sha256(file.expect_ok().view());
+    }
+
+    source_hashes.wlock()->insert_or_assign(key, hashed_source{ modified_at, hash });
+    return hash;
+  }
+
   bool loader::is_loaded(jtl::immutable_string const &module)
   {
     auto const atom{
@@ -802,6 +978,10 @@ namespace jank::runtime::module
 
   jtl::string_result<void> loader::load_jank(file_entry const &entry) const
   {
+    /* Every top-level form in the module is JIT compiled separately, but they can all
+     * share the same LLVM context and pass pipeline. */
+    codegen::module_batch_scope const batch;
+
     if(entry.archive_path.is_some())
     {
       visit_jar_entry(entry, [&](auto const &zip_entry) {
@@ -0,0 +1,453 @@
+#include <jank/runtime/obj/agent.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/behavior/callable.hpp>
+#include <jank/runtime/behavior/metadatable.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core.hpp>
+#include <jank/runtime/thread_pool.hpp>
+#include <jank/util/fmt.hpp>
+#include <jank/util/scope_exit.hpp>
+
+namespace jank::runtime::obj
+{
+  struct agent_task : task
+  {
+    agent_task(agent_ref const a)
+      : a{ a }
+    {
+    }
+
+    void run() override
+    {
+      a->run_next();
+    }
+
+    agent_ref a;
+  };
+
+  /* Actions are CPU bound, so we keep a couple of extra threads around to cover for the odd
+   * action which blocks anyway. */
+  static thread_pool &pooled_executor()
+  {
+    static thread_pool pool{ std::max(1u, std::thread::hardware_concurrency()) + 2 };
+    return pool;
+  }
+
+  static elastic_thread_pool &solo_executor()
+  {
+    /* The pool's threads are detached, so it's never destroyed. Being referenced from
+     * static storage keeps it alive for the GC. */
+    static auto const pool{ new elastic_thread_pool{ std::chrono::seconds{ 60 } } };
+    return *pool;
+  }
+
+  static std::atomic_bool agents_shut_down{};
+
+  /* Sends made during an action are held here until the action completes, so that they're
+   * dropped if it fails. This points to a vector on the stack of the running action, which
+   * the GC will scan. */
+  static thread_local native_vector<std::pair<agent_ref, agent::action *>> *held_sends{};
+
+  static var_ref agent_var()
+  {
+    static var_ref const var{ __rt_ctx->find_var("clojure.core", "*agent*") };
+    return var;
+  }
+
+  static keyword_ref fail_keyword()
+  {
+    static keyword_ref const kw{ __rt_ctx->intern_keyword("fail").expect_ok() };
+    return kw;
+  }
+
+  static keyword_ref continue_keyword()
+  {
+    static keyword_ref const kw{ __rt_ctx->intern_keyword("continue").expect_ok() };
+    return kw;
+  }
+
+  agent::agent(object_ref const state)
+    : state{ state.data }
+    , error_mode{ fail_keyword() }
+    , watches{ persistent_hash_map::empty() }
+  {
+  }
+
+  bool agent::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  jtl::immutable_string agent::to_string() const
+  {
+    jtl::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void agent::to_string(jtl::string_builder &buff) const
+  {
+    util::format_to(buff, "#object [{} {}]", object_type_str(base.type), &base);
+  }
+
+  jtl::immutable_string agent::to_code_string() const
+  {
+    return to_string();
+  }
+
+  uhash agent::to_hash() const
+  {
+    return static_cast<uhash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  agent_ref agent::with_meta(object_ref const m)
+  {
+    meta = behavior::detail::validate_meta(m);
+    return this;
+  }
+
+  object_ref agent::deref() const
+  {
+    return state.load();
+  }
+
+  void agent::add_watch(object_ref const key, object_ref const fn)
+  {
+    auto locked_watches(watches.wlock());
+    *locked_watches = (*locked_watches)->assoc(key, fn);
+  }
+
+  void agent::remove_watch(object_ref const key)
+  {
+    auto locked_watches(watches.wlock());
+    *locked_watches = (*locked_watches)->dissoc(key);
+  }
+
+  void agent::notify_watches(object_ref const old_state, object_ref const new_state)
+  {
+    auto const locked_watches(watches.rlock());
+    for(auto const entry : (*locked_watches)->data)
+    {
+      auto const fn(entry.second);
+      if(fn.is_some())
+      {
+        dynamic_call(fn, entry.first, agent_ref{ this }, old_state, new_state);
+      }
+    }
+  }
+
+  static void validate(object_ref const validator, object_ref const state)
+  {
+    if(validator.is_some() && !truthy(dynamic_call(validator, state)))
+    {
+      throw make_box("Invalid reference state").erase();
+    }
+  }
+
+  void agent::dispatch(action * const a)
+  {
+    if(agents_shut_down.load())
+    {
+      throw make_box("Unable to send to an agent after shutdown-agents.").erase();
+    }
+
+    {
+      std::lock_guard const lock{ error_mutex };
+      if(error.is_some())
+      {
+        throw make_box("Agent is failed, needs restart.").erase();
+      }
+    }
+
+    if(held_sends)
+    {
+      held_sends->emplace_back(this, a);
+      return;
+    }
+    enqueue(a);
+  }
+
+  void agent::enqueue(action * const a)
+  {
+    ++queued;
+
+    a->next = pending.load();
+    while(!pending.compare_exchange_weak(a->next, a))
+    {
+    }
+
+    if(!scheduled.exchange(true))
+    {
+      schedule_next();
+    }
+  }
+
+  static void execute(agent_ref const a, agent::action * const act)
+  {
+    switch(act->kind)
+    {
+      case agent::executor_kind::pooled:
+        pooled_executor().submit(new agent_task{ a });
+        break;
+      case agent::executor_kind::solo:
+        solo_executor().submit(new agent_task{ a });
+        break;
+      case agent::executor_kind::custom:
+        dynamic_call(act->executor, act->thunk);
+        break;
+    }
+  }
+
+  /* Must only be called while holding the scheduling token. Either the next action is
+   * handed off to its executor, which then holds the token, or the token is released. */
+  void agent::schedule_next()
+  {
+    while(true)
+    {
+      if(!ready)
+      {
+        /* The pending stack is newest first, so reversing it gives us send order. */
+        auto head{ pending.exchange(nullptr) };
+        while(head)
+        {
+          auto const next{ head->next };
+          head->next = ready;
+          ready = head;
+          head = next;
+        }
+      }
+
+      auto const failed{ get_error().is_some() };
+      if(ready && !failed)
+      {
+        object_ref err{};
+        try
+        {
+          execute(this, ready);
+          return;
+        }
+        catch(object_ref const e)
+        {
+          err = e;
+        }
+        catch(std::exception const &e)
+        {
+          err = make_box(e.what());
+        }
+
+        /* If the executor won't take the action, the agent fails, just as if the action
+         * had thrown. */
+        std::lock_guard const lock{ error_mutex };
+        error = err;
+        continue;
+      }
+
+      scheduled.store(false);
+
+      /* Anything sent after we emptied the stack, but before we released the token, would
+       * have failed to take the token, so we need to pick it up. */
+      if(!pending.load() || failed || scheduled.exchange(true))
+      {
+        return;
+      }
+    }
+  }
+
+  void agent::run_next()
+  {
+    auto const act{ ready };
+    ready = act->next;
+    act->next = nullptr;
+
+    native_vector<std::pair<agent_ref, action *>> sends;
+    auto const outer_sends{ held_sends };
+    held_sends = &sends;
+
+    /* No matter how the action goes, we need to move on to the next one. Otherwise, the
+     * agent would stay scheduled and nothing sent to it would ever run. */
+    util::scope_exit const done{ [&] {
+      held_sends = outer_sends;
+      --queued;
+      schedule_next();
+    } };
+
+    object_ref err{};
+    try
+    {
+      auto bindings{ act->bindings };
+      if(auto const var{ agent_var() }; var.is_some())
+      {
+        bindings = bindings->assoc(var, agent_ref{ this });
+      }
+      context::binding_scope const conveyed{ bindings };
+
+      object_ref const old_state{ state.load() };
+      auto const new_state{ apply_to(act->fn, runtime::cons(old_state, act->args)) };
+      validate(validator, new_state);
+      state.store(new_state.data);
+      notify_watches(old_state, new_state);
+    }
+    catch(object_ref const e)
+    {
+      err = e;
+    }
+    catch(std::exception const &e)
+    {
+      err = make_box(e.what());
+    }
+    catch(...)
+    {
+      err = make_box("Unknown exception thrown from agent action.");
+    }
+
+    held_sends = outer_sends;
+
+    if(err.is_some())
+    {
+      auto const handler{ get_error_handler() };
+      if(handler.is_some())
+      {
+        try
+        {
+          dynamic_call(handler, agent_ref{ this }, err);
+        }
+        catch(...)
+        {
+          /* Errors from the error handler itself are ignored, as in Clojure. */
+        }
+      }
+
+      if(runtime::equal(get_error_mode(), fail_keyword()))
+      {
+        std::lock_guard const lock{ error_mutex };
+        error = err;
+      }
+    }
+    else
+    {
+      for(auto const &send : sends)
+      {
+        send.first->enqueue(send.second);
+      }
+    }
+  }
+
+  object_ref agent::get_error() const
+  {
+    std::lock_guard const lock{ error_mutex };
+    return error;
+  }
+
+  object_ref agent::restart(object_ref const new_state, bool const clear_actions)
+  {
+    if(get_error().is_nil())
+    {
+      throw make_box("Agent does not need a restart.").erase();
+    }
+
+    validate(validator, new_state);
+    state.store(new_state.data);
+
+    /* A failed agent releases its token straight away, so we won't be waiting long. */
+    while(scheduled.exchange(true))
+    {
+      std::this_thread::yield();
+    }
+
+    if(clear_actions)
+    {
+      usize dropped{};
+      for(auto head{ pending.exchange(nullptr) }; head; head = head->next)
+      {
+        ++dropped;
+      }
+      for(; ready; ready = ready->next)
+      {
+        ++dropped;
+      }
+      queued -= dropped;
+    }
+
+    {
+      std::lock_guard const lock{ error_mutex };
+      error = jank_nil;
+    }
+
+    schedule_next();
+    return new_state;
+  }
+
+  void agent::set_error_handler(object_ref const fn)
+  {
+    std::lock_guard const lock{ error_mutex };
+    error_handler = fn;
+  }
+
+  object_ref agent::get_error_handler() const
+  {
+    std::lock_guard const lock{ error_mutex };
+    return error_handler;
+  }
+
+  void agent::set_error_mode(object_ref const mode)
+  {
+    if(!runtime::equal(mode, fail_keyword()) && !runtime::equal(mode, continue_keyword()))
+    {
+      throw make_box(
+        util::format("Invalid agent error mode: {}", runtime::to_code_string(mode)))
+        .erase();
+    }
+
+    std::lock_guard const lock{ error_mutex };
+    error_mode = expect_object<keyword>(mode);
+  }
+
+  object_ref agent::get_error_mode() const
+  {
+    std::lock_guard const lock{ error_mutex };
+    return error_mode;
+  }
+
+  void agent::set_validator(object_ref const fn)
+  {
+    validate(fn, state.load());
+    validator = fn;
+  }
+
+  usize agent::queue_count() const
+  {
+    return queued.load();
+  }
+
+  usize agent::release_pending_sends()
+  {
+    if(!held_sends)
+    {
+      return 0;
+    }
+
+    auto const ret{ held_sends->size() };
+    for(auto const &send : *held_sends)
+    {
+      send.first->enqueue(send.second);
+    }
+    held_sends->clear();
+    return ret;
+  }
+
+  /* As in Clojure, actions which were already handed to an executor still run, but
+   * nothing else is accepted. An agent with more actions waiting fails once its next one
+   * can't be submitted. */
+  void agent::shutdown()
+  {
+    agents_shut_down.store(true);
+    pooled_executor().shutdown();
+    solo_executor().shutdown();
+  }
+
+  bool agent::is_in_action()
+  {
+    return held_sends != nullptr;
+  }
+}
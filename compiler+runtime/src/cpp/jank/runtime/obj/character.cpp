@@ -74,3 +74,20 @@ namespace jank::runtime::obj
     return data.to_hash();
   }
 }
+
+namespace jank::runtime::detail
+{
+  template <usize... Is>
+  static auto make_character_cache(std::index_sequence<Is...>)
+  {
+    return std::array<obj::character, sizeof...(Is)>{ obj::character{ static_cast<char>(Is) }... };
+  }
+
+  obj::character_ref cached_character(char const c)
+  {
+    static auto const cache(make_character_cache(std::make_index_sequence<character_cache_size>{}));
+
+    jank_debug_assert(static_cast<unsigned char>(c) < character_cache_size);
+    return &cache[static_cast<unsigned char>(c)];
+  }
+}
@@ -37,12 +37,24 @@ namespace jank::runtime::obj
     return static_cast<uhash>(reinterpret_cast<uintptr_t>(this));
   }
 
+  bool delay::is_realized()
+  {
+    return val.load(std::memory_order_acquire) != nullptr;
+  }
+
   object_ref delay::deref()
   {
+    auto const v{ val.load(std::memory_order_acquire) };
+    if(v)
+    {
+      return v;
+    }
+
     std::lock_guard<std::mutex> const lock{ mutex };
-    if(val.is_some())
+    auto const locked_v{ val.load(std::memory_order_relaxed) };
+    if(locked_v)
     {
-      return val;
+      return locked_v;
     }
 
     if(error.is_some())
@@ -50,9 +62,10 @@ namespace jank::runtime::obj
       throw error;
     }
 
+    object_ref ret;
     try
     {
-      val = dynamic_call(fn);
+      ret = dynamic_call(fn);
     }
     catch(std::exception const &e)
     {
@@ -64,6 +77,11 @@ namespace jank::runtime::obj
       error = e;
       throw;
     }
-    return val;
+
+    /* The fn won't be called again, so there's no need to keep what it closes over
+     * alive. */
+    fn = jank_nil;
+    val.store(ret.data, std::memory_order_release);
+    return ret;
   }
 }
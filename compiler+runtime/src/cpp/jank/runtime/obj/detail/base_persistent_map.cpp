@@ -41,7 +41,14 @@ namespace jank::runtime::obj::detail
 
         return true;
       },
-      []() { return false; },
+      [&]() {
+        /* Source info is compared as the map it stands for, just as it compares itself. */
+        if(o.type == object_type::source_info)
+        {
+          return equal(expect_object<source_info>(&o)->to_map()->base);
+        }
+        return false;
+      },
       &o);
   }
 
@@ -151,6 +158,23 @@ namespace jank::runtime::obj::detail
                         static_cast<PT const *>(this)->data.end());
   }
 
+  template <typename PT, typename ST, typename V>
+  object_ref
+  base_persistent_map<PT, ST, V>::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    for(auto const entry : static_cast<PT const *>(this)->data)
+    {
+      if(!reduce_step(acc,
+                      f,
+                      make_box<persistent_vector>(std::in_place, entry.first, entry.second)))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
+
   template <typename PT, typename ST, typename V>
   usize base_persistent_map<PT, ST, V>::count() const
   {
@@ -1,4 +1,5 @@
 #include <jank/runtime/obj/detail/base_persistent_map_sequence.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/core/seq.hpp>
 
@@ -137,6 +138,41 @@ namespace jank::runtime::obj::detail
     return static_cast<PT *>(this);
   }
 
+  /* The HAMT doesn't expose its node arrays, so chunks are filled by walking the iterator.
+   * That still saves us from allocating a new sequence for every entry. */
+  template <typename PT, typename IT>
+  obj::array_chunk_ref base_persistent_map_sequence<PT, IT>::chunked_first() const
+  {
+    native_vector<object_ref> buffer;
+    buffer.reserve(chunk_size);
+    for(auto it(begin); it != end && buffer.size() < chunk_size; ++it)
+    {
+      auto const pair(*it);
+      buffer.emplace_back(make_box<obj::persistent_vector>(
+        runtime::detail::native_persistent_vector{ pair.first, pair.second }));
+    }
+    return make_box<obj::array_chunk>(std::move(buffer), 0);
+  }
+
+  template <typename PT, typename IT>
+  oref<PT> base_persistent_map_sequence<PT, IT>::chunked_next() const
+  {
+    auto n(begin);
+    usize skipped{};
+    while(n != end && skipped < chunk_size)
+    {
+      ++n;
+      ++skipped;
+    }
+
+    if(n == end)
+    {
+      return {};
+    }
+
+    return make_box<PT>(coll, n, end);
+  }
+
   template <typename PT, typename IT>
   obj::cons_ref base_persistent_map_sequence<PT, IT>::conj(object_ref const head)
   {
@@ -1,4 +1,5 @@
 #include <jank/runtime/obj/detail/iterator_sequence.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core/seq.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/runtime/visit.hpp>
@@ -111,6 +112,39 @@ namespace jank::runtime::obj::detail
     return static_cast<Derived *>(this);
   }
 
+  /* The HAMT doesn't expose its node arrays, so chunks are filled by walking the iterator.
+   * That still saves us from allocating a new sequence for every element. */
+  template <typename Derived, typename It>
+  obj::array_chunk_ref iterator_sequence<Derived, It>::chunked_first() const
+  {
+    native_vector<object_ref> buffer;
+    buffer.reserve(std::min(chunk_size, size));
+    for(auto it(begin); it != end && buffer.size() < chunk_size; ++it)
+    {
+      buffer.emplace_back(*it);
+    }
+    return make_box<obj::array_chunk>(std::move(buffer), 0);
+  }
+
+  template <typename Derived, typename It>
+  oref<Derived> iterator_sequence<Derived, It>::chunked_next() const
+  {
+    auto n(begin);
+    usize skipped{};
+    while(n != end && skipped < chunk_size)
+    {
+      ++n;
+      ++skipped;
+    }
+
+    if(n == end)
+    {
+      return {};
+    }
+
+    return make_box<Derived>(coll, n, end, size - skipped);
+  }
+
   template <typename Derived, typename It>
   obj::cons_ref iterator_sequence<Derived, It>::conj(object_ref const head)
   {
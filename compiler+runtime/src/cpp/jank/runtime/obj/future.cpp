@@ -0,0 +1,212 @@
+#include <jank/runtime/obj/future.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/behavior/callable.hpp>
+#include <jank/runtime/core/math.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/thread_pool.hpp>
+#include <jank/util/fmt.hpp>
+
+namespace jank::runtime::obj
+{
+  struct future_task : task
+  {
+    future_task(future_ref const fut)
+      : fut{ fut }
+    {
+    }
+
+    void run() override
+    {
+      fut->run();
+    }
+
+    future_ref fut;
+  };
+
+  future::future(object_ref const fn)
+    : fn{ fn }
+  {
+  }
+
+  future_ref future::submit(object_ref const fn)
+  {
+    auto const ret{ make_box<future>(fn) };
+    ret->bindings = __rt_ctx->get_thread_bindings();
+    thread_pool::shared().submit(new future_task{ ret });
+    return ret;
+  }
+
+  bool future::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  jtl::immutable_string future::to_string() const
+  {
+    jtl::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void future::to_string(jtl::string_builder &buff) const
+  {
+    util::format_to(buff, "#object [{} {}]", object_type_str(base.type), &base);
+  }
+
+  jtl::immutable_string future::to_code_string() const
+  {
+    return to_string();
+  }
+
+  uhash future::to_hash() const
+  {
+    return static_cast<uhash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  void future::run()
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      /* We may have been cancelled while we were queued. */
+      if(current_state != state::pending)
+      {
+        return;
+      }
+      current_state = state::running;
+    }
+
+    object_ref ret{};
+    object_ref ret_error{};
+    std::exception_ptr ret_native_error;
+    try
+    {
+      context::binding_scope const conveyed{ bindings };
+      ret = dynamic_call(fn);
+    }
+    catch(object_ref const e)
+    {
+      ret_error = e;
+    }
+    catch(...)
+    {
+      ret_native_error = std::current_exception();
+    }
+
+    {
+      std::lock_guard const lock{ mutex };
+      if(ret_error.is_some() || ret_native_error)
+      {
+        error = ret_error;
+        native_error = ret_native_error;
+        current_state = state::failed;
+      }
+      else
+      {
+        val = ret;
+        current_state = state::done;
+      }
+
+      /* Nothing else needs these, so we let the GC have them. */
+      fn = jank_nil;
+      bindings = {};
+    }
+    completed.notify_all();
+  }
+
+  bool future::wait(jtl::option<i64> const &timeout_ms)
+  {
+    auto const deadline{ std::chrono::steady_clock::now()
+                         + std::chrono::milliseconds{ timeout_ms.unwrap_or(0) } };
+
+    /* If we're waiting from within the pool, the future may be queued up behind us, so we
+     * keep running the pool's work until it's done. */
+    auto &pool{ thread_pool::shared() };
+    if(pool.is_worker())
+    {
+      pool.help_until([&] {
+        return is_done()
+          || (timeout_ms.is_some() && std::chrono::steady_clock::now() >= deadline);
+      });
+      return is_done();
+    }
+
+    std::unique_lock lock{ mutex };
+    auto const complete{ [this] {
+      return current_state != state::pending && current_state != state::running;
+    } };
+    if(timeout_ms.is_some())
+    {
+      return completed.wait_until(lock, deadline, complete);
+    }
+    completed.wait(lock, complete);
+    return true;
+  }
+
+  object_ref future::result() const
+  {
+    std::lock_guard const lock{ mutex };
+    switch(current_state)
+    {
+      case state::done:
+        return val;
+      case state::failed:
+        if(error.is_some())
+        {
+          throw error;
+        }
+        std::rethrow_exception(native_error);
+      case state::cancelled:
+        throw std::runtime_error{ "Unable to deref a cancelled future." };
+      default:
+        throw std::runtime_error{ "Unable to deref an incomplete future." };
+    }
+  }
+
+  object_ref future::deref()
+  {
+    wait(none);
+    return result();
+  }
+
+  object_ref future::deref(object_ref const timeout_ms, object_ref const timeout_val)
+  {
+    if(!wait(to_int(timeout_ms)))
+    {
+      return timeout_val;
+    }
+    return result();
+  }
+
+  bool future::is_realized() const
+  {
+    return is_done();
+  }
+
+  bool future::is_done() const
+  {
+    std::lock_guard const lock{ mutex };
+    return current_state != state::pending && current_state != state::running;
+  }
+
+  bool future::is_cancelled() const
+  {
+    std::lock_guard const lock{ mutex };
+    return current_state == state::cancelled;
+  }
+
+  bool future::cancel()
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      if(current_state != state::pending)
+      {
+        return false;
+      }
+      current_state = state::cancelled;
+      fn = jank_nil;
+      bindings = {};
+    }
+    completed.notify_all();
+    return true;
+  }
+}
@@ -102,6 +102,21 @@ namespace jank::runtime::obj
     return make_box<integer_range>(start, end, step, bounds_check);
   }
 
+  object_ref integer_range::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    auto const n{ count() };
+    auto val{ start->data };
+    for(usize i{}; i < n; ++i, val += step->data)
+    {
+      if(!reduce_step(acc, f, make_box(val)))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
+
   integer_ref integer_range::first() const
   {
     return start;
@@ -11,14 +11,23 @@
 
 namespace jank::runtime::obj
 {
+  static decltype(jit_closure::calls_until_tier_up) initial_tier_up_countdowns()
+  {
+    decltype(jit_closure::calls_until_tier_up) ret{};
+    ret.fill(util::cli::opts.tiered_compilation ? jit::tier_up_threshold : 0);
+    return ret;
+  }
+
   jit_closure::jit_closure(arity_flag_t const arity_flags, void * const context)
     : context{ context }
     , arity_flags{ arity_flags }
+    , calls_until_tier_up{ initial_tier_up_countdowns() }
   {
   }
 
   jit_closure::jit_closure(object_ref const meta)
     : meta{ meta }
+    , calls_until_tier_up{ initial_tier_up_countdowns() }
   {
   }
 
@@ -62,40 +71,74 @@ namespace jank::runtime::obj
     return this;
   }
 
+  template <typename F>
+  void jit_closure::tier_up(F &arity, u32 &countdown)
+  {
+    /* If it's not ready yet, it'll be checked again after another round of calls. */
+    if(!jit::tier_up_arity(__rt_ctx->jit_prc, arity))
+    {
+      std::atomic_ref<u32>{ countdown }.store(jit::tier_up_threshold, std::memory_order_relaxed);
+    }
+  }
+
   object_ref jit_closure::call()
   {
-    if(!arity_0)
+    if(jit::count_call(calls_until_tier_up[0])) [[unlikely]]
+    {
+      tier_up(arity_0, calls_until_tier_up[0]);
+    }
+
+    auto const fn{ jit::load_arity(arity_0) };
+    if(!fn)
     {
       throw invalid_arity<0>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_0(&base);
+    return fn(&base);
   }
 
   object_ref jit_closure::call(object_ref const a1)
   {
-    if(!arity_1)
+    if(jit::count_call(calls_until_tier_up[1])) [[unlikely]]
+    {
+      tier_up(arity_1, calls_until_tier_up[1]);
+    }
+
+    auto const fn{ jit::load_arity(arity_1) };
+    if(!fn)
     {
       throw invalid_arity<1>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_1(&base, a1.data);
+    return fn(&base, a1.data);
   }
 
   object_ref jit_closure::call(object_ref const a1, object_ref const a2)
   {
-    if(!arity_2)
+    if(jit::count_call(calls_until_tier_up[2])) [[unlikely]]
+    {
+      tier_up(arity_2, calls_until_tier_up[2]);
+    }
+
+    auto const fn{ jit::load_arity(arity_2) };
+    if(!fn)
     {
       throw invalid_arity<2>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_2(&base, a1.data, a2.data);
+    return fn(&base, a1.data, a2.data);
   }
 
   object_ref jit_closure::call(object_ref const a1, object_ref const a2, object_ref const a3)
   {
-    if(!arity_3)
+    if(jit::count_call(calls_until_tier_up[3])) [[unlikely]]
+    {
+      tier_up(arity_3, calls_until_tier_up[3]);
+    }
+
+    auto const fn{ jit::load_arity(arity_3) };
+    if(!fn)
     {
       throw invalid_arity<3>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_3(&base, a1.data, a2.data, a3.data);
+    return fn(&base, a1.data, a2.data, a3.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -103,11 +146,17 @@ namespace jank::runtime::obj
                                object_ref const a3,
                                object_ref const a4)
   {
-    if(!arity_4)
+    if(jit::count_call(calls_until_tier_up[4])) [[unlikely]]
+    {
+      tier_up(arity_4, calls_until_tier_up[4]);
+    }
+
+    auto const fn{ jit::load_arity(arity_4) };
+    if(!fn)
     {
       throw invalid_arity<4>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_4(&base, a1.data, a2.data, a3.data, a4.data);
+    return fn(&base, a1.data, a2.data, a3.data, a4.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -116,11 +165,17 @@ namespace jank::runtime::obj
                                object_ref const a4,
                                object_ref const a5)
   {
-    if(!arity_5)
+    if(jit::count_call(calls_until_tier_up[5])) [[unlikely]]
+    {
+      tier_up(arity_5, calls_until_tier_up[5]);
+    }
+
+    auto const fn{ jit::load_arity(arity_5) };
+    if(!fn)
     {
       throw invalid_arity<5>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_5(&base, a1.data, a2.data, a3.data, a4.data, a5.data);
+    return fn(&base, a1.data, a2.data, a3.data, a4.data, a5.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -130,11 +185,17 @@ namespace jank::runtime::obj
                                object_ref const a5,
                                object_ref const a6)
   {
-    if(!arity_6)
+    if(jit::count_call(calls_until_tier_up[6])) [[unlikely]]
+    {
+      tier_up(arity_6, calls_until_tier_up[6]);
+    }
+
+    auto const fn{ jit::load_arity(arity_6) };
+    if(!fn)
     {
       throw invalid_arity<6>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_6(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data);
+    return fn(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -145,11 +206,17 @@ namespace jank::runtime::obj
                                object_ref const a6,
                                object_ref const a7)
   {
-    if(!arity_7)
+    if(jit::count_call(calls_until_tier_up[7])) [[unlikely]]
+    {
+      tier_up(arity_7, calls_until_tier_up[7]);
+    }
+
+    auto const fn{ jit::load_arity(arity_7) };
+    if(!fn)
     {
       throw invalid_arity<7>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_7(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data, a7.data);
+    return fn(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data, a7.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -161,11 +228,17 @@ namespace jank::runtime::obj
                                object_ref const a7,
                                object_ref const a8)
   {
-    if(!arity_8)
+    if(jit::count_call(calls_until_tier_up[8])) [[unlikely]]
+    {
+      tier_up(arity_8, calls_until_tier_up[8]);
+    }
+
+    auto const fn{ jit::load_arity(arity_8) };
+    if(!fn)
     {
       throw invalid_arity<8>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_8(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data, a7.data, a8.data);
+    return fn(&base, a1.data, a2.data, a3.data, a4.data, a5.data, a6.data, a7.data, a8.data);
   }
 
   object_ref jit_closure::call(object_ref const a1,
@@ -178,11 +251,17 @@ namespace jank::runtime::obj
                                object_ref const a8,
                                object_ref const a9)
   {
-    if(!arity_9)
+    if(jit::count_call(calls_until_tier_up[9])) [[unlikely]]
+    {
+      tier_up(arity_9, calls_until_tier_up[9]);
+    }
+
+    auto const fn{ jit::load_arity(arity_9) };
+    if(!fn)
     {
       throw invalid_arity<9>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_9(&base,
+    return fn(&base,
                    a1.data,
                    a2.data,
                    a3.data,
@@ -205,11 +284,17 @@ namespace jank::runtime::obj
                                object_ref const a9,
                                object_ref const a10)
   {
-    if(!arity_10)
+    if(jit::count_call(calls_until_tier_up[10])) [[unlikely]]
+    {
+      tier_up(arity_10, calls_until_tier_up[10]);
+    }
+
+    auto const fn{ jit::load_arity(arity_10) };
+    if(!fn)
     {
       throw invalid_arity<10>{ runtime::to_string(this_object_ref()) };
     }
-    return arity_10(&base,
+    return fn(&base,
                     a1.data,
                     a2.data,
                     a3.data,
@@ -8,30 +8,35 @@
 #include <jank/runtime/core/seq.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/util/fmt/print.hpp>
+#include <jank/util/scope_exit.hpp>
 
 namespace jank::runtime::obj
 {
   lazy_sequence::lazy_sequence(object_ref const fn)
-    : fn{ fn }
+    : fn{ fn.data }
   {
     jank_debug_assert(fn.is_some());
   }
 
   lazy_sequence::lazy_sequence(object_ref const fn, object_ref const sequence)
-    : fn{ fn }
-    , s{ sequence }
+    : realized{ fn.is_nil() ? sequence.data : nullptr }
+    , fn{ fn.is_nil() ? nullptr : fn.data }
   {
   }
 
   object_ref lazy_sequence::seq() const
   {
-    realize();
-    return s;
+    auto const s{ realized.load(std::memory_order_acquire) };
+    if(s)
+    {
+      return s;
+    }
+    return realize();
   }
 
   lazy_sequence_ref lazy_sequence::fresh_seq() const
   {
-    realize();
+    auto const s{ seq() };
     if(s.is_nil())
     {
       return {};
@@ -43,7 +48,7 @@ namespace jank::runtime::obj
 
   object_ref lazy_sequence::first() const
   {
-    realize();
+    auto const s{ seq() };
     if(s.is_nil())
     {
       return s;
@@ -53,7 +58,7 @@ namespace jank::runtime::obj
 
   object_ref lazy_sequence::next() const
   {
-    realize();
+    auto const s{ seq() };
     if(s.is_nil())
     {
       return {};
@@ -97,57 +102,91 @@ namespace jank::runtime::obj
     return make_box<cons>(head, seq());
   }
 
-  void lazy_sequence::realize() const
+  void lazy_sequence::lock() const
   {
-    /* TODO: Lock. */
-    force();
-    if(sv.is_some())
+    auto const self{ std::this_thread::get_id() };
+    std::thread::id expected{};
+    while(!owner.compare_exchange_weak(expected,
+                                       self,
+                                       std::memory_order_acquire,
+                                       std::memory_order_relaxed))
     {
-      auto ls{ sv };
-      sv = jank_nil;
-      if(ls.is_some() && ls->type == object_type::lazy_sequence)
+      if(expected == self)
       {
-        ls = unwrap(ls);
+        throw std::runtime_error{ "A lazy sequence can't be realized within its own body." };
       }
-      s = runtime::seq(ls);
+      if(expected != std::thread::id{})
+      {
+        owner.wait(expected, std::memory_order_relaxed);
+      }
+      expected = {};
     }
   }
 
-  void lazy_sequence::force() const
+  void lazy_sequence::unlock() const
   {
-    if(fn.is_some())
-    {
-      sv = dynamic_call(fn);
-      fn = jank_nil;
-    }
+    owner.store({}, std::memory_order_release);
+    owner.notify_all();
   }
 
-  void lazy_sequence::lock_and_force() const
+  object_ref lazy_sequence::realize() const
   {
-    /* TODO: Lock */
+    lock();
+    util::scope_exit const done{ [this] { unlock(); } };
+
+    /* Another thread may have realized this while we were waiting on it. */
+    auto const s{ realized.load(std::memory_order_relaxed) };
+    if(s)
+    {
+      return s;
+    }
+
     force();
-  }
 
-  object_ref lazy_sequence::sval() const
-  {
-    if(fn.is_some())
+    /* A lazy seq may give us another lazy seq, which may give us another, and so on. We
+     * only force each of those here, rather than realizing them, so that a long chain of
+     * them doesn't need a deep stack. */
+    auto ls{ sv };
+    while(ls->type == object_type::lazy_sequence)
     {
-      lock_and_force();
+      ls = expect_object<lazy_sequence>(ls)->sval();
     }
-    if(sv.is_some())
+    object_ref const ret{ runtime::seq(ls) };
+
+    sv = jank_nil;
+    realized.store(ret.data, std::memory_order_release);
+    return ret;
+  }
+
+  void lazy_sequence::force() const
+  {
+    auto const f{ fn.load(std::memory_order_relaxed) };
+    if(f)
     {
-      return sv;
+      sv = dynamic_call(f);
+      fn.store(nullptr, std::memory_order_release);
     }
-    return s;
   }
 
-  object_ref lazy_sequence::unwrap(object_ref ls) const
+  object_ref lazy_sequence::sval() const
   {
-    while(ls.is_some() && ls->type == object_type::lazy_sequence)
+    auto const s{ realized.load(std::memory_order_acquire) };
+    if(s)
     {
-      ls = expect_object<lazy_sequence>(ls)->sval();
+      return s;
     }
-    return ls;
+
+    lock();
+    util::scope_exit const done{ [this] { unlock(); } };
+
+    auto const locked_s{ realized.load(std::memory_order_relaxed) };
+    if(locked_s)
+    {
+      return locked_s;
+    }
+
+    force();
+    return sv;
   }
 
   lazy_sequence_ref lazy_sequence::with_meta(object_ref const m) const
@@ -157,4 +196,9 @@ namespace jank::runtime::obj
     ret->meta = meta;
     return ret;
   }
+
+  bool lazy_sequence::is_realized() const
+  {
+    return fn.load(std::memory_order_acquire) == nullptr;
+  }
 }
@@ -225,4 +225,28 @@ namespace jank::runtime
   obj::boolean_ref jank_true{ true_const() };
   /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
   obj::boolean_ref jank_false{ false_const() };
+
+  namespace detail
+  {
+    static constexpr auto make_integer_cache()
+    {
+      std::remove_const_t<decltype(integer_cache)> ret{};
+      for(usize i{}; i < ret.size(); ++i)
+      {
+        ret[i].data = integer_cache_min + static_cast<i64>(i);
+      }
+      return ret;
+    }
+
+    static constexpr obj::real make_real(f64 const d)
+    {
+      obj::real ret{};
+      ret.data = d;
+      return ret;
+    }
+
+    constexpr std::remove_const_t<decltype(integer_cache)> integer_cache{ make_integer_cache() };
+    constexpr obj::real real_zero{ make_real(0.0) };
+    constexpr obj::real real_one{ make_real(1.0) };
+  }
 }
@@ -115,6 +115,19 @@ namespace jank::runtime::obj
     return make_box<persistent_sorted_set_sequence>(this, data.begin(), data.end(), data.size());
   }
 
+  object_ref persistent_sorted_set::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    for(auto const e : data)
+    {
+      if(!reduce_step(acc, f, e))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
+
   usize persistent_sorted_set::count() const
   {
     return data.size();
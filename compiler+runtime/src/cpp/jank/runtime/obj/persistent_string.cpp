@@ -2,6 +2,7 @@
 #include <jank/runtime/obj/persistent_string_sequence.hpp>
 #include <jank/runtime/rtti.hpp>
 #include <jank/runtime/core/make_box.hpp>
+#include <jank/runtime/core/seq.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/util/escape.hpp>
 #include <jank/util/fmt.hpp>
@@ -186,4 +187,17 @@ namespace jank::runtime::obj
     }
     return make_box<persistent_string_sequence>(const_cast<persistent_string *>(this));
   }
+
+  object_ref persistent_string::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    for(auto const c : data)
+    {
+      if(!reduce_step(acc, f, make_box(c)))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
 }
@@ -1,3 +1,5 @@
+#include <immer/algorithm.hpp>
+
 #include <jank/runtime/obj/persistent_vector.hpp>
 #include <jank/runtime/obj/transient_vector.hpp>
 #include <jank/runtime/visit.hpp>
@@ -164,6 +166,22 @@ namespace jank::runtime::obj
     return make_box<persistent_vector_sequence>(const_cast<persistent_vector *>(this));
   }
 
+  object_ref persistent_vector::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    immer::for_each_chunk_p(data, [&](auto const first, auto const last) {
+      for(auto it{ first }; it != last; ++it)
+      {
+        if(!reduce_step(acc, f, *it))
+        {
+          return false;
+        }
+      }
+      return true;
+    });
+    return acc;
+  }
+
   usize persistent_vector::count() const
   {
     return data.size();
@@ -1,5 +1,8 @@
+#include <immer/algorithm.hpp>
+
 #include <jank/runtime/obj/persistent_vector_sequence.hpp>
 #include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core.hpp>
 #include <jank/runtime/core/seq_ext.hpp>
 
@@ -87,6 +90,26 @@ namespace jank::runtime::obj
     return make_box<persistent_vector_sequence>(vec, index);
   }
 
+  /* behavior::reducible */
+  object_ref persistent_vector_sequence::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    immer::for_each_chunk_p(
+      vec->data.begin() + static_cast<decltype(persistent_vector::data)::difference_type>(index),
+      vec->data.end(),
+      [&](auto const first, auto const last) {
+        for(auto it{ first }; it != last; ++it)
+        {
+          if(!reduce_step(acc, f, *it))
+          {
+            return false;
+          }
+        }
+        return true;
+      });
+    return acc;
+  }
+
   /* behavior::sequenceable */
   object_ref persistent_vector_sequence::first() const
   {
@@ -118,6 +141,43 @@ namespace jank::runtime::obj
     return this;
   }
 
+  /* Our chunks line up with the vector's leaves, so building one is a single copy out of a
+   * leaf array. Only the first chunk may be partial, if we started part way into a leaf. */
+  template <typename F>
+  static void visit_leaf(persistent_vector_ref const vec, usize const index, F const &fn)
+  {
+    immer::for_each_chunk_p(
+      vec->data.begin() + static_cast<decltype(persistent_vector::data)::difference_type>(index),
+      vec->data.end(),
+      [&](auto const first, auto const last) {
+        fn(first, last);
+        return false;
+      });
+  }
+
+  /* behavior::chunkable */
+  array_chunk_ref persistent_vector_sequence::chunked_first() const
+  {
+    native_vector<object_ref> buffer;
+    visit_leaf(vec, index, [&](auto const first, auto const last) { buffer.assign(first, last); });
+    return make_box<array_chunk>(std::move(buffer), 0);
+  }
+
+  persistent_vector_sequence_ref persistent_vector_sequence::chunked_next() const
+  {
+    auto n(index);
+    visit_leaf(vec, index, [&](auto const first, auto const last) {
+      n += static_cast<usize>(last - first);
+    });
+
+    if(n == vec->data.size())
+    {
+      return {};
+    }
+
+    return make_box<persistent_vector_sequence>(vec, n);
+  }
+
   cons_ref persistent_vector_sequence::conj(object_ref const head)
   {
     return make_box<cons>(head, this);
@@ -0,0 +1,94 @@
+#include <jank/runtime/obj/promise.hpp>
+#include <jank/runtime/core/math.hpp>
+#include <jank/runtime/thread_pool.hpp>
+#include <jank/util/fmt.hpp>
+
+namespace jank::runtime::obj
+{
+  bool promise::equal(object const &o) const
+  {
+    return &o == &base;
+  }
+
+  jtl::immutable_string promise::to_string() const
+  {
+    jtl::string_builder buff;
+    to_string(buff);
+    return buff.release();
+  }
+
+  void promise::to_string(jtl::string_builder &buff) const
+  {
+    util::format_to(buff, "#object [{} {}]", object_type_str(base.type), &base);
+  }
+
+  jtl::immutable_string promise::to_code_string() const
+  {
+    return to_string();
+  }
+
+  uhash promise::to_hash() const
+  {
+    return static_cast<uhash>(reinterpret_cast<uintptr_t>(this));
+  }
+
+  object_ref promise::deref()
+  {
+    /* A pool worker waiting on a promise keeps the pool busy, in case the delivery is
+     * queued up behind it. */
+    auto &pool{ thread_pool::shared() };
+    if(pool.is_worker())
+    {
+      pool.help_until([this] { return is_realized(); });
+      std::lock_guard const lock{ mutex };
+      return val;
+    }
+
+    std::unique_lock lock{ mutex };
+    delivery.wait(lock, [this] { return delivered; });
+    return val;
+  }
+
+  object_ref promise::deref(object_ref const timeout_ms, object_ref const timeout_val)
+  {
+    auto const deadline{ std::chrono::steady_clock::now()
+                         + std::chrono::milliseconds{ to_int(timeout_ms) } };
+
+    auto &pool{ thread_pool::shared() };
+    if(pool.is_worker())
+    {
+      pool.help_until(
+        [&] { return is_realized() || std::chrono::steady_clock::now() >= deadline; });
+      std::lock_guard const lock{ mutex };
+      return delivered ? val : timeout_val;
+    }
+
+    std::unique_lock lock{ mutex };
+    if(!delivery.wait_until(lock, deadline, [this] { return delivered; }))
+    {
+      return timeout_val;
+    }
+    return val;
+  }
+
+  bool promise::is_realized() const
+  {
+    std::lock_guard const lock{ mutex };
+    return delivered;
+  }
+
+  bool promise::deliver(object_ref const o)
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      if(delivered)
+      {
+        return false;
+      }
+      val = o;
+      delivered = true;
+    }
+    delivery.notify_all();
+    return true;
+  }
+}
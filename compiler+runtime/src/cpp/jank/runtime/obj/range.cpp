@@ -112,6 +112,19 @@ namespace jank::runtime::obj
     return make_box<range>(start, end, step, bounds_check);
   }
 
+  object_ref range::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    for(object_ref val{ start }; !bounds_check(val, end); val = add(val, step))
+    {
+      if(!reduce_step(acc, f, val))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
+
   object_ref range::first() const
   {
     return start;
@@ -6,7 +6,7 @@ namespace jank::runtime::obj
 {
   re_matcher::re_matcher(re_pattern_ref const re, jtl::immutable_string const &s)
     : re{ re }
-    , match_input{ s.c_str() }
+    , match_input{ s }
   {
   }
 
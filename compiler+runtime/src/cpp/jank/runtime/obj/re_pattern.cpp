@@ -6,7 +6,7 @@ namespace jank::runtime::obj
 
   re_pattern::re_pattern(jtl::immutable_string const &s)
     : pattern{ s }
-    , regex{ s.c_str(), std::regex_constants::ECMAScript }
+    , regex{ s }
   {
   }
 
@@ -51,6 +51,28 @@ namespace jank::runtime::obj
     return make_box<repeat>(count, value);
   }
 
+  object_ref repeat::reduce(object_ref const f, object_ref const init) const
+  {
+    object_ref acc{ init };
+    if(runtime::equal(count, make_box(infinite)))
+    {
+      while(reduce_step(acc, f, value))
+      {
+      }
+      return acc;
+    }
+
+    auto const n{ to_int(count) };
+    for(i64 i{}; i < n; ++i)
+    {
+      if(!reduce_step(acc, f, value))
+      {
+        break;
+      }
+    }
+    return acc;
+  }
+
   object_ref repeat::first() const
   {
     return value;
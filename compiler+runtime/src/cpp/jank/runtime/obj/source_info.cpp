@@ -0,0 +1,112 @@
+#include <jank/runtime/obj/source_info.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/nil.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/core/make_box.hpp>
+#include <jank/runtime/core/equal.hpp>
+
+namespace jank::runtime::obj
+{
+  static persistent_array_map_ref position_to_map(read::source_position const &pos)
+  {
+    return persistent_array_map::create_unique(__rt_ctx->intern_keyword("offset").expect_ok(),
+                                               make_box(pos.offset),
+                                               __rt_ctx->intern_keyword("line").expect_ok(),
+                                               make_box(pos.line),
+                                               __rt_ctx->intern_keyword("col").expect_ok(),
+                                               make_box(pos.col));
+  }
+
+  source_info::source_info(object_ref const file,
+                           read::source_position const &start,
+                           read::source_position const &end)
+    : file{ file }
+    , start{ start }
+    , end{ end }
+  {
+  }
+
+  bool source_info::equal(object const &o) const
+  {
+    if(o.type == object_type::source_info)
+    {
+      auto const s(expect_object<source_info>(&o));
+      return runtime::equal(file, s->file) && start == s->start && end == s->end;
+    }
+
+    return to_map()->equal(o);
+  }
+
+  void source_info::to_string(jtl::string_builder &buff) const
+  {
+    to_map()->to_string(buff);
+  }
+
+  jtl::immutable_string source_info::to_string() const
+  {
+    return to_map()->to_string();
+  }
+
+  jtl::immutable_string source_info::to_code_string() const
+  {
+    return to_map()->to_code_string();
+  }
+
+  uhash source_info::to_hash() const
+  {
+    return to_map()->to_hash();
+  }
+
+  object_ref source_info::get(object_ref const key, object_ref const fallback) const
+  {
+    if(__rt_ctx->intern_keyword("file").expect_ok() == key)
+    {
+      return file;
+    }
+    if(__rt_ctx->intern_keyword("start").expect_ok() == key)
+    {
+      return position_to_map(start);
+    }
+    if(__rt_ctx->intern_keyword("end").expect_ok() == key)
+    {
+      return position_to_map(end);
+    }
+
+    return fallback;
+  }
+
+  object_ref source_info::get(object_ref const key) const
+  {
+    return get(key, jank_nil);
+  }
+
+  object_ref source_info::get_entry(object_ref const key) const
+  {
+    if(!contains(key))
+    {
+      return jank_nil;
+    }
+
+    return make_box<persistent_vector>(std::in_place, key, get(key));
+  }
+
+  bool source_info::contains(object_ref const key) const
+  {
+    return __rt_ctx->intern_keyword("file").expect_ok() == key
+      || __rt_ctx->intern_keyword("start").expect_ok() == key
+      || __rt_ctx->intern_keyword("end").expect_ok() == key;
+  }
+
+  persistent_array_map_ref source_info::to_map() const
+  {
+    return persistent_array_map::create_unique(__rt_ctx->intern_keyword("file").expect_ok(),
+                                               file,
+                                               __rt_ctx->intern_keyword("start").expect_ok(),
+                                               position_to_map(start),
+                                               __rt_ctx->intern_keyword("end").expect_ok(),
+                                               position_to_map(end));
+  }
+}
@@ -1,5 +1,10 @@
 #include <jank/runtime/object.hpp>
 #include <jank/runtime/core/equal.hpp>
+#include <jank/runtime/core/seq.hpp>
+#include <jank/runtime/behavior/map_like.hpp>
+#include <jank/runtime/behavior/metadatable.hpp>
+#include <jank/runtime/behavior/sequential.hpp>
+#include <jank/runtime/behavior/set_like.hpp>
 #include <jank/runtime/visit.hpp>
 #include <jank/hash.hpp>
 
@@ -7,11 +12,72 @@ namespace jank::runtime
 {
   bool very_equal_to::operator()(object_ref const lhs, object_ref const rhs) const noexcept
   {
-    if(lhs->type != rhs->type)
+    if(lhs->type != rhs->type || !equal(lhs, rhs))
     {
       return false;
     }
-    return equal(lhs, rhs);
+
+    /* equal ignores meta and doesn't check the types of anything within a collection, so we
+     * need to check those ourselves, all the way down. */
+    return visit_object(
+      [&](auto const typed_lhs) -> bool {
+        using T = typename decltype(typed_lhs)::value_type;
+        auto const typed_rhs{ expect_object<T>(rhs) };
+
+        if constexpr(behavior::metadatable<T>)
+        {
+          auto const &l{ typed_lhs->meta };
+          auto const &r{ typed_rhs->meta };
+          if(l.is_some() != r.is_some() || (l.is_some() && !(*this)(l.unwrap(), r.unwrap())))
+          {
+            return false;
+          }
+        }
+
+        if constexpr(behavior::map_like<T>)
+        {
+          for(auto it{ fresh_seq(lhs) }; it.is_some(); it = next(it))
+          {
+            auto const entry{ first(it) };
+            auto const other{ find(rhs, first(entry)) };
+            if(!(*this)(first(entry), first(other)) || !(*this)(second(entry), second(other)))
+            {
+              return false;
+            }
+          }
+        }
+        else if constexpr(behavior::set_like<T>)
+        {
+          /* Any item in rhs may equal this one, so we need to look at each. */
+          for(auto it{ fresh_seq(lhs) }; it.is_some(); it = next(it))
+          {
+            auto const item{ first(it) };
+            auto found{ false };
+            for(auto other{ fresh_seq(rhs) }; !found && other.is_some(); other = next(other))
+            {
+              found = (*this)(item, first(other));
+            }
+            if(!found)
+            {
+              return false;
+            }
+          }
+        }
+        else if constexpr(behavior::sequential<T>)
+        {
+          /* These are already known to be equal, so they have the same length. */
+          for(auto l{ fresh_seq(lhs) }, r{ fresh_seq(rhs) }; l.is_some(); l = next(l), r = next(r))
+          {
+            if(!(*this)(first(l), first(r)))
+            {
+              return false;
+            }
+          }
+        }
+
+        return true;
+      },
+      lhs);
   }
 
   bool operator==(object const * const lhs, object_ref const rhs)
@@ -1,10 +1,12 @@
 #include <nanobench.h>
+#include <gc/gc.h>
 
 #include <jank/runtime/perf.hpp>
 #include <jank/runtime/visit.hpp>
 #include <jank/runtime/context.hpp>
 #include <jank/runtime/core/seq.hpp>
 #include <jank/util/fmt.hpp>
+#include <jank/util/fmt/print.hpp>
 
 namespace jank::runtime::perf
 {
@@ -37,6 +39,15 @@ namespace jank::runtime::perf
             auto const res(typed_f->call());
             ankerl::nanobench::doNotOptimizeAway(res);
           });
+
+          /* nanobench only knows about time, but GC pressure is often what we're after.
+           * A single extra call is enough to see how much it allocates. */
+          auto const bytes_before(GC_get_total_bytes());
+          auto const res(typed_f->call());
+          ankerl::nanobench::doNotOptimizeAway(res);
+          util::println("{} allocated {} bytes per call",
+                        label,
+                        GC_get_total_bytes() - bytes_before);
         }
         else
         {
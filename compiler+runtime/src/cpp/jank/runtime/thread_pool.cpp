@@ -0,0 +1,290 @@
+#include <gc/gc.h>
+
+#include <jank/runtime/thread_pool.hpp>
+#include <jank/error.hpp>
+#include <jank/util/fmt/print.hpp>
+#include <jank/util/try.hpp>
+
+namespace jank::runtime
+{
+  struct current_worker_info
+  {
+    thread_pool *pool{};
+    usize index{};
+  };
+
+  static thread_local current_worker_info current_worker;
+
+  /* Our threads register themselves with the GC, which is only allowed once the GC knows
+   * to expect it. This needs to be called from an already registered thread. */
+  template <typename F>
+  static std::thread start_gc_thread(F &&f)
+  {
+    GC_allow_register_threads();
+    return std::thread{ [f = std::forward<F>(f)] {
+      GC_stack_base sb{};
+      GC_get_stack_base(&sb);
+      GC_register_my_thread(&sb);
+      f();
+      GC_unregister_my_thread();
+    } };
+  }
+
+  thread_pool::thread_pool(usize const thread_count)
+  {
+    workers.reserve(thread_count);
+    for(usize i{}; i < thread_count; ++i)
+    {
+      workers.emplace_back(new worker{});
+    }
+
+    threads.reserve(thread_count);
+    for(usize i{}; i < thread_count; ++i)
+    {
+      threads.emplace_back(start_gc_thread([this, i] { run_worker(i); }));
+    }
+  }
+
+  thread_pool::~thread_pool()
+  {
+    shutdown();
+
+    for(auto &thread : threads)
+    {
+      if(thread.get_id() == std::this_thread::get_id())
+      {
+        thread.detach();
+      }
+      else if(thread.joinable())
+      {
+        thread.join();
+      }
+    }
+  }
+
+  void thread_pool::submit(task * const t)
+  {
+    /* Work spawned from within the pool stays on the same worker, which keeps related
+     * work together. Everything else is spread around. */
+    usize index{};
+    if(current_worker.pool == this)
+    {
+      index = current_worker.index;
+    }
+    else
+    {
+      std::lock_guard const lock{ mutex };
+      index = next_worker++ % workers.size();
+    }
+
+    /* The task is counted before anyone can take it, so the count never drops below the
+     * number of tasks which can be taken. */
+    {
+      std::lock_guard const lock{ mutex };
+      if(stopping)
+      {
+        throw std::runtime_error{ "Unable to submit work to a thread pool which was shut down." };
+      }
+      ++queued;
+    }
+
+    {
+      auto &w{ *workers[index] };
+      std::lock_guard const lock{ w.mutex };
+      w.tasks.push_back(t);
+    }
+    work_available.notify_one();
+  }
+
+  task *thread_pool::take_task(usize const index)
+  {
+    task *ret{};
+
+    /* Our own work first, newest first, since it's the most likely to still be in cache. */
+    {
+      auto &w{ *workers[index] };
+      std::lock_guard const lock{ w.mutex };
+      if(!w.tasks.empty())
+      {
+        ret = w.tasks.back();
+        w.tasks.pop_back();
+      }
+    }
+
+    /* Then we steal the oldest work from everyone else. */
+    for(usize i{ 1 }; !ret && i < workers.size(); ++i)
+    {
+      auto &w{ *workers[(index + i) % workers.size()] };
+      std::lock_guard const lock{ w.mutex };
+      if(!w.tasks.empty())
+      {
+        ret = w.tasks.front();
+        w.tasks.pop_front();
+      }
+    }
+
+    if(ret)
+    {
+      std::lock_guard const lock{ mutex };
+      --queued;
+    }
+    return ret;
+  }
+
+  static void run_task(task * const t)
+  {
+    /* Tasks are meant to handle their own errors. If one gets through, we can't let it
+     * take down the worker. */
+    JANK_TRY
+    {
+      t->run();
+    }
+    JANK_CATCH(util::print_exception)
+    catch(...)
+    {
+      util::println(stderr, "Uncaught exception in thread pool task");
+    }
+  }
+
+  void thread_pool::notify_task_done()
+  {
+    task_done.notify_all();
+  }
+
+  void thread_pool::run_worker(usize const index)
+  {
+    current_worker = { this, index };
+
+    while(true)
+    {
+      auto const t{ take_task(index) };
+      if(t)
+      {
+        run_task(t);
+        notify_task_done();
+        continue;
+      }
+
+      /* Once we're stopping, we still run everything which was already queued. */
+      std::unique_lock lock{ mutex };
+      work_available.wait(lock, [this] { return stopping || queued != 0; });
+      if(stopping && queued == 0)
+      {
+        return;
+      }
+    }
+  }
+
+  void thread_pool::help_until(std::function<bool()> const &done)
+  {
+    auto const is_worker{ current_worker.pool == this };
+    while(!done())
+    {
+      if(is_worker)
+      {
+        auto const t{ take_task(current_worker.index) };
+        if(t)
+        {
+          run_task(t);
+          notify_task_done();
+          continue;
+        }
+      }
+
+      /* Whatever we're waiting on may be completed by a thread outside of the pool, which
+       * won't notify us, so we don't wait for too long. */
+      std::unique_lock lock{ mutex };
+      task_done.wait_for(lock, std::chrono::milliseconds{ 1 });
+    }
+  }
+
+  void thread_pool::shutdown()
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      if(stopping)
+      {
+        return;
+      }
+      stopping = true;
+    }
+    work_available.notify_all();
+  }
+
+  usize thread_pool::size() const
+  {
+    return workers.size();
+  }
+
+  bool thread_pool::is_worker() const
+  {
+    return current_worker.pool == this;
+  }
+
+  thread_pool &thread_pool::shared()
+  {
+    /* This lives in static storage, which the GC scans, so our queues are visible to it. */
+    static thread_pool pool{ std::max(1u, std::thread::hardware_concurrency()) };
+    return pool;
+  }
+
+  elastic_thread_pool::elastic_thread_pool(std::chrono::milliseconds const idle_timeout)
+    : idle_timeout{ idle_timeout }
+  {
+  }
+
+  void elastic_thread_pool::submit(task * const t)
+  {
+    std::lock_guard const lock{ mutex };
+    if(stopping)
+    {
+      throw std::runtime_error{ "Unable to submit work to a thread pool which was shut down." };
+    }
+
+    tasks.push_back(t);
+
+    /* Every queued task needs its own idle thread, or else it could end up waiting
+     * behind something which blocks. */
+    if(tasks.size() > idle)
+    {
+      start_gc_thread([this] { run_thread(); }).detach();
+    }
+    else
+    {
+      work_available.notify_one();
+    }
+  }
+
+  void elastic_thread_pool::run_thread()
+  {
+    std::unique_lock lock{ mutex };
+    while(true)
+    {
+      ++idle;
+      work_available.wait_for(lock, idle_timeout, [this] { return stopping || !tasks.empty(); });
+      --idle;
+
+      /* Once we're stopping, we still run everything which was already queued. */
+      if(tasks.empty())
+      {
+        break;
+      }
+
+      auto const t{ tasks.front() };
+      tasks.pop_front();
+
+      lock.unlock();
+      run_task(t);
+      lock.lock();
+    }
+  }
+
+  void elastic_thread_pool::shutdown()
+  {
+    {
+      std::lock_guard const lock{ mutex };
+      stopping = true;
+    }
+    work_available.notify_all();
+  }
+}
@@ -16,14 +16,14 @@ namespace jank::runtime
   var::var(ns_ref const &n, obj::symbol_ref const &name)
     : n{ n }
     , name{ name }
-    , root{ make_box<var_unbound_root>(this) }
+    , root{ make_box<var_unbound_root>(this).erase().data }
   {
   }
 
   var::var(ns_ref const &n, obj::symbol_ref const &name, object_ref const root)
     : n{ n }
     , name{ name }
-    , root{ root }
+    , root{ root.data }
   {
   }
 
@@ -34,7 +34,7 @@ namespace jank::runtime
            bool const thread_bound)
     : n{ n }
     , name{ name }
-    , root{ root }
+    , root{ root.data }
     , dynamic{ dynamic }
     , thread_bound{ thread_bound }
   {
@@ -101,21 +101,24 @@ namespace jank::runtime
   object_ref var::get_root() const
   {
     profile::timer const timer{ "var get_root" };
-    return *root.rlock();
+    return root.load(std::memory_order_acquire);
   }
 
   var_ref var::bind_root(object_ref const r)
   {
     profile::timer const timer{ "var bind_root" };
-    *root.wlock() = r;
+    std::lock_guard<std::recursive_mutex> const lock{ root_write_mutex };
+    root.store(r.data, std::memory_order_release);
     return this;
   }
 
+  /* Unlike atom::swap, f is called exactly once, since other writers wait on us. */
   object_ref var::alter_root(object_ref const f, object_ref const args)
   {
-    auto locked_root(root.wlock());
-    *locked_root = apply_to(f, cons(*locked_root, args));
-    return *locked_root;
+    std::lock_guard<std::recursive_mutex> const lock{ root_write_mutex };
+    auto const next(apply_to(f, cons(root.load(std::memory_order_acquire), args)));
+    root.store(next.data, std::memory_order_release);
+    return next;
   }
 
   jtl::string_result<void> var::set(object_ref const r) const
@@ -150,20 +153,34 @@ namespace jank::runtime
       return {};
     }
 
-    auto &tbfs(__rt_ctx->thread_binding_frames[__rt_ctx]);
-    if(tbfs.empty())
+    auto const slot(binding_slot.load(std::memory_order_acquire));
+    auto const &slots(context::thread_bindings.slots);
+    if(slots.size() <= slot)
     {
       return {};
     }
 
-    auto const found(tbfs.front().bindings->get_entry(this));
-    if(found.is_nil())
+    return slots[slot].binding;
+  }
+
+  usize var::get_binding_slot()
+  {
+    /* NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables) */
+    static std::atomic<usize> next_slot{ 1 };
+
+    auto slot(binding_slot.load(std::memory_order_acquire));
+    if(slot)
     {
-      return {};
+      return slot;
     }
 
-    auto const ret(expect_object<obj::persistent_vector>(found)->data[1]);
-    return expect_object<var_thread_binding>(ret);
+    /* If we race with another thread here, one of the slots is just never used. */
+    auto const new_slot(next_slot.fetch_add(1));
+    if(binding_slot.compare_exchange_strong(slot, new_slot, std::memory_order_acq_rel))
+    {
+      return new_slot;
+    }
+    return slot;
   }
 
   object_ref var::deref() const
@@ -173,7 +190,7 @@ namespace jank::runtime
     {
       return binding->value;
     }
-    return *root.rlock();
+    return root.load(std::memory_order_acquire);
   }
 
   var_ref var::clone() const
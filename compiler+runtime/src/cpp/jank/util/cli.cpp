@@ -35,6 +35,31 @@ namespace jank::util::cli
       ->default_str(make_default(opts.profiler_file));
     cli.add_flag("--perf", opts.perf_profiling_enabled, "Enable Linux perf event sampling.");
     cli.add_flag("--gc-incremental", opts.gc_incremental, "Enable incremental GC collection.");
+    cli
+      .add_option("--gc-initial-heap",
+                  opts.gc_initial_heap,
+                  "The initial GC heap size, in bytes. Accepts suffixes like KB, MB, and GB.")
+      ->transform(CLI::AsSizeValue(false));
+    cli
+      .add_option("--gc-max-heap",
+                  opts.gc_max_heap,
+                  "The maximum GC heap size, in bytes. Allocations fail beyond this. Accepts "
+                  "suffixes like KB, MB, and GB.")
+      ->transform(CLI::AsSizeValue(false))
+      ->default_str(make_default("unlimited"));
+    cli
+      .add_option("--gc-free-space-divisor",
+                  opts.gc_free_space_divisor,
+                  "Collect once roughly heap size / N bytes have been allocated since the last "
+                  "collection. Higher values collect more often, with a smaller heap.")
+      ->check(CLI::PositiveNumber)
+      ->default_str(make_default("3"));
+    cli
+      .add_option("--gc-markers",
+                  opts.gc_markers,
+                  "The number of parallel GC marker threads, including the main thread.")
+      ->check(CLI::PositiveNumber)
+      ->default_str(make_default("number of cores"));
     cli.add_flag("--debug", opts.debug, "Enable debug symbol generation for generated code.");
     cli.add_flag("--direct-call",
                  opts.direct_call,
@@ -42,9 +67,14 @@ namespace jank::util::cli
     cli
       .add_option("-O,--optimization",
                   opts.optimization_level,
-                  "The optimization level to use for AOT compilation.")
+                  "The optimization level to use for JIT and AOT compilation.")
       /* TODO: This does not validate. */
-      ->check(CLI::Range(0, 3));
+      ->check(CLI::Range(0, 3))
+      ->default_str(make_default(std::to_string(opts.optimization_level)));
+    cli.add_flag("--tiered-compilation",
+                 opts.tiered_compilation,
+                 "JIT compile at -O0 first, then recompile hot functions at the chosen "
+                 "optimization level in the background.");
 
     std::map<std::string, codegen_type> const codegen_types{
       { "llvm_ir", codegen_type::llvm_ir },
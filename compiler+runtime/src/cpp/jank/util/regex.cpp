@@ -0,0 +1,2697 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <jank/util/regex.hpp>
+#include <jank/util/fmt.hpp>
+
+namespace jank::util
+{
+  namespace
+  {
+    /* Invalid UTF-8 bytes decode to a code point of their own, past the end of Unicode, so
+     * that `.` and negated sets still match them, but nothing else does. */
+    constexpr u32 invalid_base{ 0x110000 };
+    constexpr u32 max_char{ invalid_base + 0xff };
+    constexpr u32 no_index{ static_cast<u32>(-1) };
+    constexpr usize npos{ regex::npos };
+    /* Guards against patterns like `(a{1000}){1000}`. */
+    constexpr usize max_program_size{ 100'000 };
+    /* A DFA which grows past this many states is thrown away and we use the Pike VM
+     * instead. That only happens for pathological patterns. */
+    constexpr usize max_dfa_states{ 4'096 };
+
+    struct decoded
+    {
+      u32 c{};
+      u8 length{};
+    };
+
+    decoded decode(std::string_view const s, usize const pos)
+    {
+      auto const b0{ static_cast<u8>(s[pos]) };
+      if(b0 < 0x80)
+      {
+        return { b0, 1 };
+      }
+
+      decoded const invalid{ invalid_base + b0, 1 };
+      u8 length{};
+      u32 c{};
+      if((b0 & 0xe0) == 0xc0)
+      {
+        length = 2;
+        c = b0 & 0x1f;
+      }
+      else if((b0 & 0xf0) == 0xe0)
+      {
+        length = 3;
+        c = b0 & 0x0f;
+      }
+      else if((b0 & 0xf8) == 0xf0)
+      {
+        length = 4;
+        c = b0 & 0x07;
+      }
+      else
+      {
+        return invalid;
+      }
+
+      if(s.size() - pos < length)
+      {
+        return invalid;
+      }
+      for(u8 i{ 1 }; i < length; ++i)
+      {
+        auto const b{ static_cast<u8>(s[pos + i]) };
+        if((b & 0xc0) != 0x80)
+        {
+          return invalid;
+        }
+        c = (c << 6) | (b & 0x3f);
+      }
+      return { c, length };
+    }
+
+    /* Decodes the code point which ends at pos. */
+    decoded decode_before(std::string_view const s, usize const pos)
+    {
+      auto start{ pos - 1 };
+      while(start > 0 && pos - start < 4 && (static_cast<u8>(s[start]) & 0xc0) == 0x80)
+      {
+        --start;
+      }
+
+      auto const d{ decode(s.substr(0, pos), start) };
+      if(start + d.length == pos)
+      {
+        return d;
+      }
+      return { invalid_base + static_cast<u8>(s[pos - 1]), 1 };
+    }
+
+    usize next_boundary(std::string_view const s, usize pos)
+    {
+      ++pos;
+      while(pos < s.size() && (static_cast<u8>(s[pos]) & 0xc0) == 0x80)
+      {
+        ++pos;
+      }
+      return pos;
+    }
+
+    void encode(u32 const c, std::string &out)
+    {
+      if(c >= invalid_base)
+      {
+        out += static_cast<char>(c - invalid_base);
+      }
+      else if(c < 0x80)
+      {
+        out += static_cast<char>(c);
+      }
+      else if(c < 0x800)
+      {
+        out += static_cast<char>(0xc0 | (c >> 6));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+      }
+      else if(c < 0x10000)
+      {
+        out += static_cast<char>(0xe0 | (c >> 12));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+      }
+      else
+      {
+        out += static_cast<char>(0xf0 | (c >> 18));
+        out += static_cast<char>(0x80 | ((c >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((c >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (c & 0x3f));
+      }
+    }
+
+    bool is_word(u32 const c)
+    {
+      return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+    bool is_line_terminator(u32 const c)
+    {
+      return c == '\n' || c == '\r' || c == 0x85 || c == 0x2028 || c == 0x2029;
+    }
+
+    bool is_digit(char const c)
+    {
+      return c >= '0' && c <= '9';
+    }
+
+    /*** Character sets. ***/
+
+    using range_set = std::vector<std::pair<u32, u32>>;
+
+    void normalize(range_set &rs)
+    {
+      std::sort(rs.begin(), rs.end());
+      range_set merged;
+      for(auto const &r : rs)
+      {
+        if(!merged.empty() && r.first <= merged.back().second + 1)
+        {
+          merged.back().second = std::max(merged.back().second, r.second);
+        }
+        else
+        {
+          merged.push_back(r);
+        }
+      }
+      rs = std::move(merged);
+    }
+
+    /* Expects a normalized set. */
+    range_set negate(range_set const &rs)
+    {
+      range_set ret;
+      u32 next{};
+      for(auto const &r : rs)
+      {
+        if(r.first > next)
+        {
+          ret.emplace_back(next, r.first - 1);
+        }
+        next = r.second + 1;
+      }
+      if(next <= max_char)
+      {
+        ret.emplace_back(next, max_char);
+      }
+      return ret;
+    }
+
+    /* Expects normalized sets. */
+    range_set intersect(range_set const &a, range_set const &b)
+    {
+      range_set ret;
+      usize i{}, j{};
+      while(i < a.size() && j < b.size())
+      {
+        auto const lo{ std::max(a[i].first, b[j].first) };
+        auto const hi{ std::min(a[i].second, b[j].second) };
+        if(lo <= hi)
+        {
+          ret.emplace_back(lo, hi);
+        }
+        if(a[i].second < b[j].second)
+        {
+          ++i;
+        }
+        else
+        {
+          ++j;
+        }
+      }
+      return ret;
+    }
+
+    /* Case insensitivity only folds ASCII, like Java does without UNICODE_CASE. */
+    void add_case_variants(range_set &rs)
+    {
+      auto const size{ rs.size() };
+      for(usize i{}; i < size; ++i)
+      {
+        auto const [lo, hi]{ rs[i] };
+        auto const add{ [&](u32 const from, u32 const to, u32 const target) {
+          auto const l{ std::max(lo, from) };
+          auto const h{ std::min(hi, to) };
+          if(l <= h)
+          {
+            rs.emplace_back(l - from + target, h - from + target);
+          }
+        } };
+        add('a', 'z', 'A');
+        add('A', 'Z', 'a');
+      }
+      normalize(rs);
+    }
+
+    struct char_set
+    {
+      char_set(range_set &&ranges)
+        : ranges{ std::move(ranges) }
+      {
+        for(auto const &r : this->ranges)
+        {
+          for(auto c{ r.first }; c <= r.second && c < 128; ++c)
+          {
+            ascii[c >> 6] |= u64{ 1 } << (c & 63);
+          }
+        }
+      }
+
+      bool contains(u32 const c) const
+      {
+        if(c < 128)
+        {
+          return (ascii[c >> 6] >> (c & 63)) & 1;
+        }
+        auto const it{ std::upper_bound(ranges.begin(),
+                                        ranges.end(),
+                                        c,
+                                        [](u32 const v, auto const &r) { return v < r.first; }) };
+        return it != ranges.begin() && c <= std::prev(it)->second;
+      }
+
+      range_set ranges;
+      std::array<u64, 2> ascii{};
+    };
+
+    /*** Syntax tree. ***/
+
+    enum class node_kind : u8
+    {
+      empty,
+      literal,
+      set,
+      any,
+      concat,
+      alternate,
+      repeat,
+      group,
+      assertion,
+      backref,
+      look,
+      atomic
+    };
+
+    enum class assertion_kind : u8
+    {
+      text_begin,
+      text_end,
+      text_end_newline,
+      line_begin,
+      line_end,
+      word_boundary,
+      not_word_boundary
+    };
+
+    struct node
+    {
+      explicit node(node_kind const kind)
+        : kind{ kind }
+      {
+      }
+
+      node_kind kind{};
+      /* The literal char, set index, or group index. */
+      u32 value{ no_index };
+      usize min{};
+      usize max{};
+      bool greedy{ true };
+      /* Dot-all for `.`, look behind for lookaround, and case insensitivity for backrefs. */
+      bool flag{};
+      bool negated{};
+      assertion_kind assertion{};
+      std::vector<u32> children;
+    };
+
+    struct parser
+    {
+      struct flags
+      {
+        bool icase{};
+        bool multiline{};
+        bool dotall{};
+        bool comments{};
+      };
+
+      parser(std::string_view const pattern,
+             std::vector<node> &nodes,
+             std::vector<range_set> &sets)
+        : pattern{ pattern }
+        , nodes{ nodes }
+        , sets{ sets }
+      {
+      }
+
+      [[noreturn]] void fail(char const * const message) const
+      {
+        throw std::runtime_error{
+          util::format("{} near index {}: {}", message, pos, std::string{ pattern })
+        };
+      }
+
+      bool more() const
+      {
+        return pos < pattern.size();
+      }
+
+      char peek() const
+      {
+        return pattern[pos];
+      }
+
+      bool consume(char const c)
+      {
+        if(more() && peek() == c)
+        {
+          ++pos;
+          return true;
+        }
+        return false;
+      }
+
+      bool consume(std::string_view const s)
+      {
+        if(pattern.substr(pos).starts_with(s))
+        {
+          pos += s.size();
+          return true;
+        }
+        return false;
+      }
+
+      u32 add(node &&n)
+      {
+        nodes.emplace_back(std::move(n));
+        return static_cast<u32>(nodes.size() - 1);
+      }
+
+      u32 add_set(range_set &&rs)
+      {
+        node n{ node_kind::set };
+        n.value = static_cast<u32>(sets.size());
+        sets.emplace_back(std::move(rs));
+        return add(std::move(n));
+      }
+
+      u32 add_assertion(assertion_kind const kind)
+      {
+        node n{ node_kind::assertion };
+        n.assertion = kind;
+        return add(std::move(n));
+      }
+
+      u32 add_literal(u32 const c)
+      {
+        if(current.icase && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')))
+        {
+          range_set rs{ { c, c } };
+          add_case_variants(rs);
+          return add_set(std::move(rs));
+        }
+
+        node n{ node_kind::literal };
+        n.value = c;
+        return add(std::move(n));
+      }
+
+      void skip_comments()
+      {
+        if(!current.comments)
+        {
+          return;
+        }
+
+        while(more())
+        {
+          if(peek() == ' ' || peek() == '\t' || peek() == '\n' || peek() == '\r'
+             || peek() == '\f')
+          {
+            ++pos;
+          }
+          else if(peek() == '#')
+          {
+            while(more() && peek() != '\n')
+            {
+              ++pos;
+            }
+          }
+          else
+          {
+            break;
+          }
+        }
+      }
+
+      u32 parse()
+      {
+        auto const root{ parse_alternation() };
+        if(more())
+        {
+          fail("Unmatched closing ')'");
+        }
+        return root;
+      }
+
+      u32 parse_alternation()
+      {
+        std::vector<u32> alternatives{ parse_concat() };
+        while(consume('|'))
+        {
+          alternatives.push_back(parse_concat());
+        }
+
+        if(alternatives.size() == 1)
+        {
+          return alternatives[0];
+        }
+        node n{ node_kind::alternate };
+        n.children = std::move(alternatives);
+        return add(std::move(n));
+      }
+
+      u32 parse_concat()
+      {
+        std::vector<u32> items;
+        while(true)
+        {
+          skip_comments();
+          if(!more() || peek() == '|' || peek() == ')')
+          {
+            break;
+          }
+
+          auto const atom{ parse_atom() };
+          /* Inline flags, like (?i), don't match anything themselves. */
+          if(atom != no_index)
+          {
+            items.push_back(parse_quantifier(atom));
+          }
+        }
+
+        if(items.size() == 1)
+        {
+          return items[0];
+        }
+        node n{ items.empty() ? node_kind::empty : node_kind::concat };
+        n.children = std::move(items);
+        return add(std::move(n));
+      }
+
+      bool parse_number(usize &out)
+      {
+        auto const start{ pos };
+        out = 0;
+        while(more() && is_digit(peek()))
+        {
+          out = out * 10 + static_cast<usize>(peek() - '0');
+          if(out > max_program_size)
+          {
+            fail("Repetition count is too large");
+          }
+          ++pos;
+        }
+        return pos != start;
+      }
+
+      u32 parse_quantifier(u32 const atom)
+      {
+        skip_comments();
+        if(!more())
+        {
+          return atom;
+        }
+
+        node n{ node_kind::repeat };
+        switch(peek())
+        {
+          case '*':
+            n.max = npos;
+            break;
+          case '+':
+            n.min = 1;
+            n.max = npos;
+            break;
+          case '?':
+            n.max = 1;
+            break;
+          case '{':
+            {
+              ++pos;
+              if(!parse_number(n.min))
+              {
+                fail("Illegal repetition");
+              }
+              n.max = n.min;
+              if(consume(',') && !parse_number(n.max))
+              {
+                n.max = npos;
+              }
+              if(!more() || peek() != '}')
+              {
+                fail("Unclosed counted closure");
+              }
+              if(n.max < n.min)
+              {
+                fail("Illegal repetition range");
+              }
+              break;
+            }
+          default:
+            return atom;
+        }
+        ++pos;
+
+        bool possessive{};
+        if(consume('?'))
+        {
+          n.greedy = false;
+        }
+        else if(consume('+'))
+        {
+          possessive = true;
+        }
+        n.children.push_back(atom);
+        auto ret{ add(std::move(n)) };
+
+        /* A possessive quantifier is just an atomic group around a greedy one. */
+        if(possessive)
+        {
+          node a{ node_kind::atomic };
+          a.children.push_back(ret);
+          ret = add(std::move(a));
+        }
+
+        skip_comments();
+        if(more() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{'))
+        {
+          fail("Dangling meta character");
+        }
+        return ret;
+      }
+
+      u32 parse_atom()
+      {
+        switch(peek())
+        {
+          case '(':
+            return parse_group();
+          case '[':
+            return add_set(parse_class());
+          case '.':
+            {
+              ++pos;
+              node n{ node_kind::any };
+              n.flag = current.dotall;
+              return add(std::move(n));
+            }
+          case '^':
+            ++pos;
+            return add_assertion(current.multiline ? assertion_kind::line_begin
+                                                   : assertion_kind::text_begin);
+          case '$':
+            ++pos;
+            return add_assertion(current.multiline ? assertion_kind::line_end
+                                                   : assertion_kind::text_end);
+          case '\\':
+            return parse_escape();
+          case '*':
+          case '+':
+          case '?':
+            fail("Dangling meta character");
+          case '{':
+            fail("Illegal repetition");
+          default:
+            {
+              auto const d{ decode(pattern, pos) };
+              pos += d.length;
+              return add_literal(d.c);
+            }
+        }
+      }
+
+      std::string parse_group_name()
+      {
+        auto const start{ pos };
+        while(more() && peek() != '>')
+        {
+          auto const c{ peek() };
+          if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (pos != start && is_digit(c))))
+          {
+            fail("Named capturing group is missing trailing '>'");
+          }
+          ++pos;
+        }
+        if(pos == start || !consume('>'))
+        {
+          fail("Named capturing group is missing trailing '>'");
+        }
+        return std::string{ pattern.substr(start, pos - start - 1) };
+      }
+
+      u32 parse_group()
+      {
+        ++pos;
+        auto const saved{ current };
+        node n{ node_kind::group };
+        if(consume('?'))
+        {
+          if(consume(':'))
+          {
+          }
+          else if(consume('='))
+          {
+            n.kind = node_kind::look;
+          }
+          else if(consume('!'))
+          {
+            n.kind = node_kind::look;
+            n.negated = true;
+          }
+          else if(consume("<="))
+          {
+            n.kind = node_kind::look;
+            n.flag = true;
+          }
+          else if(consume("<!"))
+          {
+            n.kind = node_kind::look;
+            n.flag = true;
+            n.negated = true;
+          }
+          else if(consume('>'))
+          {
+            n.kind = node_kind::atomic;
+          }
+          else if(consume('<'))
+          {
+            auto name{ parse_group_name() };
+            for(auto const &existing : names)
+            {
+              if(existing.first == name)
+              {
+                fail("Named capturing group is already defined");
+              }
+            }
+            n.value = ++group_count;
+            names.emplace_back(std::move(name), n.value);
+          }
+          else
+          {
+            auto flags{ current };
+            bool on{ true };
+            while(more() && peek() != ')' && peek() != ':')
+            {
+              switch(peek())
+              {
+                case '-':
+                  on = false;
+                  break;
+                case 'i':
+                  flags.icase = on;
+                  break;
+                case 'm':
+                  flags.multiline = on;
+                  break;
+                case 's':
+                  flags.dotall = on;
+                  break;
+                case 'x':
+                  flags.comments = on;
+                  break;
+                /* Unicode case and Unix lines only change things we don't support anyway. */
+                case 'u':
+                case 'U':
+                case 'd':
+                  break;
+                default:
+                  fail("Unknown inline modifier");
+              }
+              ++pos;
+            }
+
+            /* Flags on their own apply until the end of the enclosing group. */
+            if(consume(')'))
+            {
+              current = flags;
+              return no_index;
+            }
+            if(!consume(':'))
+            {
+              fail("Unclosed group");
+            }
+            current = flags;
+          }
+        }
+        else
+        {
+          n.value = ++group_count;
+        }
+
+        n.children.push_back(parse_alternation());
+        if(!consume(')'))
+        {
+          fail("Unclosed group");
+        }
+        current = saved;
+        return add(std::move(n));
+      }
+
+      u32 parse_hex(usize const digits)
+      {
+        u32 ret{};
+        for(usize i{}; i < digits; ++i)
+        {
+          if(!more() || !std::isxdigit(static_cast<unsigned char>(peek())))
+          {
+            fail("Illegal hexadecimal escape sequence");
+          }
+          auto const c{ peek() };
+          ret = ret * 16
+            + static_cast<u32>(is_digit(c) ? c - '0' : (std::tolower(c) - 'a' + 10));
+          ++pos;
+        }
+        return ret;
+      }
+
+      /* Expects to be just past the backslash. */
+      u32 parse_char_escape()
+      {
+        auto const c{ peek() };
+        ++pos;
+        switch(c)
+        {
+          case 't':
+            return '\t';
+          case 'n':
+            return '\n';
+          case 'r':
+            return '\r';
+          case 'f':
+            return '\f';
+          case 'a':
+            return '\a';
+          case 'e':
+            return 0x1b;
+          case '0':
+            {
+              u32 ret{};
+              usize digits{};
+              while(more() && digits < 3 && peek() >= '0' && peek() <= '7'
+                    && ret * 8 + static_cast<u32>(peek() - '0') <= 0377)
+              {
+                ret = ret * 8 + static_cast<u32>(peek() - '0');
+                ++digits;
+                ++pos;
+              }
+              if(digits == 0)
+              {
+                fail("Illegal octal escape sequence");
+              }
+              return ret;
+            }
+          case 'x':
+            {
+              if(!consume('{'))
+              {
+                return parse_hex(2);
+              }
+              u32 ret{};
+              usize digits{};
+              while(more() && peek() != '}')
+              {
+                ret = ret * 16 + parse_hex(1);
+                if(++digits > 6 || ret > 0x10ffff)
+                {
+                  fail("Hexadecimal codepoint is too big");
+                }
+              }
+              if(digits == 0 || !consume('}'))
+              {
+                fail("Unclosed hexadecimal escape sequence");
+              }
+              return ret;
+            }
+          case 'u':
+            return parse_hex(4);
+          case 'c':
+            if(!more())
+            {
+              fail("Illegal control escape sequence");
+            }
+            ++pos;
+            return static_cast<u32>(pattern[pos - 1]) ^ 64;
+          default:
+            {
+              if(std::isalnum(static_cast<unsigned char>(c)))
+              {
+                --pos;
+                fail("Illegal/unsupported escape sequence");
+              }
+              --pos;
+              auto const d{ decode(pattern, pos) };
+              pos += d.length;
+              return d.c;
+            }
+        }
+      }
+
+      range_set parse_property()
+      {
+        std::string name;
+        if(consume('{'))
+        {
+          auto const end{ pattern.find('}', pos) };
+          if(end == std::string_view::npos)
+          {
+            fail("Unclosed character family");
+          }
+          name = pattern.substr(pos, end - pos);
+          pos = end + 1;
+        }
+        else if(more())
+        {
+          name = pattern.substr(pos++, 1);
+        }
+        if(name.starts_with("Is"))
+        {
+          name = name.substr(2);
+        }
+
+        if(name == "Lower")
+        {
+          return { { 'a', 'z' } };
+        }
+        if(name == "Upper")
+        {
+          return { { 'A', 'Z' } };
+        }
+        if(name == "ASCII")
+        {
+          return { { 0, 0x7f } };
+        }
+        if(name == "Alpha")
+        {
+          return { { 'A', 'Z' }, { 'a', 'z' } };
+        }
+        if(name == "Digit")
+        {
+          return { { '0', '9' } };
+        }
+        if(name == "Alnum")
+        {
+          return { { '0', '9' }, { 'A', 'Z' }, { 'a', 'z' } };
+        }
+        if(name == "Punct")
+        {
+          return { { '!', '/' }, { ':', '@' }, { '[', '`' }, { '{', '~' } };
+        }
+        if(name == "Graph")
+        {
+          return { { '!', '~' } };
+        }
+        if(name == "Print")
+        {
+          return { { ' ', '~' } };
+        }
+        if(name == "Blank")
+        {
+          return { { '\t', '\t' }, { ' ', ' ' } };
+        }
+        if(name == "Cntrl")
+        {
+          return { { 0, 0x1f }, { 0x7f, 0x7f } };
+        }
+        if(name == "XDigit")
+        {
+          return { { '0', '9' }, { 'A', 'F' }, { 'a', 'f' } };
+        }
+        if(name == "Space")
+        {
+          return { { '\t', '\r' }, { ' ', ' ' } };
+        }
+        fail("Unsupported character property");
+      }
+
+      /* Handles escapes like \d, which stand for a set, adding them to rs. Expects to be just
+       * past the backslash. */
+      bool parse_set_escape(range_set &rs)
+      {
+        auto const c{ peek() };
+        range_set escaped;
+        switch(c)
+        {
+          case 'd':
+          case 'D':
+            escaped = { { '0', '9' } };
+            break;
+          case 'w':
+          case 'W':
+            escaped = { { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' } };
+            break;
+          case 's':
+          case 'S':
+            escaped = { { '\t', '\r' }, { ' ', ' ' } };
+            break;
+          case 'h':
+          case 'H':
+            escaped = { { '\t', '\t' },     { ' ', ' ' },       { 0xa0, 0xa0 },
+                        { 0x1680, 0x1680 }, { 0x180e, 0x180e }, { 0x2000, 0x200a },
+                        { 0x202f, 0x202f }, { 0x205f, 0x205f }, { 0x3000, 0x3000 } };
+            break;
+          case 'v':
+          case 'V':
+            escaped = { { '\n', '\r' }, { 0x85, 0x85 }, { 0x2028, 0x2029 } };
+            break;
+          case 'p':
+          case 'P':
+            ++pos;
+            escaped = parse_property();
+            --pos;
+            break;
+          default:
+            return false;
+        }
+        ++pos;
+
+        normalize(escaped);
+        if(c >= 'A' && c <= 'Z')
+        {
+          escaped = negate(escaped);
+        }
+        rs.insert(rs.end(), escaped.begin(), escaped.end());
+        return true;
+      }
+
+      u32 parse_escape()
+      {
+        ++pos;
+        if(!more())
+        {
+          fail("Unexpected internal error");
+        }
+
+        switch(peek())
+        {
+          case 'b':
+            ++pos;
+            return add_assertion(assertion_kind::word_boundary);
+          case 'B':
+            ++pos;
+            return add_assertion(assertion_kind::not_word_boundary);
+          case 'A':
+            ++pos;
+            return add_assertion(assertion_kind::text_begin);
+          case 'z':
+            ++pos;
+            return add_assertion(assertion_kind::text_end);
+          case 'Z':
+            ++pos;
+            return add_assertion(assertion_kind::text_end_newline);
+          case 'Q':
+            {
+              ++pos;
+              auto const end{ pattern.find("\\E", pos) };
+              auto const quoted{ pattern.substr(pos, end == std::string_view::npos
+                                                       ? std::string_view::npos
+                                                       : end - pos) };
+              pos = end == std::string_view::npos ? pattern.size() : end + 2;
+
+              node n{ node_kind::concat };
+              for(usize i{}; i < quoted.size();)
+              {
+                auto const d{ decode(quoted, i) };
+                n.children.push_back(add_literal(d.c));
+                i += d.length;
+              }
+              return add(std::move(n));
+            }
+          case 'k':
+            {
+              ++pos;
+              if(!consume('<'))
+              {
+                fail("\\k is not followed by '<' for named capturing group");
+              }
+              auto const name{ parse_group_name() };
+              for(auto const &existing : names)
+              {
+                if(existing.first == name)
+                {
+                  node n{ node_kind::backref };
+                  n.value = existing.second;
+                  n.flag = current.icase;
+                  return add(std::move(n));
+                }
+              }
+              fail("Named capturing group does not exist");
+            }
+          default:
+            break;
+        }
+
+        if(peek() >= '1' && peek() <= '9')
+        {
+          u32 index{ static_cast<u32>(peek() - '0') };
+          ++pos;
+          /* Like Java, we take as many digits as still make a valid group. */
+          while(more() && is_digit(peek())
+                && index * 10 + static_cast<u32>(peek() - '0') <= group_count)
+          {
+            index = index * 10 + static_cast<u32>(peek() - '0');
+            ++pos;
+          }
+          if(index > group_count)
+          {
+            fail("Backreference to a group which doesn't exist");
+          }
+
+          node n{ node_kind::backref };
+          n.value = index;
+          n.flag = current.icase;
+          return add(std::move(n));
+        }
+
+        range_set rs;
+        if(parse_set_escape(rs))
+        {
+          if(current.icase)
+          {
+            add_case_variants(rs);
+          }
+          return add_set(std::move(rs));
+        }
+        return add_literal(parse_char_escape());
+      }
+
+      range_set parse_class()
+      {
+        ++pos;
+        auto const negated{ consume('^') };
+        auto rs{ parse_class_body() };
+        if(!consume(']'))
+        {
+          fail("Unclosed character class");
+        }
+
+        if(current.icase)
+        {
+          add_case_variants(rs);
+        }
+        else
+        {
+          normalize(rs);
+        }
+        return negated ? negate(rs) : rs;
+      }
+
+      /* Stops before the closing bracket. */
+      range_set parse_class_body()
+      {
+        range_set rs;
+        bool first{ true };
+        while(true)
+        {
+          if(!more())
+          {
+            fail("Unclosed character class");
+          }
+
+          auto const c{ peek() };
+          /* Like Java, a closing bracket right at the start is literal. */
+          if(c == ']' && !first)
+          {
+            break;
+          }
+          first = false;
+
+          if(c == '[')
+          {
+            auto const nested{ parse_class() };
+            rs.insert(rs.end(), nested.begin(), nested.end());
+            continue;
+          }
+          if(consume("&&"))
+          {
+            normalize(rs);
+            auto rhs{ parse_class_body() };
+            normalize(rhs);
+            return intersect(rs, rhs);
+          }
+
+          u32 lo{};
+          if(c == '\\')
+          {
+            ++pos;
+            if(!more())
+            {
+              fail("Unclosed character class");
+            }
+            if(parse_set_escape(rs))
+            {
+              continue;
+            }
+            lo = parse_char_escape();
+          }
+          else
+          {
+            auto const d{ decode(pattern, pos) };
+            pos += d.length;
+            lo = d.c;
+          }
+
+          /* A dash is literal when it's the last thing in the class. */
+          if(pos + 1 < pattern.size() && peek() == '-' && pattern[pos + 1] != ']')
+          {
+            ++pos;
+            u32 hi{};
+            if(peek() == '\\')
+            {
+              ++pos;
+              if(!more())
+              {
+                fail("Unclosed character class");
+              }
+              hi = parse_char_escape();
+            }
+            else if(peek() == '[')
+            {
+              fail("Illegal character range");
+            }
+            else
+            {
+              auto const d{ decode(pattern, pos) };
+              pos += d.length;
+              hi = d.c;
+            }
+
+            if(hi < lo)
+            {
+              fail("Illegal character range");
+            }
+            rs.emplace_back(lo, hi);
+          }
+          else
+          {
+            rs.emplace_back(lo, lo);
+          }
+        }
+        return rs;
+      }
+
+      std::string_view pattern;
+      std::vector<node> &nodes;
+      std::vector<range_set> &sets;
+      std::vector<std::pair<std::string, u32>> names;
+      u32 group_count{};
+      usize pos{};
+      flags current{};
+    };
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    bool is_nullable(std::vector<node> const &nodes, u32 const index)
+    {
+      auto const &n{ nodes[index] };
+      switch(n.kind)
+      {
+        case node_kind::literal:
+        case node_kind::set:
+        case node_kind::any:
+          return false;
+        case node_kind::concat:
+          return std::ranges::all_of(n.children,
+                                     [&](u32 const child) { return is_nullable(nodes, child); });
+        case node_kind::alternate:
+          return std::ranges::any_of(n.children,
+                                     [&](u32 const child) { return is_nullable(nodes, child); });
+        case node_kind::repeat:
+          return n.min == 0 || is_nullable(nodes, n.children[0]);
+        case node_kind::group:
+        case node_kind::atomic:
+          return is_nullable(nodes, n.children[0]);
+        default:
+          return true;
+      }
+    }
+
+    /* The most code points the node can match, or npos if there's no limit. */
+    usize max_width(std::vector<node> const &nodes, u32 const index)
+    {
+      auto const &n{ nodes[index] };
+      switch(n.kind)
+      {
+        case node_kind::literal:
+        case node_kind::set:
+        case node_kind::any:
+          return 1;
+        case node_kind::concat:
+          {
+            usize ret{};
+            for(auto const child : n.children)
+            {
+              auto const width{ max_width(nodes, child) };
+              if(width == npos)
+              {
+                return npos;
+              }
+              ret += width;
+            }
+            return ret;
+          }
+        case node_kind::alternate:
+          {
+            usize ret{};
+            for(auto const child : n.children)
+            {
+              ret = std::max(ret, max_width(nodes, child));
+            }
+            return ret;
+          }
+        case node_kind::repeat:
+          {
+            auto const width{ max_width(nodes, n.children[0]) };
+            if(width == 0)
+            {
+              return 0;
+            }
+            if(width == npos || n.max == npos)
+            {
+              return npos;
+            }
+            return width * n.max;
+          }
+        case node_kind::group:
+        case node_kind::atomic:
+          return max_width(nodes, n.children[0]);
+        case node_kind::backref:
+          return npos;
+        default:
+          return 0;
+      }
+    }
+#pragma clang diagnostic pop
+
+    /*** Programs. ***/
+
+    enum class op : u8
+    {
+      character,
+      set,
+      any,
+      any_all,
+      split,
+      jump,
+      save,
+      mark,
+      check_progress,
+      assertion,
+      backref,
+      look,
+      atomic,
+      sub_match,
+      match
+    };
+
+    /* For a split, x is preferred over y. Lookaround and atomic groups are followed by their
+     * sub-program, which ends in a sub_match, and then continue at x. */
+    struct inst
+    {
+      inst(op const code, u8 const flags = 0, u32 const x = 0, u32 const y = 0)
+        : code{ code }
+        , flags{ flags }
+        , x{ x }
+        , y{ y }
+      {
+      }
+
+      op code{};
+      u8 flags{};
+      u32 x{};
+      u32 y{};
+    };
+
+    constexpr u8 look_behind{ 1 << 0 };
+    constexpr u8 look_negated{ 1 << 1 };
+
+    struct program
+    {
+      std::vector<inst> insts;
+      u32 start{};
+      /* Runs the program with a leading `(?s:.)*?`, so it can match anywhere. */
+      u32 unanchored_start{};
+      /* Captures come first, followed by the marks used to stop empty loops. */
+      usize capture_slots{};
+      usize slot_count{};
+      bool has_assertions{};
+      bool uses_edge{};
+      bool uses_word{};
+      bool uses_newline{};
+      bool needs_backtrack{};
+      bool dfa_compatible{ true };
+    };
+
+    struct compiler
+    {
+      u32 emit(inst const &i)
+      {
+        if(prog.insts.size() >= max_program_size)
+        {
+          throw std::runtime_error{ "Regex is too large" };
+        }
+        prog.insts.push_back(i);
+        return static_cast<u32>(prog.insts.size() - 1);
+      }
+
+      u32 pc() const
+      {
+        return static_cast<u32>(prog.insts.size());
+      }
+
+      void set_split(u32 const split, u32 const body, u32 const out, bool const greedy)
+      {
+        prog.insts[split].x = greedy ? body : out;
+        prog.insts[split].y = greedy ? out : body;
+      }
+
+      void compile(u32 const index)
+      {
+        auto const &n{ nodes[index] };
+        switch(n.kind)
+        {
+          case node_kind::empty:
+            return;
+          case node_kind::literal:
+            emit({ op::character, 0, n.value });
+            return;
+          case node_kind::set:
+            emit({ op::set, 0, n.value });
+            return;
+          case node_kind::any:
+            emit({ n.flag ? op::any_all : op::any });
+            return;
+          case node_kind::concat:
+            if(reverse)
+            {
+              for(auto it{ n.children.rbegin() }; it != n.children.rend(); ++it)
+              {
+                compile(*it);
+              }
+            }
+            else
+            {
+              for(auto const child : n.children)
+              {
+                compile(child);
+              }
+            }
+            return;
+          case node_kind::alternate:
+            {
+              std::vector<u32> jumps;
+              for(usize i{}; i + 1 < n.children.size(); ++i)
+              {
+                auto const split{ emit({ op::split }) };
+                prog.insts[split].x = pc();
+                compile(n.children[i]);
+                jumps.push_back(emit({ op::jump }));
+                prog.insts[split].y = pc();
+              }
+              compile(n.children.back());
+              for(auto const jump : jumps)
+              {
+                prog.insts[jump].x = pc();
+              }
+              return;
+            }
+          case node_kind::group:
+            if(n.value == no_index || reverse)
+            {
+              compile(n.children[0]);
+              return;
+            }
+            emit({ op::save, 0, n.value * 2 });
+            compile(n.children[0]);
+            emit({ op::save, 0, n.value * 2 + 1 });
+            return;
+          case node_kind::repeat:
+            compile_repeat(n);
+            return;
+          case node_kind::assertion:
+            prog.has_assertions = true;
+            switch(n.assertion)
+            {
+              case assertion_kind::text_begin:
+              case assertion_kind::text_end:
+                prog.uses_edge = true;
+                break;
+              case assertion_kind::line_begin:
+              case assertion_kind::line_end:
+                prog.uses_edge = true;
+                prog.uses_newline = true;
+                break;
+              case assertion_kind::word_boundary:
+              case assertion_kind::not_word_boundary:
+                prog.uses_word = true;
+                break;
+              /* This needs to see two chars ahead, which the DFA can't. */
+              case assertion_kind::text_end_newline:
+                prog.dfa_compatible = false;
+                break;
+            }
+            emit({ op::assertion, static_cast<u8>(n.assertion) });
+            return;
+          case node_kind::backref:
+            prog.needs_backtrack = true;
+            emit({ op::backref, n.flag, n.value });
+            return;
+          case node_kind::look:
+          case node_kind::atomic:
+            {
+              prog.needs_backtrack = true;
+              u8 flags{};
+              if(n.flag)
+              {
+                flags |= look_behind;
+              }
+              if(n.negated)
+              {
+                flags |= look_negated;
+              }
+
+              auto const sub{ emit(
+                { n.kind == node_kind::look ? op::look : op::atomic, flags, 0, no_index }) };
+              if(n.flag)
+              {
+                auto const width{ max_width(nodes, n.children[0]) };
+                prog.insts[sub].y = width == npos ? no_index : static_cast<u32>(width);
+              }
+              /* Lookbehind tries each start position and runs forward, so it's never
+               * reversed. */
+              auto const was_reverse{ reverse };
+              reverse = false;
+              compile(n.children[0]);
+              reverse = was_reverse;
+              emit({ op::sub_match });
+              prog.insts[sub].x = pc();
+              return;
+            }
+        }
+      }
+
+      void compile_repeat(node const &n)
+      {
+        auto const child{ n.children[0] };
+        for(usize i{}; i < n.min; ++i)
+        {
+          compile(child);
+        }
+
+        if(n.max == npos)
+        {
+          /* A loop whose body can match nothing needs to make progress on each iteration, or
+           * the backtracker would spin forever. */
+          auto const nullable{ is_nullable(nodes, child) };
+          auto const loop{ emit({ op::split }) };
+          auto const body{ pc() };
+          auto const slot{ static_cast<u32>(prog.slot_count) };
+          if(nullable)
+          {
+            ++prog.slot_count;
+            emit({ op::mark, 0, slot });
+          }
+          compile(child);
+          if(nullable)
+          {
+            emit({ op::check_progress, 0, slot });
+          }
+          emit({ op::jump, 0, loop });
+          set_split(loop, body, pc(), n.greedy);
+          return;
+        }
+
+        std::vector<u32> splits;
+        for(usize i{ n.min }; i < n.max; ++i)
+        {
+          splits.push_back(emit({ op::split }));
+          prog.insts[splits.back()].x = pc();
+          compile(child);
+        }
+        for(auto const split : splits)
+        {
+          set_split(split, prog.insts[split].x, pc(), n.greedy);
+        }
+      }
+
+      std::vector<node> const &nodes;
+      program &prog;
+      bool reverse{};
+    };
+
+    /* The reverse program only finds where a match starts, so it has no groups. */
+    program compile_program(std::vector<node> const &nodes,
+                            u32 const root,
+                            u32 const group_count,
+                            bool const reverse)
+    {
+      program prog;
+      prog.capture_slots = reverse ? 0 : (group_count + 1) * 2;
+      prog.slot_count = prog.capture_slots;
+
+      compiler c{ nodes, prog, reverse };
+      if(!reverse)
+      {
+        c.emit({ op::save, 0, 0 });
+      }
+      c.compile(root);
+      if(!reverse)
+      {
+        c.emit({ op::save, 0, 1 });
+      }
+      c.emit({ op::match });
+
+      prog.unanchored_start = c.pc();
+      auto const split{ c.emit({ op::split }) };
+      c.emit({ op::any_all });
+      c.emit({ op::jump, 0, split });
+      c.set_split(split, split + 1, prog.start, false);
+
+      if(prog.needs_backtrack)
+      {
+        prog.dfa_compatible = false;
+      }
+      return prog;
+    }
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+    bool accepts(std::vector<char_set> const &sets, inst const &i, u32 const c)
+    {
+      switch(i.code)
+      {
+        case op::character:
+          return i.x == c;
+        case op::set:
+          return sets[i.x].contains(c);
+        case op::any:
+          return !is_line_terminator(c);
+        case op::any_all:
+          return true;
+        default:
+          return false;
+      }
+    }
+#pragma clang diagnostic pop
+
+    /*** Assertions. ***/
+
+    /* What assertions need to know about a char, or an edge of the input. */
+    constexpr u8 edge_flag{ 1 << 0 };
+    constexpr u8 word_flag{ 1 << 1 };
+    constexpr u8 newline_flag{ 1 << 2 };
+
+    /* The flags of the char before a position are in the low bits and the flags of the
+     * char after it are shifted above them. */
+    constexpr u8 after_shift{ 3 };
+    constexpr u8 after_final_newline{ 1 << 6 };
+
+    u8 char_flags(u32 const c)
+    {
+      return (is_word(c) ? word_flag : 0) | (c == '\n' ? newline_flag : 0);
+    }
+
+    u8 position_flags(std::string_view const input, usize const pos)
+    {
+      u8 const before(pos == 0 ? edge_flag : char_flags(decode_before(input, pos).c));
+      u8 const after(pos == input.size() ? edge_flag : char_flags(decode(input, pos).c));
+      u8 ret(before | (after << after_shift));
+      if(pos + 1 == input.size() && input[pos] == '\n')
+      {
+        ret |= after_final_newline;
+      }
+      return ret;
+    }
+
+    bool check_assertion(assertion_kind const kind, u8 const flags)
+    {
+      auto const before{ flags };
+      auto const after{ static_cast<u8>(flags >> after_shift) };
+      switch(kind)
+      {
+        case assertion_kind::text_begin:
+          return before & edge_flag;
+        case assertion_kind::text_end:
+          return after & edge_flag;
+        case assertion_kind::text_end_newline:
+          return (after & edge_flag) || (flags & after_final_newline);
+        case assertion_kind::line_begin:
+          return before & (edge_flag | newline_flag);
+        case assertion_kind::line_end:
+          return after & (edge_flag | newline_flag);
+        case assertion_kind::word_boundary:
+          return !(before & word_flag) != !(after & word_flag);
+        case assertion_kind::not_word_boundary:
+          return !(before & word_flag) == !(after & word_flag);
+      }
+      return false;
+    }
+
+    struct sparse_set
+    {
+      void resize(usize const size)
+      {
+        dense.resize(size);
+        sparse.resize(size);
+        count = 0;
+      }
+
+      bool contains(u32 const i) const
+      {
+        auto const d{ sparse[i] };
+        return d < count && dense[d] == i;
+      }
+
+      void insert(u32 const i)
+      {
+        sparse[i] = count;
+        dense[count++] = i;
+      }
+
+      void clear()
+      {
+        count = 0;
+      }
+
+      std::vector<u32> dense;
+      std::vector<u32> sparse;
+      u32 count{};
+    };
+
+    /*** Pike VM. ***/
+
+    /* Runs every thread in lockstep, so each position of the input is only looked at once.
+     * Threads are kept in priority order, which gives us leftmost-first matching. */
+    struct pike_vm
+    {
+      struct thread_list
+      {
+        sparse_set pcs;
+        /* The slots of each thread, indexed by its pc. */
+        std::vector<usize> slots;
+      };
+
+      struct frame
+      {
+        u32 pc{};
+        /* If set, this restores a slot rather than following a pc. */
+        u32 slot{ no_index };
+        usize value{};
+      };
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+      void add_thread(program const &prog,
+                      thread_list &list,
+                      u32 const start_pc,
+                      usize const pos,
+                      u8 const flags)
+      {
+        auto const slot_count{ prog.capture_slots };
+        stack.push_back({ start_pc, no_index, 0 });
+        while(!stack.empty())
+        {
+          auto const f{ stack.back() };
+          stack.pop_back();
+          if(f.slot != no_index)
+          {
+            work[f.slot] = f.value;
+            continue;
+          }
+
+          auto pc{ f.pc };
+          while(!list.pcs.contains(pc))
+          {
+            list.pcs.insert(pc);
+            auto const &i{ prog.insts[pc] };
+            switch(i.code)
+            {
+              case op::jump:
+                pc = i.x;
+                continue;
+              case op::split:
+                stack.push_back({ i.y, no_index, 0 });
+                pc = i.x;
+                continue;
+              case op::save:
+                stack.push_back({ 0, i.x, work[i.x] });
+                work[i.x] = pos;
+                ++pc;
+                continue;
+              case op::mark:
+              case op::check_progress:
+                ++pc;
+                continue;
+              case op::assertion:
+                if(check_assertion(static_cast<assertion_kind>(i.flags), flags))
+                {
+                  ++pc;
+                  continue;
+                }
+                break;
+              default:
+                std::copy_n(work.begin(), slot_count, list.slots.begin() + pc * slot_count);
+                break;
+            }
+            break;
+          }
+        }
+      }
+#pragma clang diagnostic pop
+
+      bool run(program const &prog,
+               std::vector<char_set> const &sets,
+               std::string_view const input,
+               usize const from,
+               bool const anchored_start,
+               bool const anchored_end,
+               usize * const out)
+      {
+        auto const slot_count{ prog.capture_slots };
+        if(clist.pcs.dense.size() != prog.insts.size())
+        {
+          clist.pcs.resize(prog.insts.size());
+          nlist.pcs.resize(prog.insts.size());
+          clist.slots.resize(prog.insts.size() * slot_count);
+          nlist.slots.resize(prog.insts.size() * slot_count);
+          work.resize(slot_count);
+        }
+        clist.pcs.clear();
+
+        bool matched{};
+        auto flags{ prog.has_assertions ? position_flags(input, from) : u8{} };
+        for(auto pos{ from };;)
+        {
+          if(!matched && (!anchored_start || pos == from))
+          {
+            std::fill(work.begin(), work.end(), npos);
+            add_thread(prog, clist, prog.start, pos, flags);
+          }
+          if(clist.pcs.count == 0)
+          {
+            break;
+          }
+
+          auto const at_end{ pos == input.size() };
+          decoded const d{ at_end ? decoded{} : decode(input, pos) };
+          auto const next_pos{ pos + d.length };
+          auto const next_flags{ prog.has_assertions && !at_end ? position_flags(input, next_pos)
+                                                                : u8{} };
+
+          nlist.pcs.clear();
+          for(u32 k{}; k < clist.pcs.count; ++k)
+          {
+            auto const pc{ clist.pcs.dense[k] };
+            auto const &i{ prog.insts[pc] };
+            auto const thread_slots{ clist.slots.data() + pc * slot_count };
+            if(i.code == op::match)
+            {
+              if(anchored_end && !at_end)
+              {
+                continue;
+              }
+              std::copy_n(thread_slots, slot_count, out);
+              matched = true;
+              /* Lower priority threads are cut off. */
+              break;
+            }
+            if(!at_end && accepts(sets, i, d.c))
+            {
+              std::copy_n(thread_slots, slot_count, work.begin());
+              add_thread(prog, nlist, pc + 1, next_pos, next_flags);
+            }
+          }
+
+          if(at_end)
+          {
+            break;
+          }
+          std::swap(clist, nlist);
+          pos = next_pos;
+          flags = next_flags;
+        }
+        return matched;
+      }
+
+      thread_list clist, nlist;
+      std::vector<usize> work;
+      std::vector<frame> stack;
+    };
+
+    /*** Backtracker. ***/
+
+    /* Only used for patterns which need it, since it can take exponential time. It keeps
+     * its own stack, though, so long inputs can't overflow the native one. */
+    struct backtracker
+    {
+      struct frame
+      {
+        u32 pc{};
+        /* If set, this restores a slot to pos rather than resuming at pc. */
+        u32 slot{ no_index };
+        usize pos{};
+      };
+
+      bool matches_backref(usize const start, usize const length, usize const pos, bool icase)
+        const
+      {
+        if(input.size() - pos < length)
+        {
+          return false;
+        }
+        for(usize i{}; i < length; ++i)
+        {
+          auto a{ input[start + i] };
+          auto b{ input[pos + i] };
+          if(icase)
+          {
+            a = static_cast<char>(std::tolower(static_cast<unsigned char>(a)));
+            b = static_cast<char>(std::tolower(static_cast<unsigned char>(b)));
+          }
+          if(a != b)
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /* Keeps the slots set by a sub-match, but makes sure they're restored if we later
+       * backtrack past it. */
+      void keep_slots(std::vector<usize> const &saved, std::vector<frame> &stack)
+      {
+        for(usize k{}; k < slots.size(); ++k)
+        {
+          if(slots[k] != saved[k])
+          {
+            stack.push_back({ 0, static_cast<u32>(k), saved[k] });
+          }
+        }
+      }
+
+      /* Returns the end of the match, or npos. When required_end is set, only a match which
+       * ends there counts. */
+      usize run(u32 const start_pc, usize const start_pos, usize const required_end)
+      {
+        std::vector<frame> stack{ { start_pc, no_index, start_pos } };
+        while(!stack.empty())
+        {
+          auto const f{ stack.back() };
+          stack.pop_back();
+          if(f.slot != no_index)
+          {
+            slots[f.slot] = f.pos;
+            continue;
+          }
+
+          auto pc{ f.pc };
+          auto pos{ f.pos };
+          for(bool alive{ true }; alive;)
+          {
+            auto const &i{ prog.insts[pc] };
+            switch(i.code)
+            {
+              case op::character:
+              case op::set:
+              case op::any:
+              case op::any_all:
+                {
+                  if(pos == input.size())
+                  {
+                    alive = false;
+                    break;
+                  }
+                  auto const d{ decode(input, pos) };
+                  if(!accepts(sets, i, d.c))
+                  {
+                    alive = false;
+                    break;
+                  }
+                  pos += d.length;
+                  ++pc;
+                  break;
+                }
+              case op::split:
+                stack.push_back({ i.y, no_index, pos });
+                pc = i.x;
+                break;
+              case op::jump:
+                pc = i.x;
+                break;
+              case op::save:
+              case op::mark:
+                stack.push_back({ 0, i.x, slots[i.x] });
+                slots[i.x] = pos;
+                ++pc;
+                break;
+              case op::check_progress:
+                if(slots[i.x] == pos)
+                {
+                  alive = false;
+                  break;
+                }
+                ++pc;
+                break;
+              case op::assertion:
+                if(!check_assertion(static_cast<assertion_kind>(i.flags),
+                                    position_flags(input, pos)))
+                {
+                  alive = false;
+                  break;
+                }
+                ++pc;
+                break;
+              case op::backref:
+                {
+                  auto const start{ slots[i.x * 2] };
+                  auto const end{ slots[i.x * 2 + 1] };
+                  /* Like Java, a group which didn't match can't be referenced. */
+                  if(start == npos || end == npos
+                     || !matches_backref(start, end - start, pos, i.flags))
+                  {
+                    alive = false;
+                    break;
+                  }
+                  pos += end - start;
+                  ++pc;
+                  break;
+                }
+              case op::look:
+                {
+                  auto const saved{ slots };
+                  bool found{};
+                  if(i.flags & look_behind)
+                  {
+                    /* We try each start position which is close enough, running forward. */
+                    auto start{ pos };
+                    for(u32 steps{};; ++steps)
+                    {
+                      if(run(pc + 1, start, pos) != npos)
+                      {
+                        found = true;
+                        break;
+                      }
+                      if(start == 0 || steps == i.y)
+                      {
+                        break;
+                      }
+                      start -= decode_before(input, start).length;
+                    }
+                  }
+                  else
+                  {
+                    found = run(pc + 1, pos, npos) != npos;
+                  }
+
+                  bool const negated(i.flags & look_negated);
+                  if(!found || negated)
+                  {
+                    slots = saved;
+                  }
+                  else
+                  {
+                    keep_slots(saved, stack);
+                  }
+                  if(found == negated)
+                  {
+                    alive = false;
+                    break;
+                  }
+                  pc = i.x;
+                  break;
+                }
+              case op::atomic:
+                {
+                  auto const saved{ slots };
+                  auto const end{ run(pc + 1, pos, npos) };
+                  if(end == npos)
+                  {
+                    slots = saved;
+                    alive = false;
+                    break;
+                  }
+                  keep_slots(saved, stack);
+                  pos = end;
+                  pc = i.x;
+                  break;
+                }
+              case op::sub_match:
+              case op::match:
+                if(required_end == npos || pos == required_end)
+                {
+                  return pos;
+                }
+                alive = false;
+                break;
+            }
+          }
+        }
+        return npos;
+      }
+
+      program const &prog;
+      std::vector<char_set> const &sets;
+      std::string_view input;
+      std::vector<usize> &slots;
+    };
+
+    /*** Lazy DFA. ***/
+
+    /* Each DFA state is an ordered list of NFA threads, built on demand as the input needs
+     * it and then cached. Assertions are left unresolved in a state until the next char is
+     * known, at which point we know what's on both sides of the position. The state also
+     * remembers the flags of the char it was entered on, for the same reason.
+     *
+     * In leftmost-first mode, a match cuts off every lower priority thread, just like in
+     * the Pike VM. In longest mode, we keep going for as long as anything can still
+     * match. A reverse DFA runs over the input backward, so its state flags are for the
+     * char after the position, rather than before it. */
+    struct dfa
+    {
+      static constexpr u32 unknown{ no_index };
+      static constexpr u32 dead{ 0 };
+      /* Returned by searches when the DFA grew too big. */
+      static constexpr usize give_up{ npos - 1 };
+
+      struct state
+      {
+        std::vector<u32> pcs;
+        u8 flags{};
+        /* Transitions on ASCII chars. Each is the next state's index shifted up by one, with
+         * the low bit set if there was a match right before the char. */
+        std::array<u32, 128> next{};
+        /* Whether there's a match at the end of the input, once known. */
+        u32 end{ unknown };
+      };
+
+      dfa(program const &prog,
+          std::vector<char_set> const &sets,
+          bool const reverse,
+          bool const longest)
+        : prog{ prog }
+        , sets{ sets }
+        , reverse{ reverse }
+        , longest{ longest }
+        , flag_mask(static_cast<u8>((prog.uses_edge ? edge_flag : 0)
+                                    | (prog.uses_word ? word_flag : 0)
+                                    | (prog.uses_newline ? newline_flag : 0)))
+      {
+        seen.resize(prog.insts.size());
+        reset();
+      }
+
+      void reset()
+      {
+        states.clear();
+        index.clear();
+        wide.clear();
+        starts.fill(unknown);
+
+        state d;
+        d.next.fill(dead);
+        d.end = 0;
+        states.emplace_back(std::move(d));
+      }
+
+      /* Adds the threads reachable from pc without consuming anything, in priority order.
+       * Assertions are checked against ctx, unless we don't know enough yet, in which case
+       * they're kept as is. */
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wswitch-enum"
+      void follow(u32 const start_pc, std::vector<u32> &out, bool const resolve, u8 const ctx)
+      {
+        stack.push_back(start_pc);
+        while(!stack.empty())
+        {
+          auto pc{ stack.back() };
+          stack.pop_back();
+          while(!seen.contains(pc))
+          {
+            seen.insert(pc);
+            auto const &i{ prog.insts[pc] };
+            switch(i.code)
+            {
+              case op::jump:
+                pc = i.x;
+                continue;
+              case op::split:
+                stack.push_back(i.y);
+                pc = i.x;
+                continue;
+              case op::save:
+              case op::mark:
+              case op::check_progress:
+                ++pc;
+                continue;
+              case op::assertion:
+                if(!resolve)
+                {
+                  out.push_back(pc);
+                }
+                else if(check_assertion(static_cast<assertion_kind>(i.flags), ctx))
+                {
+                  ++pc;
+                  continue;
+                }
+                break;
+              default:
+                out.push_back(pc);
+                break;
+            }
+            break;
+          }
+        }
+      }
+#pragma clang diagnostic pop
+
+      u32 intern(std::vector<u32> const &pcs, u8 const flags)
+      {
+        if(pcs.empty())
+        {
+          return dead;
+        }
+
+        std::string key(1 + pcs.size() * sizeof(u32), '\0');
+        key[0] = static_cast<char>(flags);
+        std::memcpy(key.data() + 1, pcs.data(), pcs.size() * sizeof(u32));
+        auto const found{ index.find(key) };
+        if(found != index.end())
+        {
+          return found->second;
+        }
+
+        if(states.size() >= max_dfa_states)
+        {
+          return unknown;
+        }
+        state s;
+        s.pcs = pcs;
+        s.flags = flags;
+        s.next.fill(unknown);
+        auto const id{ static_cast<u32>(states.size()) };
+        states.emplace_back(std::move(s));
+        index.emplace(std::move(key), id);
+        return id;
+      }
+
+      u32 start_state(u32 const pc, u8 const flags)
+      {
+        auto &start{ starts[(pc == prog.start ? 0 : 8) + flags] };
+        if(start == unknown)
+        {
+          seen.clear();
+          next_pcs.clear();
+          follow(pc, next_pcs, false, 0);
+          start = intern(next_pcs, flags);
+        }
+        return start;
+      }
+
+      /* Builds the transition from a state on c, where no_index is the edge of the input.
+       * The result is packed like state::next, or unknown if we ran out of states. */
+      u32 compute(u32 const id, u32 const c)
+      {
+        auto const sym_flags{ static_cast<u8>((c == no_index ? edge_flag : char_flags(c))
+                                              & flag_mask) };
+        auto const state_flags{ states[id].flags };
+        auto const ctx{ static_cast<u8>(reverse ? sym_flags | (state_flags << after_shift)
+                                                : state_flags | (sym_flags << after_shift)) };
+
+        seen.clear();
+        resolved.clear();
+        for(auto const pc : states[id].pcs)
+        {
+          follow(pc, resolved, true, ctx);
+        }
+
+        bool matched{};
+        seen.clear();
+        next_pcs.clear();
+        for(auto const pc : resolved)
+        {
+          auto const &i{ prog.insts[pc] };
+          if(i.code == op::match)
+          {
+            matched = true;
+            if(!longest)
+            {
+              break;
+            }
+            continue;
+          }
+          if(c != no_index && accepts(sets, i, c))
+          {
+            follow(pc + 1, next_pcs, false, 0);
+          }
+        }
+
+        if(c == no_index)
+        {
+          return matched;
+        }
+        auto const next{ intern(next_pcs, sym_flags) };
+        if(next == unknown)
+        {
+          return unknown;
+        }
+        return (next << 1) | matched;
+      }
+
+      u32 transition(u32 const id, u32 const c)
+      {
+        if(c < 128)
+        {
+          auto const cached{ states[id].next[c] };
+          if(cached != unknown)
+          {
+            return cached;
+          }
+          auto const computed{ compute(id, c) };
+          if(computed != unknown)
+          {
+            states[id].next[c] = computed;
+          }
+          return computed;
+        }
+
+        auto const key{ (static_cast<u64>(id) << 32) | c };
+        auto const found{ wide.find(key) };
+        if(found != wide.end())
+        {
+          return found->second;
+        }
+        auto const computed{ compute(id, c) };
+        if(computed != unknown)
+        {
+          wide.emplace(key, computed);
+        }
+        return computed;
+      }
+
+      u32 end_transition(u32 const id)
+      {
+        if(states[id].end == unknown)
+        {
+          states[id].end = compute(id, no_index);
+        }
+        return states[id].end;
+      }
+
+      /* Returns where the match ends, npos if there isn't one, or give_up. */
+      usize search_forward(std::string_view const input, usize const from, u32 const start_pc)
+      {
+        auto const flags{ static_cast<u8>(
+          (from == 0 ? edge_flag : char_flags(decode_before(input, from).c)) & flag_mask) };
+        auto s{ start_state(start_pc, flags) };
+        usize last{ npos };
+        auto pos{ from };
+        while(s != dead)
+        {
+          if(s == unknown)
+          {
+            reset();
+            return give_up;
+          }
+
+          if(pos == input.size())
+          {
+            if(end_transition(s))
+            {
+              last = pos;
+            }
+            break;
+          }
+
+          auto const b{ static_cast<u8>(input[pos]) };
+          auto const d{ b < 0x80 ? decoded{ b, 1 } : decode(input, pos) };
+          auto const t{ transition(s, d.c) };
+          if(t == unknown)
+          {
+            reset();
+            return give_up;
+          }
+          if(t & 1)
+          {
+            last = pos;
+          }
+          s = t >> 1;
+          pos += d.length;
+        }
+        return last;
+      }
+
+      /* Runs backward from end, but not past from. Returns where the match starts, npos if
+       * there isn't one, or give_up. */
+      usize search_reverse(std::string_view const input, usize const from, usize const end)
+      {
+        auto const flags{ static_cast<u8>(
+          (end == input.size() ? edge_flag : char_flags(decode(input, end).c)) & flag_mask) };
+        auto s{ start_state(prog.start, flags) };
+        usize last{ npos };
+        auto pos{ end };
+        while(s != dead)
+        {
+          if(s == unknown)
+          {
+            reset();
+            return give_up;
+          }
+
+          /* We can't go past from, but we still need to know what's before it. */
+          if(pos == from)
+          {
+            auto const t{ from == 0 ? end_transition(s)
+                                    : transition(s, decode_before(input, from).c) };
+            if(t == unknown)
+            {
+              reset();
+              return give_up;
+            }
+            if(t & 1)
+            {
+              last = pos;
+            }
+            break;
+          }
+
+          auto const b{ static_cast<u8>(input[pos - 1]) };
+          auto const d{ b < 0x80 ? decoded{ b, 1 } : decode_before(input, pos) };
+          auto const t{ transition(s, d.c) };
+          if(t == unknown)
+          {
+            reset();
+            return give_up;
+          }
+          if(t & 1)
+          {
+            last = pos;
+          }
+          s = t >> 1;
+          pos -= d.length;
+        }
+        return last;
+      }
+
+      program const &prog;
+      std::vector<char_set> const &sets;
+      bool reverse{};
+      bool longest{};
+      u8 flag_mask{};
+      std::vector<state> states;
+      std::unordered_map<std::string, u32> index;
+      /* Transitions on non-ASCII chars, keyed by state and char. */
+      std::unordered_map<u64, u32> wide;
+      std::array<u32, 16> starts{};
+      sparse_set seen;
+      std::vector<u32> stack;
+      std::vector<u32> resolved;
+      std::vector<u32> next_pcs;
+    };
+
+    /* Everything which a single search mutates. A regex keeps a pool of these, so that
+     * threads never share one and DFA states are kept from one search to the next. */
+    struct regex_scratch
+    {
+      regex_scratch(program const &forward,
+                    program const &backward,
+                    std::vector<char_set> const &sets)
+        : forward_first{ forward, sets, false, false }
+        , forward_longest{ forward, sets, false, true }
+        , backward_longest{ backward, sets, true, true }
+      {
+      }
+
+      dfa forward_first;
+      dfa forward_longest;
+      dfa backward_longest;
+      pike_vm pike;
+      std::vector<usize> slots;
+    };
+  }
+
+  struct regex::impl
+  {
+    struct scratch_guard
+    {
+      scratch_guard(impl const &re)
+        : re{ re }
+      {
+        {
+          std::lock_guard<std::mutex> const lock{ re.scratch_mutex };
+          if(!re.scratch_pool.empty())
+          {
+            scratch = std::move(re.scratch_pool.back());
+            re.scratch_pool.pop_back();
+          }
+        }
+        if(!scratch)
+        {
+          scratch = std::make_unique<regex_scratch>(re.forward, re.backward, re.sets);
+        }
+      }
+
+      ~scratch_guard()
+      {
+        std::lock_guard<std::mutex> const lock{ re.scratch_mutex };
+        re.scratch_pool.emplace_back(std::move(scratch));
+      }
+
+      impl const &re;
+      std::unique_ptr<regex_scratch> scratch;
+    };
+
+    regex::match make_match() const
+    {
+      regex::match m;
+      m.offsets.assign(forward.capture_slots, npos);
+      return m;
+    }
+
+    jtl::option<regex::match>
+    backtrack(std::string_view const input, usize const from, bool const anchored_end) const
+    {
+      scratch_guard const guard{ *this };
+      auto &slots{ guard.scratch->slots };
+      backtracker b{ forward, sets, input, slots };
+      for(auto start{ from };;)
+      {
+        slots.assign(forward.slot_count, npos);
+        if(b.run(forward.start, start, anchored_end ? input.size() : npos) != npos)
+        {
+          auto m{ make_match() };
+          std::copy_n(slots.begin(), forward.capture_slots, m.offsets.begin());
+          return m;
+        }
+        if(anchored_end || start == input.size())
+        {
+          return none;
+        }
+        start = next_boundary(input, start);
+      }
+    }
+
+    std::vector<node> nodes;
+    std::vector<char_set> sets;
+    std::vector<std::pair<std::string, u32>> names;
+    u32 group_count{};
+    program forward;
+    program backward;
+    /* A pattern which starts with `^` can only match at the start of the input. */
+    bool anchored_begin{};
+    /* Literal text which every match starts with, which lets us skip ahead. */
+    std::string prefix;
+
+    mutable std::mutex scratch_mutex;
+    mutable std::vector<std::unique_ptr<regex_scratch>> scratch_pool;
+  };
+
+  regex::regex(jtl::immutable_string_view const &pattern)
+    : pimpl{ std::make_unique<impl>() }
+  {
+    auto &re{ *pimpl };
+    std::vector<range_set> sets;
+    parser p{ std::string_view{ pattern.data(), pattern.size() }, re.nodes, sets };
+    auto const root{ p.parse() };
+    re.group_count = p.group_count;
+    re.names = std::move(p.names);
+    for(auto &rs : sets)
+    {
+      re.sets.emplace_back(std::move(rs));
+    }
+
+    re.forward = compile_program(re.nodes, root, re.group_count, false);
+    if(re.forward.dfa_compatible)
+    {
+      re.backward = compile_program(re.nodes, root, re.group_count, true);
+    }
+
+    /* Look through any leading groups for an anchor. */
+    auto first{ root };
+    while(true)
+    {
+      auto const &n{ re.nodes[first] };
+      if((n.kind == node_kind::concat && !n.children.empty()) || n.kind == node_kind::group)
+      {
+        first = n.children[0];
+        continue;
+      }
+      break;
+    }
+    auto const &first_node{ re.nodes[first] };
+    re.anchored_begin = first_node.kind == node_kind::assertion
+      && first_node.assertion == assertion_kind::text_begin;
+
+    /* The prefix only comes from a flat run of literals at the very start. */
+    auto const &root_node{ re.nodes[root] };
+    if(root_node.kind == node_kind::literal)
+    {
+      encode(root_node.value, re.prefix);
+    }
+    else if(root_node.kind == node_kind::concat)
+    {
+      for(auto const child : root_node.children)
+      {
+        if(re.nodes[child].kind != node_kind::literal)
+        {
+          break;
+        }
+        encode(re.nodes[child].value, re.prefix);
+      }
+    }
+  }
+
+  regex::~regex() = default;
+
+  jtl::option<regex::match>
+  regex::search(jtl::immutable_string_view const &input,
+                usize const from,
+                bool const want_groups) const
+  {
+    auto const &re{ *pimpl };
+    std::string_view const s{ input.data(), input.size() };
+    if(from > s.size() || (re.anchored_begin && from > 0))
+    {
+      return none;
+    }
+
+    auto start_from{ from };
+    if(!re.prefix.empty())
+    {
+      start_from = s.find(re.prefix, from);
+      if(start_from == std::string_view::npos)
+      {
+        return none;
+      }
+    }
+
+    if(!re.forward.dfa_compatible)
+    {
+      return re.backtrack(s, start_from, false);
+    }
+
+    impl::scratch_guard const guard{ re };
+    auto &scratch{ *guard.scratch };
+    auto const start_pc{ re.anchored_begin ? re.forward.start : re.forward.unanchored_start };
+    auto const end{ scratch.forward_first.search_forward(s, start_from, start_pc) };
+    if(end == npos)
+    {
+      return none;
+    }
+
+    auto m{ re.make_match() };
+    if(end != dfa::give_up)
+    {
+      auto const start{ scratch.backward_longest.search_reverse(s, start_from, end) };
+      if(start != dfa::give_up && start != npos)
+      {
+        if(!want_groups || re.group_count == 0)
+        {
+          m.offsets[0] = start;
+          m.offsets[1] = end;
+          return m;
+        }
+        if(scratch.pike.run(re.forward, re.sets, s, start, true, false, m.offsets.data()))
+        {
+          return m;
+        }
+      }
+    }
+
+    /* The DFA gave up, so we fall back to the Pike VM for the whole search. */
+    if(scratch.pike.run(re.forward,
+                        re.sets,
+                        s,
+                        start_from,
+                        re.anchored_begin,
+                        false,
+                        m.offsets.data()))
+    {
+      return m;
+    }
+    return none;
+  }
+
+  jtl::option<regex::match> regex::full_match(jtl::immutable_string_view const &input) const
+  {
+    auto const &re{ *pimpl };
+    std::string_view const s{ input.data(), input.size() };
+    if(!re.forward.dfa_compatible)
+    {
+      return re.backtrack(s, 0, true);
+    }
+
+    impl::scratch_guard const guard{ re };
+    auto &scratch{ *guard.scratch };
+    /* The longest match tells us whether any match spans the whole input, which is the
+     * common failure case, without needing the Pike VM. */
+    auto const end{ scratch.forward_longest.search_forward(s, 0, re.forward.start) };
+    if(end != dfa::give_up && end != s.size())
+    {
+      return none;
+    }
+
+    auto m{ re.make_match() };
+    if(scratch.pike.run(re.forward, re.sets, s, 0, true, true, m.offsets.data()))
+    {
+      return m;
+    }
+    return none;
+  }
+
+  usize regex::group_count() const
+  {
+    return pimpl->group_count;
+  }
+
+  usize regex::group_index(jtl::immutable_string_view const &name) const
+  {
+    std::string_view const n{ name.data(), name.size() };
+    for(auto const &entry : pimpl->names)
+    {
+      if(entry.first == n)
+      {
+        return entry.second;
+      }
+    }
+    return npos;
+  }
+
+  usize regex::resume_from(jtl::immutable_string_view const &input, match const &m)
+  {
+    if(m.start() != m.end())
+    {
+      return m.end();
+    }
+    if(m.end() == input.size())
+    {
+      return m.end() + 1;
+    }
+    return next_boundary(std::string_view{ input.data(), input.size() }, m.end());
+  }
+}
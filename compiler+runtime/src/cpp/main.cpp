@@ -10,6 +10,7 @@
 #include <jank/read/lex.hpp>
 #include <jank/read/parse.hpp>
 #include <jank/runtime/context.hpp>
+#include <jank/runtime/gc.hpp>
 #include <jank/runtime/behavior/callable.hpp>
 #include <jank/runtime/core/to_string.hpp>
 #include <jank/runtime/obj/persistent_string.hpp>
@@ -33,6 +34,7 @@
 #include <jank/perf_native.hpp>
 #include <clojure/core_native.hpp>
 #include <clojure/string_native.hpp>
+#include <clojure/edn_native.hpp>
 
 #ifdef JANK_PHASE_2
 extern "C" jank_object_ref jank_load_clojure_core();
@@ -290,10 +292,7 @@ int main(int const argc, char const **argv)
       return parse_result.expect_err();
     }
 
-    if(jank::util::cli::opts.gc_incremental)
-    {
-      GC_enable_incremental();
-    }
+    runtime::gc::configure();
 
     profile::configure();
     profile::timer const timer{ "main" };
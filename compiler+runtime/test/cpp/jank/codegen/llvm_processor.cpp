@@ -0,0 +1,110 @@
+#include <llvm/Analysis/LoopInfo.h>
+#include <llvm/IR/Dominators.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+
+#include <jank/runtime/context.hpp>
+#include <jank/codegen/llvm_processor.hpp>
+#include <jank/evaluate.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::codegen
+{
+  using namespace jank::runtime;
+
+  /* Generates the IR for the fn, without optimizing it, and counts the calls to jank_*_create
+   * fns within any loop in it. */
+  static usize count_boxes_in_loops(jtl::immutable_string_view const &code)
+  {
+    auto const exprs(__rt_ctx->analyze_string(code, false));
+    CHECK_EQ(exprs.size(), 1);
+
+    auto const wrapped(evaluate::wrap_expression(exprs[0], "boxing_test", {}));
+    llvm_processor const cg_prc{ wrapped, "boxing_test", compilation_target::eval };
+    cg_prc.gen().expect_ok();
+
+    usize count{};
+    for(auto &fn : *cg_prc.get_module().getModuleUnlocked())
+    {
+      if(fn.isDeclaration())
+      {
+        continue;
+      }
+
+      llvm::DominatorTree const dom_tree{ fn };
+      llvm::LoopInfo const loop_info{ dom_tree };
+      for(auto const loop : loop_info.getLoopsInPreorder())
+      {
+        for(auto const block : loop->blocks())
+        {
+          for(auto const &inst : *block)
+          {
+            auto const call{ llvm::dyn_cast<llvm::CallInst>(&inst) };
+            if(!call || !call->getCalledFunction())
+            {
+              continue;
+            }
+
+            auto const name(call->getCalledFunction()->getName());
+            if(name.starts_with("jank_") && name.ends_with("_create"))
+            {
+              ++count;
+            }
+          }
+        }
+      }
+    }
+    return count;
+  }
+
+  TEST_SUITE("codegen::llvm_processor")
+  {
+    TEST_CASE("Unboxed loop locals")
+    {
+      SUBCASE("Only boxed on exit")
+      {
+        CHECK_EQ(count_boxes_in_loops("(fn* [^long n]"
+                                      "  (loop* [i 0 sum 0]"
+                                      "    (if (< i n)"
+                                      "      (recur (inc i) (+ sum i))"
+                                      "      sum)))"),
+                 0);
+      }
+
+      SUBCASE("Real, only boxed on exit")
+      {
+        CHECK_EQ(count_boxes_in_loops("(fn* [^double x]"
+                                      "  (loop* [x x]"
+                                      "    (if (< x 1.0)"
+                                      "      [x]"
+                                      "      (recur (/ x 2.0)))))"),
+                 0);
+      }
+
+      SUBCASE("Let within the loop, only boxed on exit")
+      {
+        CHECK_EQ(count_boxes_in_loops("(fn* [^long n]"
+                                      "  (loop* [i 0]"
+                                      "    (let* [j (inc i)]"
+                                      "      (if (< j n)"
+                                      "        (recur j)"
+                                      "        j))))"),
+                 0);
+      }
+
+      SUBCASE("Boxed use within the loop")
+      {
+        /* Each conj needs the current i as an object, so this one can't be avoided. */
+        CHECK_EQ(count_boxes_in_loops("(fn* [^long n]"
+                                      "  (loop* [i 0 acc []]"
+                                      "    (if (< i n)"
+                                      "      (recur (inc i) (conj acc i))"
+                                      "      acc)))"),
+                 1);
+      }
+    }
+  }
+}
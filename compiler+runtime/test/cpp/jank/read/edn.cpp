@@ -0,0 +1,139 @@
+#include <limits>
+
+#include <jtl/string_builder.hpp>
+
+#include <jank/read/edn.hpp>
+#include <jank/runtime/rtti.hpp>
+#include <jank/runtime/core/make_box.hpp>
+#include <jank/runtime/core/equal.hpp>
+#include <jank/runtime/core/meta.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/obj/persistent_array_map.hpp>
+#include <jank/runtime/obj/persistent_hash_map.hpp>
+#include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/symbol.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::read::edn
+{
+  using namespace jank::runtime;
+
+  TEST_SUITE("edn")
+  {
+    TEST_CASE("Empty")
+    {
+      processor p{ " ; just a comment\n #_ discarded" };
+      CHECK(p.next().expect_ok().is_none());
+    }
+
+    TEST_CASE("Streaming")
+    {
+      processor p{ "1 :two [3] (four)" };
+      CHECK(equal(p.next().expect_ok().unwrap(), make_box(1)));
+      CHECK(equal(p.next().expect_ok().unwrap(), __rt_ctx->intern_keyword("two").expect_ok()));
+      CHECK(equal(p.next().expect_ok().unwrap(),
+                  make_box<obj::persistent_vector>(std::in_place, make_box(3))));
+      CHECK(equal(p.next().expect_ok().unwrap(),
+                  make_box<obj::persistent_list>(std::in_place, make_box<obj::symbol>("four"))));
+      CHECK(p.next().expect_ok().is_none());
+    }
+
+    TEST_CASE("No source meta")
+    {
+      processor p{ "[a/b {:c d}]" };
+      auto const r(p.next().expect_ok().unwrap());
+      CHECK(meta(r).is_nil());
+
+      auto const v(expect_object<obj::persistent_vector>(r));
+      auto const sym(expect_object<obj::symbol>(v->data[0]));
+      CHECK(sym->ns == "a");
+      CHECK(sym->name == "b");
+      CHECK(meta(sym).is_nil());
+    }
+
+    TEST_CASE("Large map")
+    {
+      jtl::string_builder sb;
+      sb("{");
+      for(i64 i{}; i < 20; ++i)
+      {
+        sb(i)(" ")(i)(" ");
+      }
+      sb("}");
+
+      processor p{ sb.view() };
+      auto const r(p.next().expect_ok().unwrap());
+      CHECK(r->type == object_type::persistent_hash_map);
+      auto const m(expect_object<obj::persistent_hash_map>(r));
+      CHECK(m->data.size() == 20);
+      CHECK(equal(m->get(make_box(19)), make_box(19)));
+    }
+
+    TEST_CASE("Duplicates")
+    {
+      CHECK(processor{ "{:a 1 :a 2}" }.next().is_err());
+      CHECK(processor{ "{0 0 1 1 2 2 3 3 4 4 5 5 6 6 7 7 8 8 9 9 0 0}" }.next().is_err());
+      CHECK(processor{ "#{1 2 1}" }.next().is_err());
+    }
+
+    TEST_CASE("Malformed")
+    {
+      CHECK(processor{ "[1 2" }.next().is_err());
+      CHECK(processor{ "{:a}" }.next().is_err());
+      CHECK(processor{ "(1 2]" }.next().is_err());
+      CHECK(processor{ "#_" }.next().is_err());
+      CHECK(processor{ "#unknown 1" }.next().is_err());
+    }
+
+    TEST_CASE("Code forms")
+    {
+      for(auto const code :
+          { "'a", "`a", "~a", "@a", "^:m []", "#(inc %)", "#'a", "#\"re\"", "#?(:jank 1)", "::k" })
+      {
+        CAPTURE(code);
+        CHECK(processor{ code }.next().is_err());
+      }
+    }
+
+    TEST_CASE("Namespaced maps")
+    {
+      processor p{ "#:person{:name \"Ann\" :_/id 1 :other/age 2 pet 3 \"s\" 4} #:a {}" };
+      auto const m(p.next().expect_ok().unwrap());
+      auto const expected(
+        processor{ R"({:person/name "Ann" :id 1 :other/age 2 person/pet 3 "s" 4})" }.next());
+      CHECK(equal(m, expected.expect_ok().unwrap()));
+      CHECK(equal(p.next().expect_ok().unwrap(), obj::persistent_array_map::empty()));
+
+      CHECK(processor{ "#:a{:b 1 :a/b 2}" }.next().is_err());
+      CHECK(processor{ "#::{:b 1}" }.next().is_err());
+      CHECK(processor{ "#:a/b{:c 1}" }.next().is_err());
+      CHECK(processor{ "#:a [1]" }.next().is_err());
+    }
+
+    TEST_CASE("Symbolic values")
+    {
+      processor p{ "##Inf ##-Inf" };
+      CHECK(equal(p.next().expect_ok().unwrap(),
+                  make_box(std::numeric_limits<f64>::infinity())));
+      CHECK(equal(p.next().expect_ok().unwrap(),
+                  make_box(-std::numeric_limits<f64>::infinity())));
+    }
+
+    TEST_CASE("String deduplication")
+    {
+      options opts;
+      opts.dedupe_strings = true;
+      processor deduped{ R"(["meow" "meow"])", opts };
+      auto const a(expect_object<obj::persistent_vector>(deduped.next().expect_ok().unwrap()));
+      CHECK(a->data[0] == a->data[1]);
+
+      processor plain{ R"(["meow" "meow"])" };
+      auto const b(expect_object<obj::persistent_vector>(plain.next().expect_ok().unwrap()));
+      CHECK(b->data[0] != b->data[1]);
+      CHECK(equal(b->data[0], b->data[1]));
+    }
+  }
+}
@@ -2488,5 +2488,27 @@ namespace jank::read::lex
               }));
       }
     }
+
+    TEST_CASE("Bulk scanning")
+    {
+      /* Long tokens get skipped through in bulk, a word at a time. These make sure we stop in
+       * the right spots, across word boundaries, and still track lines and columns. */
+      processor p{ "\"abcdefghijklmnop\\\"qrs\ntuvwxyzé\" done ;; abcdefghijklmnopqrstuvwxyz\n"
+                   "foo-bar-baz-quux" };
+      native_vector<jtl::result<token, error_ref>> const tokens(p.begin(), p.end());
+      CHECK(tokens
+            == make_tokens({
+              {   { { 0, 1, 1 } },
+               { { 33, 2, 11 } },
+               token_kind::escaped_string,
+               "abcdefghijklmnop\\\"qrs\ntuvwxyzé"sv },
+              { { { 34, 2, 12 } }, { { 38, 2, 16 } }, token_kind::symbol, "done"sv },
+              { { { 39, 2, 17 } },
+               { { 68, 2, 46 } },
+               token_kind::comment,
+               " abcdefghijklmnopqrstuvwxyz"sv },
+              {  { { 69, 3, 1 } }, { { 85, 3, 17 } }, token_kind::symbol, "foo-bar-baz-quux"sv }
+      }));
+    }
   }
 }
@@ -14,6 +14,7 @@
 #include <jank/runtime/obj/persistent_array_map.hpp>
 #include <jank/runtime/obj/persistent_hash_map.hpp>
 #include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/obj/source_info.hpp>
 #include <jank/util/escape.hpp>
 #include <jank/util/fmt.hpp>
 
@@ -1045,6 +1046,36 @@ namespace jank::read::parse
                              .unwrap()) };
         CHECK(equal(get(m, __rt_ctx->intern_keyword("foo").expect_ok()), jank_true));
       }
+
+      SUBCASE("Source info")
+      {
+        lex::processor lp{ "\n  [1 2]" };
+        processor p{ lp.begin(), lp.end() };
+        auto const r(p.next());
+        auto const m{ meta(r.expect_ok().unwrap().ptr) };
+
+        auto const source{ meta_source(m) };
+        CHECK(source.file_path == read::no_source_path);
+        CHECK_EQ(source.start.line, 2u);
+        CHECK_EQ(source.start.col, 3u);
+
+        /* The packed source info should still read like the map it stands in for. */
+        auto const info{ get(m, __rt_ctx->intern_keyword("jank/source").expect_ok()) };
+        auto const start{ get(info, __rt_ctx->intern_keyword("start").expect_ok()) };
+        CHECK(equal(get(start, __rt_ctx->intern_keyword("line").expect_ok()), make_box(2)));
+        CHECK(equal(get(start, __rt_ctx->intern_keyword("col").expect_ok()), make_box(3)));
+        auto const info_map{ expect_object<obj::source_info>(info)->to_map() };
+        CHECK(equal(info, info_map));
+        CHECK(equal(info_map, info));
+        CHECK(meta_source(strip_source_from_meta(m)) == read::source::unknown);
+
+        /* Meta which is handed to jank code has a real map for its source. */
+        auto const materialized{ get(materialized_meta(r.expect_ok().unwrap().ptr),
+                                     __rt_ctx->intern_keyword("jank/source").expect_ok()) };
+        CHECK(materialized->type == object_type::persistent_array_map);
+        CHECK(equal(materialized, info));
+        CHECK(equal(info, materialized));
+      }
     }
 
     TEST_CASE("Reader macro")
@@ -0,0 +1,50 @@
+#include <cmath>
+
+#include <jank/runtime/core/make_box.hpp>
+#include <jank/runtime/core/equal.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime
+{
+  TEST_SUITE("make_box")
+  {
+    TEST_CASE("cached integers")
+    {
+      CHECK(make_box(0) == make_box(0));
+      CHECK(make_box(1) == make_box(static_cast<i64>(1)));
+      CHECK(make_box(7) == make_box(static_cast<usize>(7)));
+      CHECK(make_box(detail::integer_cache_min) == make_box(detail::integer_cache_min));
+      CHECK(make_box(detail::integer_cache_max) == make_box(detail::integer_cache_max));
+      CHECK(make_box(-5)->data == -5);
+      CHECK(make_box(detail::integer_cache_max)->data == detail::integer_cache_max);
+    }
+
+    TEST_CASE("uncached integers")
+    {
+      auto const big(detail::integer_cache_max + 1);
+      CHECK(make_box(big) != make_box(big));
+      CHECK(equal(make_box(big), make_box(big)));
+      CHECK(make_box(big)->data == big);
+      CHECK(make_box(detail::integer_cache_min - 1)->data == detail::integer_cache_min - 1);
+    }
+
+    TEST_CASE("cached reals")
+    {
+      CHECK(make_box(0.0) == make_box(0.0));
+      CHECK(make_box(1.0) == make_box(1.0));
+      CHECK(make_box(-0.0) != make_box(0.0));
+      CHECK(std::signbit(make_box(-0.0)->data));
+      CHECK(make_box(2.0) != make_box(2.0));
+    }
+
+    TEST_CASE("cached characters")
+    {
+      CHECK(make_box('a') == make_box('a'));
+      CHECK(make_box('a')->data == "a");
+      CHECK(make_box('\n')->data == "\n");
+      CHECK(make_box('a') != make_box('b'));
+    }
+  }
+}
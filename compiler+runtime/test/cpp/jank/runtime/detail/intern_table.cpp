@@ -0,0 +1,142 @@
+#include <jank/runtime/detail/intern_table.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/runtime/thread_pool.hpp>
+#include <jank/runtime/obj/keyword.hpp>
+#include <jank/runtime/core/make_box.hpp>
+#include <jank/util/fmt.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::detail
+{
+  using table_type = intern_table<jtl::immutable_string, obj::integer_ref>;
+
+  struct intern_task : task
+  {
+    intern_task(native_vector<jtl::immutable_string> const &names, std::atomic<usize> &done)
+      : names{ names }
+      , done{ done }
+    {
+    }
+
+    void run() override
+    {
+      for(usize round{}; round < 64; ++round)
+      {
+        for(auto const &name : names)
+        {
+          results.emplace_back(__rt_ctx->intern_keyword(name).expect_ok());
+        }
+      }
+      ++done;
+    }
+
+    native_vector<jtl::immutable_string> const &names;
+    std::atomic<usize> &done;
+    native_vector<obj::keyword_ref> results;
+  };
+
+  TEST_SUITE("intern_table")
+  {
+    TEST_CASE("Empty")
+    {
+      table_type const t;
+      CHECK(t.find("foo").is_nil());
+    }
+
+    TEST_CASE("Insert")
+    {
+      table_type t;
+      i64 made{};
+      auto const make{ [&] {
+        ++made;
+        return make_box(made);
+      } };
+
+      auto const a{ t.find_or_insert("a", make) };
+      CHECK(a->data == 1);
+      CHECK(t.find_or_insert("a", make) == a);
+      CHECK(t.find("a") == a);
+      CHECK(made == 1);
+
+      auto const b{ t.find_or_insert("b", make) };
+      CHECK(b->data == 2);
+      CHECK(t.find("a") == a);
+      CHECK(made == 2);
+    }
+
+    TEST_CASE("Erase")
+    {
+      table_type t;
+      auto const a{ t.find_or_insert("a", [] { return make_box(1); }) };
+      CHECK(t.erase("a") == a);
+      CHECK(t.find("a").is_nil());
+      CHECK(t.erase("a").is_nil());
+      CHECK(t.erase("b").is_nil());
+
+      auto const a2{ t.find_or_insert("a", [] { return make_box(2); }) };
+      CHECK(a2->data == 2);
+      CHECK(t.find("a") == a2);
+    }
+
+    TEST_CASE("Growth")
+    {
+      table_type t;
+      for(i64 i{}; i < 1000; ++i)
+      {
+        t.find_or_insert(util::format("{}", i), [=] { return make_box(i); });
+        if(i % 3 == 0)
+        {
+          t.erase(util::format("{}", i));
+        }
+      }
+
+      for(i64 i{}; i < 1000; ++i)
+      {
+        auto const found{ t.find(util::format("{}", i)) };
+        if(i % 3 == 0)
+        {
+          CHECK(found.is_nil());
+        }
+        else
+        {
+          REQUIRE(found.is_some());
+          CHECK(found->data == i);
+        }
+      }
+    }
+
+    TEST_CASE("Concurrent keywords")
+    {
+      /* Many threads interning the same hot set of keywords need to agree on every one. */
+      native_vector<jtl::immutable_string> names;
+      for(usize i{}; i < 256; ++i)
+      {
+        names.emplace_back(util::format("intern-table-test/k{}", i));
+      }
+
+      thread_pool pool{ 8 };
+      std::atomic<usize> done{};
+      native_vector<intern_task *> tasks;
+      for(usize i{}; i < pool.size(); ++i)
+      {
+        tasks.emplace_back(new intern_task{ names, done });
+        pool.submit(tasks.back());
+      }
+      pool.help_until([&] { return done.load() == tasks.size(); });
+
+      usize mismatches{};
+      for(auto const t : tasks)
+      {
+        REQUIRE(t->results.size() == tasks[0]->results.size());
+        for(usize i{}; i < t->results.size(); ++i)
+        {
+          mismatches += t->results[i] != tasks[0]->results[i];
+        }
+      }
+      CHECK(mismatches == 0);
+      CHECK(__rt_ctx->intern_keyword(names[0]).expect_ok() == tasks[0]->results[0]);
+    }
+  }
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include <jank/runtime/module/loader.hpp>
+#include <jank/runtime/context.hpp>
+#include <jank/util/fmt.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime::module
+{
+  static void write_file(std::filesystem::path const &path, std::string const &contents)
+  {
+    /* Bump the modification time, in case we're writing faster than the filesystem's
+     * clock can tell apart. */
+    auto const existed{ std::filesystem::exists(path) };
+    auto const previous{ existed ? std::filesystem::last_write_time(path)
+                                 : std::filesystem::file_time_type{} };
+    std::ofstream{ path } << contents;
+    if(existed)
+    {
+      std::filesystem::last_write_time(path, previous + std::chrono::seconds{ 1 });
+    }
+  }
+
+  static void write_manifest(loader const &l,
+                             std::filesystem::path const &o_path,
+                             jtl::immutable_string const &module)
+  {
+    write_file(object_to_manifest_path(o_path.c_str()).c_str(), l.cache_manifest(module).c_str());
+  }
+
+  static module_type found_type(loader const &l, jtl::immutable_string const &module)
+  {
+    return l.find(module, origin::latest).expect_ok().to_load.unwrap();
+  }
+
+  TEST_SUITE("module::loader")
+  {
+    TEST_CASE("Cache manifest")
+    {
+      auto const root{ std::filesystem::temp_directory_path() / "jank-loader-test" };
+      auto const dir{ root / "cachetest" };
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(dir);
+
+      write_file(dir / "a.jank", "(ns cachetest.a (:require cachetest.b))");
+      write_file(dir / "b.jank", "(ns cachetest.b)");
+      write_file(dir / "a.o", "");
+
+      loader l;
+      l.add_path(root.c_str());
+
+      SUBCASE("Missing manifest")
+      {
+        CHECK(found_type(l, "cachetest.a") == module_type::jank);
+      }
+
+      SUBCASE("Source changes")
+      {
+        write_manifest(l, dir / "a.o", "cachetest.a");
+        CHECK(found_type(l, "cachetest.a") == module_type::o);
+
+        write_file(dir / "a.jank", "(ns cachetest.a (:require cachetest.b)) (def x 1)");
+        CHECK(found_type(l, "cachetest.a") == module_type::jank);
+
+        /* Only the contents matter, not when they were written. */
+        write_file(dir / "a.jank", "(ns cachetest.a (:require cachetest.b))");
+        CHECK(found_type(l, "cachetest.a") == module_type::o);
+      }
+
+      SUBCASE("Dependency changes")
+      {
+        __rt_ctx->module_dependencies["cachetest.a"] = { "cachetest.b" };
+        write_manifest(l, dir / "a.o", "cachetest.a");
+        __rt_ctx->module_dependencies.erase("cachetest.a");
+        CHECK(found_type(l, "cachetest.a") == module_type::o);
+
+        write_file(dir / "b.jank", "(ns cachetest.b) (def y 2)");
+        CHECK(found_type(l, "cachetest.a") == module_type::jank);
+      }
+
+      SUBCASE("Manifest for another module")
+      {
+        write_manifest(l, dir / "a.o", "cachetest.b");
+        CHECK(found_type(l, "cachetest.a") == module_type::jank);
+      }
+
+      std::filesystem::remove_all(root);
+    }
+
+    TEST_CASE("Compiled dependencies")
+    {
+      auto const root{ std::filesystem::temp_directory_path() / "jank-loader-deps-test" };
+      auto const dir{ root / "deptest" };
+      auto const cache_dir{ std::filesystem::path{ __rt_ctx->binary_cache_dir.c_str() }
+                            / "deptest" };
+      std::filesystem::remove_all(root);
+      std::filesystem::create_directories(dir);
+
+      write_file(dir / "a.jank", "(ns deptest.a (:require deptest.b deptest.c))");
+      write_file(dir / "b.jank", "(ns deptest.b (:require deptest.c))");
+      write_file(dir / "c.jank", "(ns deptest.c)");
+      write_file(dir / "d.jank", "(ns deptest.d (:require deptest.c))");
+      __rt_ctx->module_loader.add_path(root.c_str());
+
+      /* By the time d is compiled, c is already loaded, so requiring it doesn't load it
+       * again. It still needs to be in d's manifest. */
+      __rt_ctx->compile_module("deptest.a").expect_ok();
+      __rt_ctx->compile_module("deptest.d").expect_ok();
+
+      for(auto const module : { "a", "d" })
+      {
+        CAPTURE(module);
+        auto const o_path{ cache_dir / util::format("{}.o", module).c_str() };
+        std::ifstream file{ object_to_manifest_path(o_path.c_str()).c_str() };
+        std::stringstream manifest;
+        manifest << file.rdbuf();
+        CHECK(manifest.str().find("\ndeptest.c ") != std::string::npos);
+      }
+
+      std::filesystem::remove_all(cache_dir);
+      std::filesystem::remove_all(root);
+    }
+  }
+}
@@ -1,4 +1,6 @@
 #include <jank/runtime/obj/persistent_vector.hpp>
+#include <jank/runtime/obj/persistent_vector_sequence.hpp>
+#include <jank/runtime/obj/array_chunk.hpp>
 #include <jank/runtime/core/make_box.hpp>
 #include <jank/runtime/core/equal.hpp>
 
@@ -81,5 +83,33 @@ namespace jank::runtime::obj
       CHECK(!equal(make_box<persistent_vector>(std::in_place, make_box('f'), make_box('o')).erase(),
                    make_box<persistent_vector>(std::in_place, make_box('f')).erase()));
     }
+
+    TEST_CASE("chunked seq")
+    {
+      runtime::detail::native_transient_vector trans;
+      for(i64 i{}; i < 100; ++i)
+      {
+        trans.push_back(make_box(i));
+      }
+      auto const big{ make_box<persistent_vector>(trans.persistent()) };
+
+      usize total{};
+      i64 expected{};
+      for(auto s{ big->seq() }; s.is_some(); s = s->chunked_next())
+      {
+        auto const chunk{ s->chunked_first() };
+        CHECK(0 < chunk->count());
+        for(usize i{}; i < chunk->count(); ++i)
+        {
+          CHECK(equal(chunk->nth(make_box(static_cast<i64>(i))), make_box(expected++)));
+        }
+        total += chunk->count();
+      }
+      CHECK(total == 100);
+
+      /* Starting part way into a leaf gives a partial first chunk. */
+      auto const offset{ make_box<persistent_vector_sequence>(big, 5) };
+      CHECK(equal(offset->chunked_first()->nth(make_box(0)), make_box(5)));
+    }
   }
 }
@@ -0,0 +1,66 @@
+#include <atomic>
+
+#include <jank/runtime/thread_pool.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::runtime
+{
+  struct counting_task : task
+  {
+    counting_task(std::atomic<usize> &count)
+      : count{ count }
+    {
+    }
+
+    void run() override
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+      ++count;
+    }
+
+    std::atomic<usize> &count;
+  };
+
+  TEST_SUITE("thread_pool")
+  {
+    TEST_CASE("Shutdown")
+    {
+      std::atomic<usize> count{};
+
+      SUBCASE("Queued work still runs")
+      {
+        {
+          thread_pool pool{ 2 };
+          for(usize i{}; i < 50; ++i)
+          {
+            pool.submit(new counting_task{ count });
+          }
+          pool.shutdown();
+          CHECK_THROWS(pool.submit(new counting_task{ count }));
+        }
+        CHECK_EQ(count.load(), 50);
+      }
+
+      SUBCASE("Elastic queued work still runs")
+      {
+        auto const pool{ new elastic_thread_pool{ std::chrono::seconds{ 1 } } };
+        for(usize i{}; i < 10; ++i)
+        {
+          pool->submit(new counting_task{ count });
+        }
+        pool->shutdown();
+        CHECK_THROWS(pool->submit(new counting_task{ count }));
+
+        /* The threads are detached, so all we can do is wait for them. */
+        auto const deadline{ std::chrono::steady_clock::now() + std::chrono::seconds{ 10 } };
+        while(count.load() < 10 && std::chrono::steady_clock::now() < deadline)
+        {
+          std::this_thread::yield();
+        }
+        CHECK_EQ(count.load(), 10);
+      }
+    }
+  }
+}
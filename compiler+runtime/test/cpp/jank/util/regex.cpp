@@ -0,0 +1,227 @@
+#include <jank/util/regex.hpp>
+
+/* This must go last; doctest and glog both define CHECK and family. */
+#include <doctest/doctest.h>
+
+namespace jank::util
+{
+  /* Renders each group of a match, separated by a pipe, so we can compare them all at
+   * once. */
+  static std::string
+  render(std::string const &input, regex const &re, jtl::option<regex::match> const &m)
+  {
+    if(m.is_none())
+    {
+      return "nil";
+    }
+
+    std::string ret;
+    for(usize i{}; i <= re.group_count(); ++i)
+    {
+      if(i != 0)
+      {
+        ret += '|';
+      }
+      if(!m.unwrap().matched(i))
+      {
+        ret += "<nil>";
+        continue;
+      }
+      ret += input.substr(m.unwrap().start(i), m.unwrap().end(i) - m.unwrap().start(i));
+    }
+    return ret;
+  }
+
+  static std::string find(std::string const &pattern, std::string const &input)
+  {
+    regex const re{ pattern };
+    auto const ret{ render(input, re, re.search(input, 0)) };
+
+    /* Without groups, we skip the Pike VM, but should still find the same match. */
+    auto const whole{ render(input, re, re.search(input, 0, false)) };
+    CHECK_EQ(ret.substr(0, ret.find('|')), whole.substr(0, whole.find('|')));
+    return ret;
+  }
+
+  static std::string find_all(std::string const &pattern, std::string const &input)
+  {
+    regex const re{ pattern };
+    std::string ret;
+    for(usize pos{}; pos <= input.size();)
+    {
+      auto const m{ re.search(input, pos, false) };
+      if(m.is_none())
+      {
+        break;
+      }
+      ret += '[' + input.substr(m.unwrap().start(), m.unwrap().end() - m.unwrap().start()) + ']';
+      pos = regex::resume_from(input, m.unwrap());
+    }
+    return ret;
+  }
+
+  static std::string full_match(std::string const &pattern, std::string const &input)
+  {
+    regex const re{ pattern };
+    return render(input, re, re.full_match(input));
+  }
+
+  TEST_SUITE("util::regex")
+  {
+    TEST_CASE("search")
+    {
+      SUBCASE("literal")
+      {
+        CHECK_EQ(find("abc", "xxabcxx"), "abc");
+        CHECK_EQ(find("abc", "xxabxx"), "nil");
+        CHECK_EQ(find("", "abc"), "");
+      }
+
+      SUBCASE("quantifiers")
+      {
+        CHECK_EQ(find("a+", "baaab"), "aaa");
+        CHECK_EQ(find("a+?", "baaab"), "a");
+        CHECK_EQ(find("a*", "baaab"), "");
+        CHECK_EQ(find("x{2,3}", "xxxxx"), "xxx");
+        CHECK_EQ(find("x{2,}?", "xxxxx"), "xx");
+        CHECK_EQ(find("a{0}b", "ab"), "b");
+      }
+
+      SUBCASE("leftmost first")
+      {
+        CHECK_EQ(find("(foo|foobar)", "foobar"), "foo|foo");
+        CHECK_EQ(find("(a|ab)(c|bcd)(d*)", "abcd"), "abcd|a|bcd|");
+      }
+
+      SUBCASE("groups")
+      {
+        CHECK_EQ(find("(\\w+)@(\\w+)\\.com", "mail bob@site.com now"), "bob@site.com|bob|site");
+        CHECK_EQ(find("(a+)(b+)?", "aaac"), "aaa|aaa|<nil>");
+        CHECK_EQ(find("(a)|(b)", "b"), "b|<nil>|b");
+        CHECK_EQ(find("(a)(?:b)(c)", "abc"), "abc|a|c");
+
+        regex const re{ "(?<user>\\w+)@(?<host>\\w+)" };
+        CHECK_EQ(re.group_count(), 2u);
+        CHECK_EQ(re.group_index("user"), 1u);
+        CHECK_EQ(re.group_index("host"), 2u);
+        CHECK_EQ(re.group_index("nope"), regex::npos);
+      }
+
+      SUBCASE("classes")
+      {
+        CHECK_EQ(find("[a-c]+", "xxbcaz"), "bca");
+        CHECK_EQ(find("[^a-c]+", "abcxyz"), "xyz");
+        CHECK_EQ(find("[a-z&&[^aeiou]]+", "aeibcdo"), "bcd");
+        CHECK_EQ(find("[]a]+", "x]a]y"), "]a]");
+        CHECK_EQ(find("[\\d.]+", "v1.2.3"), "1.2.3");
+        CHECK_EQ(find("\\p{Alpha}+", "12ab34"), "ab");
+        CHECK_EQ(find("(?i)[a-c]+", "xABCy"), "ABC");
+      }
+
+      SUBCASE("anchors")
+      {
+        CHECK_EQ(find("^foo", "foo bar"), "foo");
+        CHECK_EQ(find("^bar", "foo bar"), "nil");
+        CHECK_EQ(find("(?m)^bar", "foo\nbar"), "bar");
+        CHECK_EQ(find("foo$", "foo\n"), "nil");
+        CHECK_EQ(find("foo\\Z", "foo\n"), "foo");
+        CHECK_EQ(find("\\bfoo\\b", "a foo b"), "foo");
+        CHECK_EQ(find("\\bfoo\\b", "afoo b"), "nil");
+        CHECK_EQ(find("\\Bb", "ab b"), "b");
+      }
+
+      SUBCASE("flags")
+      {
+        CHECK_EQ(find("(?i)HeLLo", "say hello"), "hello");
+        CHECK_EQ(find("(?i:A)b", "aB ab"), "ab");
+        CHECK_EQ(find("a.c", "a\nc abc"), "abc");
+        CHECK_EQ(find("(?s)a.c", "a\nc abc"), "a\nc");
+        CHECK_EQ(find("(?x) a b # comment\n c", "abc"), "abc");
+      }
+
+      SUBCASE("escapes")
+      {
+        CHECK_EQ(find("\\Q.*\\E", "a.*b"), ".*");
+        CHECK_EQ(find("\\x41\\u0042", "zABz"), "AB");
+        CHECK_EQ(find("\\\\", "a\\b"), "\\");
+        CHECK_EQ(find("\\s+", "a \t b"), " \t ");
+      }
+
+      SUBCASE("utf-8")
+      {
+        CHECK_EQ(find("é+", "caféé!"), "éé");
+        CHECK_EQ(find("[é-ë]", "xêy"), "ê");
+        CHECK_EQ(find(".", "é"), "é");
+      }
+
+      SUBCASE("backtracking")
+      {
+        CHECK_EQ(find("(a)\\1", "xaay"), "aa|a");
+        CHECK_EQ(find("(?<x>b)\\k<x>", "abbc"), "bb|b");
+        CHECK_EQ(find("foo(?=bar)", "foobaz foobar"), "foo");
+        CHECK_EQ(find("foo(?!bar)", "foobar foobaz"), "foo");
+        CHECK_EQ(find("(?<=\\$)\\d+", "cost $42"), "42");
+        CHECK_EQ(find("(?<!\\$)\\b\\d+", "$42 17"), "17");
+        CHECK_EQ(find("(?>a+)b", "aaab"), "aaab");
+        CHECK_EQ(find("(?>a+)a", "aaaa"), "nil");
+        CHECK_EQ(find("a++a", "aaaa"), "nil");
+      }
+
+      SUBCASE("empty loops")
+      {
+        CHECK_EQ(find("(a*)*b", "aaab"), "aaab|aaa");
+        CHECK_EQ(find("(|a)*b", "aab"), "aab|a");
+      }
+
+      SUBCASE("pathological")
+      {
+        /* These would take exponential time with a backtracker. */
+        std::string const as(64, 'a');
+        CHECK_EQ(find("(a*)*b", as), "nil");
+        CHECK_EQ(find("(a|aa)+c", as), "nil");
+
+        std::string long_input(100'000, 'a');
+        long_input += 'b';
+        regex const re{ "(x+x+)+y|a+b" };
+        auto const m{ re.search(long_input, 0) };
+        REQUIRE(m.is_some());
+        CHECK_EQ(m.unwrap().end(), long_input.size());
+      }
+    }
+
+    TEST_CASE("successive searches")
+    {
+      CHECK_EQ(find_all("a*", "baaac"), "[][aaa][][]");
+      CHECK_EQ(find_all("\\d+", "a1b22c333"), "[1][22][333]");
+      CHECK_EQ(find_all("", "ab"), "[][][]");
+      CHECK_EQ(find_all("x*", "éa"), "[][][]");
+    }
+
+    TEST_CASE("full_match")
+    {
+      CHECK_EQ(full_match("a+", "aaa"), "aaa");
+      CHECK_EQ(full_match("a+", "aaab"), "nil");
+      CHECK_EQ(full_match("a|ab", "ab"), "ab");
+      CHECK_EQ(full_match("(a|ab)(c|bcd)", "abcd"), "abcd|a|bcd");
+      CHECK_EQ(full_match("(\\d+)-(\\d+)", "12-34"), "12-34|12|34");
+      CHECK_EQ(full_match("(a)\\1", "aa"), "aa|a");
+      CHECK_EQ(full_match("", ""), "");
+    }
+
+    TEST_CASE("invalid patterns")
+    {
+      CHECK_THROWS(regex{ "(" });
+      CHECK_THROWS(regex{ ")" });
+      CHECK_THROWS(regex{ "*a" });
+      CHECK_THROWS(regex{ "a**" });
+      CHECK_THROWS(regex{ "[a" });
+      CHECK_THROWS(regex{ "[b-a]" });
+      CHECK_THROWS(regex{ "a{2,1}" });
+      CHECK_THROWS(regex{ "{1}" });
+      CHECK_THROWS(regex{ "\\1" });
+      CHECK_THROWS(regex{ "\\k<nope>" });
+      CHECK_THROWS(regex{ "(?<a>x)(?<a>y)" });
+      CHECK_THROWS(regex{ "\\y" });
+    }
+  }
+}